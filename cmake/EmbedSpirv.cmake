@@ -0,0 +1,26 @@
+# Writes the SPIR-V shaders in SHADER_DIR to OUTPUT as a C++ header with one uint32_t array per shader.
+# Run in script mode: cmake -DSHADER_DIR=<dir> -DOUTPUT=<header> -P EmbedSpirv.cmake
+
+set(SHADERS vert frag)
+
+set(CONTENT "#pragma once\n\n// Generated from the shaders compiled by compile_shaders.sh, do not edit\n\n#include <cstdint>\n\nnamespace lve::shaders {\n")
+
+foreach(SHADER ${SHADERS})
+    file(READ ${SHADER_DIR}/${SHADER}.spv HEX_CONTENT HEX)
+
+    # SPIR-V is a stream of little endian 32 bit words
+    set(BYTE "([0-9a-f][0-9a-f])")
+    string(REGEX MATCHALL "[0-9a-f][0-9a-f][0-9a-f][0-9a-f][0-9a-f][0-9a-f][0-9a-f][0-9a-f]" WORDS "${HEX_CONTENT}")
+    string(REGEX REPLACE "${BYTE}${BYTE}${BYTE}${BYTE}" "0x\\4\\3\\2\\1" WORDS "${WORDS}")
+    string(REPLACE ";" ", " WORDS "${WORDS}")
+
+    string(TOUPPER ${SHADER} SHADER_NAME)
+    string(APPEND CONTENT "\ninline constexpr uint32_t ${SHADER_NAME}_SPV[] = {${WORDS}};\n")
+endforeach()
+
+string(APPEND CONTENT "\n}  // namespace lve::shaders\n")
+
+# Only touched when the shaders changed, so dependent sources are not rebuilt needlessly
+file(WRITE ${OUTPUT}.tmp "${CONTENT}")
+execute_process(COMMAND ${CMAKE_COMMAND} -E copy_if_different ${OUTPUT}.tmp ${OUTPUT})
+file(REMOVE ${OUTPUT}.tmp)
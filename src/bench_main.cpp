@@ -0,0 +1,549 @@
+#include "constants.hpp"
+#include "target.hpp"
+#include "simulation/simulation_engine.hpp"
+#include "physics/box2d_world.hpp"
+#include "physics/box2d_maze.hpp"
+#include "physics/world_pool.hpp"
+#include "plot/plot.hpp"
+#include "micras/proxy/storage.hpp"
+#include "micras/proxy/wall_sensors.hpp"
+#include "micras/core/butterworth_filter.hpp"
+#include "micras/core/utils.hpp"
+#include "micrasverse_core/allocation_audit.hpp"
+#include "micrasverse_core/butterworth_filter_bank.hpp"
+#include "micrasverse_core/gaussian_noise.hpp"
+
+#include <algorithm>
+#include <array>
+#include <charconv>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <ctime>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <numeric>
+#include <random>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace {
+
+// Runs the measured operation the given number of times
+using BenchmarkFunction = std::function<void(uint64_t iterations)>;
+
+struct Benchmark {
+    std::string       name;
+    BenchmarkFunction function;
+};
+
+struct BenchmarkResult {
+    std::string name;
+    uint64_t    iterations;  // per repetition
+    double      meanNs;
+    double      medianNs;
+    double      stddevNs;
+    double      minNs;
+    double      maxNs;
+};
+
+struct BenchmarkSettings {
+    int    repetitions = 10;
+    double minTimeMs = 50.0;  // of every repetition, the iteration count is calibrated to reach it
+};
+
+// Keeps the compiler from discarding results that are otherwise unused
+volatile float sink;
+
+double measureNs(const BenchmarkFunction& function, uint64_t iterations) {
+    const auto startTime = std::chrono::steady_clock::now();
+    function(iterations);
+    return std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - startTime).count();
+}
+
+BenchmarkResult runBenchmark(const Benchmark& benchmark, const BenchmarkSettings& settings) {
+    const double minTimeNs = settings.minTimeMs * 1e6;
+
+    // Grows the iteration count until one repetition takes long enough, which also warms the caches up
+    uint64_t iterations = 1;
+    while (true) {
+        const double elapsed = measureNs(benchmark.function, iterations);
+        if (elapsed >= minTimeNs) {
+            break;
+        }
+
+        const double scale = elapsed > 0.0 ? std::clamp(1.4 * minTimeNs / elapsed, 2.0, 10.0) : 10.0;
+        iterations = static_cast<uint64_t>(iterations * scale);
+    }
+
+    std::vector<double> samples(settings.repetitions);
+    for (auto& sample : samples) {
+        sample = measureNs(benchmark.function, iterations) / iterations;
+    }
+
+    std::sort(samples.begin(), samples.end());
+    const size_t middle = samples.size() / 2;
+    const double mean = std::accumulate(samples.begin(), samples.end(), 0.0) / samples.size();
+    const double median = samples.size() % 2 == 0 ? (samples[middle - 1] + samples[middle]) / 2.0 : samples[middle];
+
+    double variance = 0.0;
+    for (const double sample : samples) {
+        variance += (sample - mean) * (sample - mean);
+    }
+    variance = samples.size() > 1 ? variance / (samples.size() - 1) : 0.0;
+
+    return {benchmark.name, iterations, mean, median, std::sqrt(variance), samples.front(), samples.back()};
+}
+
+void writeJson(std::ostream& output, const std::vector<BenchmarkResult>& results, const BenchmarkSettings& settings) {
+    const std::time_t now = std::time(nullptr);
+    char              date[32];
+    std::strftime(date, sizeof(date), "%Y-%m-%dT%H:%M:%S", std::localtime(&now));
+
+    output << std::setprecision(6) << std::fixed;
+    output << "{\n"
+           << "  \"context\": {\"date\": \"" << date << "\", \"repetitions\": " << settings.repetitions
+           << ", \"min_time_ms\": " << settings.minTimeMs << "},\n"
+           << "  \"benchmarks\": [";
+
+    for (size_t i = 0; i < results.size(); i++) {
+        const auto& result = results[i];
+        output << (i == 0 ? "\n" : ",\n") << "    {\"name\": \"" << result.name << "\", \"iterations\": " << result.iterations
+               << ", \"repetitions\": " << settings.repetitions << ", \"mean_ns\": " << result.meanNs << ", \"median_ns\": " << result.medianNs
+               << ", \"stddev_ns\": " << result.stddevNs << ", \"min_ns\": " << result.minNs << ", \"max_ns\": " << result.maxNs << "}";
+    }
+
+    output << "\n  ]\n}" << std::endl;
+}
+
+// Copy of the maze with one inner wall removed, like a live edit of the maze file
+bool writeEditedMaze(const std::string& sourcePath, const std::filesystem::path& destinationPath) {
+    std::ifstream source(sourcePath);
+    std::ofstream destination(destinationPath);
+    std::string   line;
+    bool          edited = false;
+
+    while (std::getline(source, line)) {
+        const size_t first = line.find('|');
+        const size_t inner = first == std::string::npos ? first : line.find('|', first + 1);
+        if (!edited && inner != std::string::npos && inner < line.find_last_of('|')) {
+            line[inner] = ' ';
+            edited = true;
+        }
+        destination << line << '\n';
+    }
+
+    return edited && destination.good();
+}
+
+// Steps run before and while counting, exploring keeps the firmware and physics busy the whole time
+constexpr int ALLOCATION_WARMUP_STEPS = 2000;
+constexpr int ALLOCATION_CHECK_STEPS = 10000;
+
+// Fails when the headless step loop still allocates after warming up, only meaningful in an allocation audit build
+int checkAllocations(micrasverse::simulation::SimulationEngine& simulationEngine, micrasverse::render::Plot& plot) {
+    namespace audit = micrasverse::allocation_audit;
+
+    if constexpr (!audit::isCompiledIn()) {
+        std::cerr << "Allocations are not counted, configure with -DMICRASVERSE_ALLOCATION_AUDIT=ON" << std::endl;
+        return 1;
+    }
+
+    // The plot buffers are ImGui vectors, which allocate with malloc
+    ImGui::SetAllocatorFunctions(
+        [](size_t size, void*) { return audit::allocate(size); }, [](void* pointer, void*) { audit::deallocate(pointer); }
+    );
+
+    auto& micrasBody = simulationEngine.physicsEngine->getMicras();
+    auto  proxyBridge = simulationEngine.getRobot().getProxyBridge();
+    proxyBridge->send_event(micras::Interface::Event::EXPLORE);
+
+    const auto step = [&]() {
+        simulationEngine.updateSimulation(micrasverse::STEP);
+        plot.sample(micrasBody, *proxyBridge);
+    };
+
+    for (int i = 0; i < ALLOCATION_WARMUP_STEPS; i++) {
+        step();
+    }
+
+    audit::reset();
+    for (int i = 0; i < ALLOCATION_CHECK_STEPS; i++) {
+        step();
+    }
+
+    uint64_t loopAllocations = 0;
+    for (const auto phase : {audit::Phase::FIRMWARE, audit::Phase::PHYSICS, audit::Phase::TELEMETRY}) {
+        const auto counts = audit::getCounts(phase);
+        loopAllocations += counts.allocations;
+        std::cerr << std::left << std::setw(10) << audit::getPhaseName(phase) << std::right << std::setw(10) << counts.allocations
+                  << " allocations " << std::setw(12) << counts.bytes << " bytes" << std::endl;
+    }
+
+    if (loopAllocations > 0) {
+        std::cerr << "The step loop allocated " << loopAllocations << " times in " << ALLOCATION_CHECK_STEPS << " steps after warming up"
+                  << std::endl;
+        return 1;
+    }
+
+    std::cerr << "No allocations in " << ALLOCATION_CHECK_STEPS << " steps after warming up" << std::endl;
+    return 0;
+}
+
+constexpr int   FILTER_CHECK_STEPS = 100000;
+constexpr float FILTER_CHECK_TOLERANCE = 1e-4f;  // relative to the full scale of the input
+
+// Fails when the filter bank drifts from one firmware filter per channel, fed the same noisy steps on every channel
+int checkFilters() {
+    constexpr size_t channels = 4;  // as many as the wall sensors
+    const float      cutoff = micras::wall_sensors_config.filter_cutoff;
+
+    micrasverse::filters::ButterworthFilterBank<channels> bank{cutoff, 1.0f / micrasverse::STEP};
+
+    auto filters = micras::core::make_array<micras::core::ButterworthFilter, channels>(cutoff);
+
+    std::mt19937                          generator{42};
+    std::uniform_real_distribution<float> noise{-0.05f, 0.05f};
+    std::array<float, channels>           inputs{};
+    float                                 maxError = 0.0f;
+
+    for (int step = 0; step < FILTER_CHECK_STEPS; step++) {
+        for (size_t channel = 0; channel < channels; channel++) {
+            // A new level every few hundred steps, different on every channel
+            const float level = static_cast<float>((step / (200 + 50 * channel)) % 2);
+            inputs[channel] = level + noise(generator);
+            filters[channel].update(inputs[channel]);
+        }
+        bank.update(inputs);
+
+        for (size_t channel = 0; channel < channels; channel++) {
+            maxError = std::max(maxError, std::abs(bank.get_last(channel) - filters[channel].get_last()));
+        }
+    }
+
+    std::cerr << "Largest difference to the firmware filter in " << FILTER_CHECK_STEPS << " steps: " << maxError << std::endl;
+    return maxError > FILTER_CHECK_TOLERANCE ? 1 : 0;
+}
+
+void printUsage() {
+    std::cerr << "Usage: micrasverse_bench [--filter TEXT] [--repetitions N] [--min-time MS] [--maze FILE] [--output FILE] [--list]\n"
+              << "                         [--check-allocations] [--check-filters]" << std::endl;
+}
+
+// The whole argument has to be a number no smaller than min, std::stoi and std::stod throw on junk and ignore trailing
+// characters
+template <typename T>
+bool parseNumber(std::string_view text, T min, T& value) {
+    const auto [end, error] = std::from_chars(text.data(), text.data() + text.size(), value);
+    return error == std::errc{} && end == text.data() + text.size() && value >= min;
+}
+
+int rejectValue(std::string_view arg, std::string_view value) {
+    std::cerr << "Invalid value for " << arg << ": " << value << std::endl;
+    printUsage();
+    return 1;
+}
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+    BenchmarkSettings settings;
+    std::string       filter;
+    std::string       mazePath{micrasverse::DEFAULT_MAZE_PATH};
+    std::string       outputPath;
+    bool              listOnly = false;
+    bool              allocationCheck = false;
+    bool              filterCheck = false;
+
+    for (int i = 1; i < argc; i++) {
+        const std::string_view arg = argv[i];
+
+        if (arg == "--filter" && i + 1 < argc) {
+            filter = argv[++i];
+        } else if (arg == "--repetitions" && i + 1 < argc) {
+            if (!parseNumber(argv[++i], 1, settings.repetitions)) {
+                return rejectValue(arg, argv[i]);
+            }
+        } else if (arg == "--min-time" && i + 1 < argc) {
+            if (!parseNumber(argv[++i], 1.0, settings.minTimeMs)) {
+                return rejectValue(arg, argv[i]);
+            }
+        } else if (arg == "--maze" && i + 1 < argc) {
+            mazePath = argv[++i];
+        } else if (arg == "--output" && i + 1 < argc) {
+            outputPath = argv[++i];
+        } else if (arg == "--list") {
+            listOnly = true;
+        } else if (arg == "--check-allocations") {
+            allocationCheck = true;
+        } else if (arg == "--check-filters") {
+            filterCheck = true;
+        } else {
+            std::cerr << "Unknown argument: " << arg << std::endl;
+            printUsage();
+            return 1;
+        }
+    }
+
+    // Only the report goes to stdout, so it parses as JSON. Status messages of the engine and the firmware go to stderr.
+    std::ostream report(std::cout.rdbuf());
+    std::cout.rdbuf(std::cerr.rdbuf());
+
+    if (filterCheck) {
+        return checkFilters();
+    }
+
+    if (!std::filesystem::exists(mazePath)) {
+        std::cerr << "Maze file not found: " << mazePath << std::endl;
+        return 1;
+    }
+
+    // Keeps the firmware's maze storage in memory, so benchmarking doesn't touch the saved maze
+    micras::maze_storage_config.storage_path.clear();
+
+    // A serial engine, so the numbers don't depend on the number of cores
+    auto simulationEngine = std::make_shared<micrasverse::simulation::SimulationEngine>(
+        1, micrasverse::physics::RobotCollisionMode::GHOST, std::shared_ptr<micrasverse::physics::TaskScheduler>{}
+    );
+    simulationEngine->loadMaze(mazePath);
+
+    micrasverse::render::Plot plot;
+    plot.setSimulationEngine(simulationEngine);
+
+    if (allocationCheck) {
+        return checkAllocations(*simulationEngine, plot);
+    }
+
+    auto& physicsEngine = *simulationEngine->physicsEngine;
+    auto& micrasBody = physicsEngine.getMicras();
+    auto  proxyBridge = simulationEngine->getRobot().getProxyBridge();
+
+    // The body hands the commands of its robot body to the motors on every update. Spinning in place in the middle of the
+    // start cell moves the robot on every step without ever reaching a wall, so the sensors never see the same pose twice.
+    constexpr float startCellCenter = (micrasverse::CELL_SIZE + micrasverse::WALL_THICKNESS) / 2.0f;
+    b2Body_SetTransform(micrasBody.getBodyId(), b2Vec2{startCellCenter, startCellCenter}, b2Rot{1.0f, 0.0f});
+    physicsEngine.getRobotBody().leftCommand = 30.0f;
+    physicsEngine.getRobotBody().rightCommand = -30.0f;
+
+    micrasverse::physics::World mazeWorld{nullptr};
+    micrasverse::physics::Maze  maze{mazeWorld.getWorldId(), mazePath};
+
+    auto wallSensorsConfig = micras::wall_sensors_config;
+    wallSensorsConfig.micrasBody = &physicsEngine.getRobotBody();
+    micras::proxy::WallSensors wallSensors{wallSensorsConfig};
+
+    // Four channels, as many as the wall sensors
+    micrasverse::filters::ButterworthFilterBank<4> filterBank{wallSensorsConfig.filter_cutoff, 1.0f / micrasverse::STEP};
+
+    auto scalarFilters = micras::core::make_array<micras::core::ButterworthFilter, 4>(wallSensorsConfig.filter_cutoff);
+
+    std::mt19937                      noiseGenerator{42};
+    std::normal_distribution<float>   normalDistribution{0.0f, 1.0f};
+    micrasverse::noise::GaussianNoise gaussianNoise{1.0f, 42};
+
+    // Roughly the size of a saved maze, one cell cost per variable
+    const std::filesystem::path storagePath = std::filesystem::temp_directory_path() / "micrasverse_bench_storage";
+    std::array<float, 256>      storageData{};
+    std::iota(storageData.begin(), storageData.end(), 0.0f);
+    micras::proxy::Storage storage{{storagePath}};
+    for (size_t i = 0; i < storageData.size(); i++) {
+        storage.create("cell_" + std::to_string(i), storageData[i]);
+    }
+    storage.save();
+
+    const std::filesystem::path editedMazePath = std::filesystem::temp_directory_path() / "micrasverse_bench_edited_maze.txt";
+    if (!writeEditedMaze(mazePath, editedMazePath)) {
+        std::cerr << "Could not write an edited copy of " << mazePath << std::endl;
+        return 1;
+    }
+
+    micrasverse::physics::WorldPool worldPool;
+
+    // Every iteration loads the edited copy and then the original again, so the other benchmarks keep their maze
+    const auto reloadMaze = [&](micrasverse::physics::MazeReloadMode mode, uint64_t iterations) {
+        physicsEngine.setMazeReloadMode(mode);
+        for (uint64_t i = 0; i < iterations; i++) {
+            physicsEngine.loadMaze(editedMazePath.string());
+            physicsEngine.loadMaze(mazePath);
+        }
+    };
+
+    const std::vector<Benchmark> benchmarks{
+        // Includes destroying the previous maze bodies, otherwise they pile up in the world
+        {"Maze::loadFromFile",
+         [&](uint64_t iterations) {
+             for (uint64_t i = 0; i < iterations; i++) {
+                 maze.destroy();
+                 maze.loadFromFile(mazePath);
+             }
+         }},
+        {"Box2DDistanceSensor::performRayCast",
+         [&](uint64_t iterations) {
+             auto& sensor = micrasBody.getDistanceSensor(0);
+             for (uint64_t i = 0; i < iterations; i++) {
+                 sensor.performRayCast();
+             }
+             sink = sensor.getReading();
+         }},
+        {"Box2DDistanceSensor::performRayCast uncached",
+         [&](uint64_t iterations) {
+             // The robot stands still, so with the cache every ray after the first is reused
+             auto&      sensor = micrasBody.getDistanceSensor(0);
+             const auto settings = sensor.getCacheSettings();
+             sensor.setCacheSettings({.enabled = false});
+             for (uint64_t i = 0; i < iterations; i++) {
+                 sensor.performRayCast();
+             }
+             sensor.setCacheSettings(settings);
+             sink = sensor.getReading();
+         }},
+        {"Box2DMotor::update",
+         [&](uint64_t iterations) {
+             auto& motor = micrasBody.getLeftMotor();
+             for (uint64_t i = 0; i < iterations; i++) {
+                 motor.update(micrasverse::STEP);
+             }
+             sink = motor.getCurrent();
+         }},
+        {"Box2DMicrasBody::update",
+         [&](uint64_t iterations) {
+             for (uint64_t i = 0; i < iterations; i++) {
+                 micrasBody.update(micrasverse::STEP);
+             }
+         }},
+        {"Box2DPhysicsEngine::update",
+         [&](uint64_t iterations) {
+             for (uint64_t i = 0; i < iterations; i++) {
+                 physicsEngine.update(micrasverse::STEP);
+             }
+         }},
+        {"TWallSensors::update",
+         [&](uint64_t iterations) {
+             for (uint64_t i = 0; i < iterations; i++) {
+                 wallSensors.sample();
+                 wallSensors.update();
+             }
+             sink = wallSensors.get_reading(0);
+         }},
+        {"core::ButterworthFilter x4",
+         [&](uint64_t iterations) {
+             for (uint64_t i = 0; i < iterations; i++) {
+                 for (size_t channel = 0; channel < scalarFilters.size(); channel++) {
+                     scalarFilters[channel].update(static_cast<float>((i + channel) & 0xFF));
+                 }
+             }
+             sink = scalarFilters[0].get_last();
+         }},
+        {"ButterworthFilterBank<4>::update",
+         [&](uint64_t iterations) {
+             std::array<float, 4> inputs{};
+             for (uint64_t i = 0; i < iterations; i++) {
+                 for (size_t channel = 0; channel < inputs.size(); channel++) {
+                     inputs[channel] = static_cast<float>((i + channel) & 0xFF);
+                 }
+                 filterBank.update(inputs);
+             }
+             sink = filterBank.get_last(0);
+         }},
+        {"std::normal_distribution",
+         [&](uint64_t iterations) {
+             float sum = 0.0f;
+             for (uint64_t i = 0; i < iterations; i++) {
+                 sum += normalDistribution(noiseGenerator);
+             }
+             sink = sum;
+         }},
+        {"GaussianNoise::next",
+         [&](uint64_t iterations) {
+             float sum = 0.0f;
+             for (uint64_t i = 0; i < iterations; i++) {
+                 sum += gaussianNoise.next();
+             }
+             sink = sum;
+         }},
+        {"Storage::save",
+         [&](uint64_t iterations) {
+             for (uint64_t i = 0; i < iterations; i++) {
+                 storage.save();
+             }
+         }},
+        // Loading drops the links to the variables, syncing them back is part of a real load
+        {"Storage::load",
+         [&](uint64_t iterations) {
+             for (uint64_t i = 0; i < iterations; i++) {
+                 storage.load();
+                 for (size_t cell = 0; cell < storageData.size(); cell++) {
+                     storage.sync("cell_" + std::to_string(cell), storageData[cell]);
+                 }
+             }
+         }},
+        {"Plot::updatePlotVariables",
+         [&](uint64_t iterations) {
+             for (uint64_t i = 0; i < iterations; i++) {
+                 plot.sample(micrasBody, *proxyBridge);
+             }
+         }},
+        // Setup of a batch run, building the maze world against taking it back from a pool
+        {"Box2DPhysicsEngine::Box2DPhysicsEngine",
+         [&](uint64_t iterations) {
+             for (uint64_t i = 0; i < iterations; i++) {
+                 micrasverse::physics::Box2DPhysicsEngine engine(mazePath, 1, micrasverse::physics::RobotCollisionMode::GHOST, nullptr);
+                 sink = engine.getRobotBody().position.x;
+             }
+         }},
+        {"WorldPool::acquire",
+         [&](uint64_t iterations) {
+             for (uint64_t i = 0; i < iterations; i++) {
+                 const auto engine = worldPool.acquire(mazePath);
+                 sink = engine->getRobotBody().position.x;
+             }
+         }},
+        {"Box2DPhysicsEngine::loadMaze full",
+         [&](uint64_t iterations) { reloadMaze(micrasverse::physics::MazeReloadMode::FULL, iterations); }},
+        {"Box2DPhysicsEngine::loadMaze incremental",
+         [&](uint64_t iterations) { reloadMaze(micrasverse::physics::MazeReloadMode::INCREMENTAL, iterations); }},
+    };
+
+    std::vector<BenchmarkResult> results;
+    for (const auto& benchmark : benchmarks) {
+        if (!filter.empty() && benchmark.name.find(filter) == std::string::npos) {
+            continue;
+        }
+
+        if (listOnly) {
+            report << benchmark.name << std::endl;
+            continue;
+        }
+
+        const auto result = runBenchmark(benchmark, settings);
+        std::cerr << std::left << std::setw(40) << result.name << std::right << std::fixed << std::setprecision(1) << std::setw(14)
+                  << result.medianNs << " ns/op  (+/- " << result.stddevNs << ", " << result.iterations << " iterations)" << std::endl;
+        results.push_back(result);
+    }
+
+    std::filesystem::remove_all(storagePath);
+    std::filesystem::remove(editedMazePath);
+
+    if (listOnly) {
+        return 0;
+    }
+
+    if (outputPath.empty()) {
+        writeJson(report, results, settings);
+        return 0;
+    }
+
+    std::ofstream output(outputPath);
+    if (!output) {
+        std::cerr << "Could not open " << outputPath << std::endl;
+        return 1;
+    }
+    writeJson(output, results, settings);
+
+    return 0;
+}
@@ -47,8 +47,15 @@ constexpr float MOTOR_KT = MOTOR_STALL_TORQUE / MOTOR_STALL_CURRENT;
 // constexpr std::string_view DEFAULT_MAZE_PATH = "external/mazefiles/training/minimaze.txt";
 // constexpr std::string_view DEFAULT_MAZE_PATH = "external/mazefiles/classic/alljapan-015-1994-frsh.txt";
 constexpr std::string_view DEFAULT_MAZE_PATH = "external/mazefiles/classic/br2024-robochallenge-day3.txt";
-constexpr float            STEP = 1.0f / 1000.0f;   // seconds — simulation step time
-constexpr b2Vec2           GRAVITY = {0.0f, 0.0f};  // m/s² — set to {0.0f} for top-down view
+constexpr float            STEP = 1.0f / 1000.0f;     // seconds — simulation step time
+constexpr b2Vec2           GRAVITY = {0.0f, 0.0f};    // m/s² — set to {0.0f} for top-down view
+constexpr int              PHYSICS_WORKER_COUNT = 4;  // threads stepping each world (0 = hardware concurrency)
+constexpr int              MAX_WORLDS = 128;          // Box2D's B2_MAX_WORLDS
+
+// Collision filtering
+constexpr uint64_t MAZE_CATEGORY = 0x0001;   // maze walls and lattice points
+constexpr uint64_t ROBOT_CATEGORY = 0x0002;  // micras bodies
+constexpr float    WALL_HIT_SPEED = 0.1f;     // m/s — approach speed above which touching a wall counts as a crash
 
 // Rendering parameters
 constexpr int      WINDOW_WIDTH = 1280;       // pixels
@@ -100,7 +107,10 @@ using Maze = TMaze<maze_width, maze_height>;
  * Configurations
  ***************/
 
-const nav::ActionQueuer::Config action_queuer_config{
+// The navigation configs are inline variables instead of constants so a single instance is shared by every
+// translation unit and can be overridden at runtime (parameter sweeps). The firmware copies them when a Micras is built.
+
+inline nav::ActionQueuer::Config action_queuer_config{
     .cell_size = cell_size,
     .start_offset = start_offset,
     .curve_safety_margin = 0.053F,
@@ -122,7 +132,7 @@ const nav::ActionQueuer::Config action_queuer_config{
         },
 };
 
-const nav::FollowWall::Config follow_wall_config{
+inline nav::FollowWall::Config follow_wall_config{
     .pid =
         {
             .kp = 0.0F,
@@ -140,7 +150,7 @@ const nav::FollowWall::Config follow_wall_config{
     .post_clearance = 0.035F,
 };
 
-const nav::Maze::Config maze_config{
+inline nav::Maze::Config maze_config{
     .start = {{0, 0}, nav::Side::UP},
     .goal = {{
         {maze_width / 2, maze_height / 2},
@@ -158,7 +168,7 @@ const nav::Odometry::Config odometry_config{
     .initial_pose = {{cell_size / 2.0f, start_offset}, std::numbers::pi_v<float> / 2.0f},
 };
 
-const nav::SpeedController::Config speed_controller_config{
+inline nav::SpeedController::Config speed_controller_config{
     .linear_pid =
         {
             .kp = 10.0F,
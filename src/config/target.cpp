@@ -7,8 +7,10 @@ namespace micras {
 // ARGB LED strip configuration
 proxy::Argb::Config argb_config = {.micrasBody = nullptr, .uncertainty = 0.0f, .brightness = {1.0f, 1.0f}};
 
-// Battery configuration
-proxy::Battery::Config battery_config = {.micrasBody = nullptr, .voltage = 12.0f, .voltage_divider = 1.0f, .filter_cutoff = 1.0f, .noise = 0.0f};
+// Battery configuration, the cutoff matches the 0.1 exponential smoothing per 1 ms step the readings used to have
+proxy::Battery::Config battery_config = {
+    .micrasBody = nullptr, .voltage = 12.0f, .voltage_divider = 1.0f, .filter_cutoff = 16.8f, .noise = 0.0f
+};
 
 // Button configuration
 proxy::Button::Config button_config = {.micrasBody = nullptr, .initial_state = false, .pull_type = proxy::Button::PullType::PULL_UP};
@@ -47,15 +49,16 @@ proxy::RotarySensor::Config rotary_sensor_right_config = {
 
 // Stopwatch configuration
 proxy::Stopwatch::Config stopwatch_config = {
+    .micrasBody = nullptr,
     .looptime = micrasverse::STEP,  // Loop time in seconds
 };
 
 // Storage configuration
 proxy::Storage::Config maze_storage_config{.storage_path = std::filesystem::path{"storage/maze"}};
 
-// Torque Sensors configuration
+// Torque Sensors configuration, the cutoff matches the 0.1 exponential smoothing per 1 ms step the readings used to have
 proxy::TorqueSensors::Config torque_sensors_config = {
-    .micrasBody = nullptr, .shunt_resistor = 0.1f, .max_torque = 1.0f, .filter_cutoff = 1.0f, .noise = 0.0f
+    .micrasBody = nullptr, .shunt_resistor = 0.1f, .max_torque = 1.0f, .filter_cutoff = 16.8f, .noise = 0.0f
 };
 
 // Wall Sensors configuration
@@ -72,7 +75,7 @@ proxy::WallSensors::Config wall_sensors_config = {
 // Locomotion configuration
 proxy::Locomotion::Config locomotion_config = {.micrasBody = nullptr};
 
-void initializeProxyConfigs(micrasverse::physics::Box2DMicrasBody* body) {
+void initializeProxyConfigs(micrasverse::physics::RobotBody* body) {
     argb_config.micrasBody = body;
     battery_config.micrasBody = body;
     button_config.micrasBody = body;
@@ -83,6 +86,7 @@ void initializeProxyConfigs(micrasverse::physics::Box2DMicrasBody* body) {
     led_config.micrasBody = body;
     rotary_sensor_left_config.micrasBody = body;
     rotary_sensor_right_config.micrasBody = body;
+    stopwatch_config.micrasBody = body;
     torque_sensors_config.micrasBody = body;
     wall_sensors_config.micrasBody = body;
     locomotion_config.micrasBody = body;
@@ -17,7 +17,7 @@
 #include "micras/proxy/wall_sensors.hpp"
 #include "box2d/box2d.h"
 #include <filesystem>
-#include "physics/box2d_micrasbody.hpp"
+#include "physics/robot_body.hpp"
 
 namespace micras {
 
@@ -79,8 +79,8 @@ extern proxy::WallSensors::Config wall_sensors_config;
 // Locomotion configuration
 extern proxy::Locomotion::Config locomotion_config;
 
-// Function to initialize all proxy configs with the correct bodyId
-void initializeProxyConfigs(micrasverse::physics::Box2DMicrasBody* body);
+// Function to point all proxy configs at the body state of one robot
+void initializeProxyConfigs(micrasverse::physics::RobotBody* body);
 
 }  // namespace micras
 
@@ -0,0 +1,78 @@
+#ifndef MICRASVERSE_CORE_ALLOCATION_AUDIT_HPP
+#define MICRASVERSE_CORE_ALLOCATION_AUDIT_HPP
+
+#include <cstddef>
+#include <cstdint>
+
+// Set to 1 by the MICRASVERSE_ALLOCATION_AUDIT CMake option, which replaces the global operator new to count heap
+// allocations per phase of the simulation loop
+#ifndef MICRASVERSE_ALLOCATION_AUDIT
+#define MICRASVERSE_ALLOCATION_AUDIT 0
+#endif
+
+namespace micrasverse::allocation_audit {
+
+enum class Phase : uint8_t {
+    OTHER,
+    FIRMWARE,
+    PHYSICS,
+    TELEMETRY,
+    UI,
+    COUNT,
+};
+
+constexpr size_t PHASE_COUNT = static_cast<size_t>(Phase::COUNT);
+
+struct PhaseCounts {
+    uint64_t allocations = 0;
+    uint64_t bytes = 0;
+};
+
+constexpr bool isCompiledIn() {
+    return MICRASVERSE_ALLOCATION_AUDIT != 0;
+}
+
+const char* getPhaseName(Phase phase);
+
+// Allocations made on every thread since the last reset while the phase was current on that thread
+PhaseCounts getCounts(Phase phase);
+
+void reset();
+
+// Counted in the current phase, for libraries that take allocation hooks like ImGui::SetAllocatorFunctions
+void* allocate(size_t size);
+void  deallocate(void* pointer);
+
+namespace detail {
+
+Phase setCurrentPhase(Phase phase);
+
+}  // namespace detail
+
+// Makes the phase current on the calling thread until destroyed, nested scopes restore the outer phase
+class PhaseScope {
+public:
+    explicit PhaseScope(Phase phase) : previous(detail::setCurrentPhase(phase)) { }
+
+    ~PhaseScope() { detail::setCurrentPhase(this->previous); }
+
+    PhaseScope(const PhaseScope&) = delete;
+    PhaseScope& operator=(const PhaseScope&) = delete;
+
+private:
+    Phase previous;
+};
+
+}  // namespace micrasverse::allocation_audit
+
+#define MICRASVERSE_ALLOCATION_CONCAT_IMPL(a, b) a##b
+#define MICRASVERSE_ALLOCATION_CONCAT(a, b) MICRASVERSE_ALLOCATION_CONCAT_IMPL(a, b)
+
+#if MICRASVERSE_ALLOCATION_AUDIT
+#define MICRASVERSE_ALLOCATION_PHASE(phase) \
+    const micrasverse::allocation_audit::PhaseScope MICRASVERSE_ALLOCATION_CONCAT(allocationPhase, __LINE__)(micrasverse::allocation_audit::Phase::phase)
+#else
+#define MICRASVERSE_ALLOCATION_PHASE(phase) ((void)0)
+#endif
+
+#endif  // MICRASVERSE_CORE_ALLOCATION_AUDIT_HPP
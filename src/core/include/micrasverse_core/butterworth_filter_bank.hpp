@@ -0,0 +1,82 @@
+#ifndef MICRASVERSE_CORE_BUTTERWORTH_FILTER_BANK_HPP
+#define MICRASVERSE_CORE_BUTTERWORTH_FILTER_BANK_HPP
+
+#include "micrasverse_core/simd.hpp"
+
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <numbers>
+#include <span>
+
+namespace micrasverse::filters {
+
+// Second order low-pass Butterworth filters sharing one cutoff, one channel per sensor of a group. Same design and
+// state as the firmware's core::ButterworthFilter, with the state of every channel stored side by side so each pack
+// of simd::WIDTH channels is filtered at once.
+template <size_t channels>
+class ButterworthFilterBank {
+public:
+    // Channels rounded up to whole packs, the extra lanes filter zeros
+    static constexpr size_t LANES = simd::paddedSize(channels);
+
+    // Frequencies in hertz, the cutoff has to stay below half the sampling frequency
+    ButterworthFilterBank(float cutoffFrequency, float samplingFrequency) {
+        const float ita = 1.0f / std::tan(std::numbers::pi_v<float> * cutoffFrequency / samplingFrequency);
+        const float q = std::numbers::sqrt2_v<float>;
+
+        this->b0 = 1.0f / (1.0f + q * ita + ita * ita);
+        this->b1 = 2.0f * this->b0;
+        this->b2 = this->b0;
+        this->a1 = 2.0f * (ita * ita - 1.0f) * this->b0;
+        this->a2 = -(1.0f - q * ita + ita * ita) * this->b0;
+    }
+
+    // Feeds one sample to every channel
+    void update(std::span<const float, channels> inputs) {
+        for (size_t i = 0; i < channels; i++) {
+            this->x0[i] = inputs[i];
+        }
+
+        for (size_t first = 0; first < LANES; first += simd::WIDTH) {
+            const simd::FloatPack x0 = simd::load(&this->x0[first]);
+            const simd::FloatPack x1 = simd::load(&this->x1[first]);
+            const simd::FloatPack x2 = simd::load(&this->x2[first]);
+            const simd::FloatPack y1 = simd::load(&this->y1[first]);
+            const simd::FloatPack y2 = simd::load(&this->y2[first]);
+
+            const simd::FloatPack y0 = this->b0 * x0 + this->b1 * x1 + this->b2 * x2 + this->a1 * y1 + this->a2 * y2;
+
+            simd::store(&this->x2[first], x1);
+            simd::store(&this->x1[first], x0);
+            simd::store(&this->y2[first], y1);
+            simd::store(&this->y1[first], y0);
+        }
+    }
+
+    float get_last(size_t channel) const { return this->y1[channel]; }
+
+    void reset() {
+        this->x1.fill(0.0f);
+        this->x2.fill(0.0f);
+        this->y1.fill(0.0f);
+        this->y2.fill(0.0f);
+    }
+
+private:
+    float b0;
+    float b1;
+    float b2;
+    float a1;
+    float a2;
+
+    std::array<float, LANES> x0{};  // input being filtered
+    std::array<float, LANES> x1{};  // input one sample ago
+    std::array<float, LANES> x2{};  // input two samples ago
+    std::array<float, LANES> y1{};  // output one sample ago, the last filtered value
+    std::array<float, LANES> y2{};  // output two samples ago
+};
+
+}  // namespace micrasverse::filters
+
+#endif  // MICRASVERSE_CORE_BUTTERWORTH_FILTER_BANK_HPP
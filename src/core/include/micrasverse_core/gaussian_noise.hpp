@@ -0,0 +1,53 @@
+#ifndef MICRASVERSE_CORE_GAUSSIAN_NOISE_HPP
+#define MICRASVERSE_CORE_GAUSSIAN_NOISE_HPP
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+namespace micrasverse::noise {
+
+// Normal variates for one sensor, generated a block at a time and handed out one by one. The generator is counter
+// based, the n-th variate only depends on the seed and n, so a block is filled in independent loops with no state
+// carried between iterations.
+class GaussianNoise {
+public:
+    // Variates per block, an even number since Box-Muller makes them in pairs
+    static constexpr size_t BLOCK_SIZE = 256;
+
+    // Seeded from std::random_device, every sensor gets its own sequence
+    explicit GaussianNoise(float stddev);
+
+    GaussianNoise(float stddev, uint64_t seed);
+
+    // Zero mean, the configured standard deviation. A zero deviation returns zeros without generating anything
+    float next() {
+        if (this->stddev == 0.0f) {
+            return 0.0f;
+        }
+
+        if (this->index == BLOCK_SIZE) {
+            this->refill();
+        }
+
+        return this->block[this->index++];
+    }
+
+    // Restarts the sequence of the seed, the same variates come out again
+    void reset();
+
+    float getStddev() const { return this->stddev; }
+
+private:
+    void refill();
+
+    float                         stddev;
+    uint64_t                      seed;
+    uint64_t                      counter = 0;  // pairs of variates generated so far
+    size_t                        index = BLOCK_SIZE;
+    std::array<float, BLOCK_SIZE> block{};
+};
+
+}  // namespace micrasverse::noise
+
+#endif  // MICRASVERSE_CORE_GAUSSIAN_NOISE_HPP
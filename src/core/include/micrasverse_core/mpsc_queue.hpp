@@ -0,0 +1,80 @@
+#ifndef MICRASVERSE_CORE_MPSC_QUEUE_HPP
+#define MICRASVERSE_CORE_MPSC_QUEUE_HPP
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+namespace micrasverse {
+
+// Bounded queue any number of threads push to and a single thread pops from, without locks. Every slot carries a
+// sequence number telling whether it is free for the lap being pushed or holds a value ready to pop, so a producer
+// only contends with other producers on the tail and the consumer never waits on them.
+template <typename T, size_t capacity>
+class MpscQueue {
+    static_assert(capacity >= 2 && (capacity & (capacity - 1)) == 0, "The capacity must be a power of two");
+
+public:
+    MpscQueue() {
+        for (size_t i = 0; i < capacity; i++) {
+            this->slots[i].sequence.store(i, std::memory_order_relaxed);
+        }
+    }
+
+    MpscQueue(const MpscQueue&) = delete;
+    MpscQueue& operator=(const MpscQueue&) = delete;
+
+    // Safe from any thread, fails when the queue is full
+    bool push(const T& value) {
+        size_t position = this->tail.load(std::memory_order_relaxed);
+
+        while (true) {
+            Slot&          slot = this->slots[position & (capacity - 1)];
+            const size_t   sequence = slot.sequence.load(std::memory_order_acquire);
+            const intptr_t difference = static_cast<intptr_t>(sequence) - static_cast<intptr_t>(position);
+
+            if (difference == 0) {
+                // The slot is free for this lap, claiming the position makes it ours
+                if (this->tail.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) {
+                    slot.value = value;
+                    slot.sequence.store(position + 1, std::memory_order_release);
+                    return true;
+                }
+            } else if (difference < 0) {
+                // The consumer hasn't popped the value of the previous lap yet
+                return false;
+            } else {
+                position = this->tail.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    // Only from the consumer thread, fails when the queue is empty or the next value is still being written
+    bool pop(T& value) {
+        Slot& slot = this->slots[this->head & (capacity - 1)];
+        if (slot.sequence.load(std::memory_order_acquire) != this->head + 1) {
+            return false;
+        }
+
+        value = slot.value;
+        slot.sequence.store(this->head + capacity, std::memory_order_release);
+        this->head++;
+        return true;
+    }
+
+private:
+    struct Slot {
+        std::atomic<size_t> sequence;
+        T                   value{};
+    };
+
+    // Producers and the consumer write to different cache lines
+    alignas(64) std::atomic<size_t>        tail{0};
+    alignas(64) size_t                     head{0};
+    alignas(64) std::array<Slot, capacity> slots;
+};
+
+}  // namespace micrasverse
+
+#endif  // MICRASVERSE_CORE_MPSC_QUEUE_HPP
@@ -0,0 +1,102 @@
+#ifndef MICRASVERSE_CORE_PROFILER_HPP
+#define MICRASVERSE_CORE_PROFILER_HPP
+
+#include <atomic>
+#include <cstdint>
+#include <filesystem>
+#include <string>
+#include <vector>
+
+// Set to 0 by the MICRASVERSE_ENABLE_PROFILER CMake option to compile every zone out
+#ifndef MICRASVERSE_PROFILER
+#define MICRASVERSE_PROFILER 1
+#endif
+
+namespace micrasverse::profiler {
+
+// A finished zone, times are nanoseconds since the profiler epoch
+struct ZoneEvent {
+    const char* name;
+    uint64_t    startTime;
+    uint64_t    endTime;
+    uint32_t    depth;
+    uint32_t    threadIndex;
+};
+
+struct ThreadInfo {
+    uint32_t    index;
+    std::string name;
+};
+
+// Zones are only recorded while enabled, checking it is a single relaxed atomic load
+inline std::atomic<bool> enabled{false};
+
+inline bool isEnabled() {
+    return enabled.load(std::memory_order_relaxed);
+}
+
+inline void setEnabled(bool value) {
+    enabled.store(value, std::memory_order_relaxed);
+}
+
+uint64_t now();
+
+// Names the calling thread in the timeline and in exported traces
+void setThreadName(std::string name);
+
+// Appends the zones of every thread that ended at or after since, the most recent ones of each thread are kept in a
+// fixed size ring buffer so older zones may be gone
+void collect(std::vector<ZoneEvent>& events, uint64_t since = 0);
+
+std::vector<ThreadInfo> getThreads();
+
+// Chrome trace event JSON, viewable in chrome://tracing or Perfetto
+bool writeChromeTrace(const std::filesystem::path& path);
+
+namespace detail {
+
+struct ZoneStart {
+    const char* name;
+    uint64_t    startTime;
+    uint32_t    depth;
+};
+
+ZoneStart beginZone(const char* name);
+void      endZone(const ZoneStart& zone);
+
+}  // namespace detail
+
+// Records the time between its construction and destruction on the calling thread
+class Zone {
+public:
+    explicit Zone(const char* name) {
+        if (isEnabled()) {
+            this->zone = detail::beginZone(name);
+        }
+    }
+
+    ~Zone() {
+        if (this->zone.name != nullptr) {
+            detail::endZone(this->zone);
+        }
+    }
+
+    Zone(const Zone&) = delete;
+    Zone& operator=(const Zone&) = delete;
+
+private:
+    detail::ZoneStart zone{nullptr, 0, 0};
+};
+
+}  // namespace micrasverse::profiler
+
+#define MICRASVERSE_PROFILE_CONCAT_IMPL(a, b) a##b
+#define MICRASVERSE_PROFILE_CONCAT(a, b) MICRASVERSE_PROFILE_CONCAT_IMPL(a, b)
+
+#if MICRASVERSE_PROFILER
+#define MICRASVERSE_PROFILE_ZONE(name) const micrasverse::profiler::Zone MICRASVERSE_PROFILE_CONCAT(profilerZone, __LINE__)(name)
+#else
+#define MICRASVERSE_PROFILE_ZONE(name) ((void)0)
+#endif
+
+#endif  // MICRASVERSE_CORE_PROFILER_HPP
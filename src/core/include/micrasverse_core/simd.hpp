@@ -0,0 +1,223 @@
+#ifndef MICRASVERSE_CORE_SIMD_HPP
+#define MICRASVERSE_CORE_SIMD_HPP
+
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <numbers>
+
+namespace micrasverse::simd {
+
+// Number of floats processed together by the batched kernels, one 128 bit register (SSE, NEON).
+// Arrays fed to load/store are padded to a multiple of it.
+constexpr size_t WIDTH = 4;
+
+#if defined(__GNUC__) || defined(__clang__)
+
+// GCC/Clang vector extensions: arithmetic operators work lane by lane and map to native vector instructions
+typedef float   FloatPack __attribute__((vector_size(WIDTH * sizeof(float))));
+typedef int32_t MaskPack __attribute__((vector_size(WIDTH * sizeof(int32_t))));
+
+inline FloatPack broadcast(float value) {
+    FloatPack pack;
+    for (size_t i = 0; i < WIDTH; i++) {
+        pack[i] = value;
+    }
+    return pack;
+}
+
+inline FloatPack select(MaskPack mask, FloatPack a, FloatPack b) {
+    return (FloatPack)((mask & (MaskPack)a) | (~mask & (MaskPack)b));
+}
+
+inline FloatPack min(FloatPack a, FloatPack b) {
+    return select(a < b, a, b);
+}
+
+inline FloatPack max(FloatPack a, FloatPack b) {
+    return select(a > b, a, b);
+}
+
+inline FloatPack floor(FloatPack x) {
+    // Conversion truncates toward zero, negative values that were not whole end up one too high
+    const FloatPack truncated = __builtin_convertvector(__builtin_convertvector(x, MaskPack), FloatPack);
+    return truncated - select(truncated > x, broadcast(1.0f), broadcast(0.0f));
+}
+
+// Mantissa in [sqrt(1/2), sqrt(2)) of positive normal floats, x = mantissa * 2^exponent
+inline FloatPack splitExponent(FloatPack x, FloatPack& exponent) {
+    const MaskPack bits = (MaskPack)x;
+    FloatPack      mantissa = (FloatPack)((bits & 0x007FFFFF) | 0x3F000000);  // in [0.5, 1)
+    const MaskPack small = mantissa < 0.70710678f;                             // -1 in the lanes that are doubled
+    mantissa = mantissa + select(small, mantissa, broadcast(0.0f));
+    exponent = __builtin_convertvector((bits >> 23) - 126 + small, FloatPack);
+    return mantissa;
+}
+
+#else
+
+// Scalar fallback with the same interface for compilers without vector extensions
+struct FloatPack {
+    float lanes[WIDTH];
+
+    float&       operator[](size_t i) { return lanes[i]; }
+    const float& operator[](size_t i) const { return lanes[i]; }
+};
+
+#define MICRASVERSE_SIMD_OPERATOR(op)                                      \
+    inline FloatPack operator op(const FloatPack& a, const FloatPack& b) { \
+        FloatPack result;                                                  \
+        for (size_t i = 0; i < WIDTH; i++) {                               \
+            result[i] = a[i] op b[i];                                      \
+        }                                                                  \
+        return result;                                                     \
+    }                                                                      \
+    inline FloatPack operator op(const FloatPack& a, float b) {            \
+        FloatPack result;                                                  \
+        for (size_t i = 0; i < WIDTH; i++) {                               \
+            result[i] = a[i] op b;                                         \
+        }                                                                  \
+        return result;                                                     \
+    }                                                                      \
+    inline FloatPack operator op(float a, const FloatPack& b) {            \
+        FloatPack result;                                                  \
+        for (size_t i = 0; i < WIDTH; i++) {                               \
+            result[i] = a op b[i];                                         \
+        }                                                                  \
+        return result;                                                     \
+    }
+
+MICRASVERSE_SIMD_OPERATOR(+)
+MICRASVERSE_SIMD_OPERATOR(-)
+MICRASVERSE_SIMD_OPERATOR(*)
+MICRASVERSE_SIMD_OPERATOR(/)
+
+#undef MICRASVERSE_SIMD_OPERATOR
+
+inline FloatPack operator-(const FloatPack& a) {
+    return 0.0f - a;
+}
+
+inline FloatPack broadcast(float value) {
+    FloatPack pack;
+    for (size_t i = 0; i < WIDTH; i++) {
+        pack[i] = value;
+    }
+    return pack;
+}
+
+inline FloatPack min(const FloatPack& a, const FloatPack& b) {
+    FloatPack result;
+    for (size_t i = 0; i < WIDTH; i++) {
+        result[i] = (a[i] < b[i]) ? a[i] : b[i];
+    }
+    return result;
+}
+
+inline FloatPack max(const FloatPack& a, const FloatPack& b) {
+    FloatPack result;
+    for (size_t i = 0; i < WIDTH; i++) {
+        result[i] = (a[i] > b[i]) ? a[i] : b[i];
+    }
+    return result;
+}
+
+inline FloatPack floor(const FloatPack& x) {
+    FloatPack result;
+    for (size_t i = 0; i < WIDTH; i++) {
+        result[i] = std::floor(x[i]);
+    }
+    return result;
+}
+
+inline FloatPack splitExponent(const FloatPack& x, FloatPack& exponent) {
+    FloatPack mantissa;
+    for (size_t i = 0; i < WIDTH; i++) {
+        int power = 0;
+        mantissa[i] = std::frexp(x[i], &power);
+        if (mantissa[i] < 0.70710678f) {
+            mantissa[i] += mantissa[i];
+            power--;
+        }
+        exponent[i] = static_cast<float>(power);
+    }
+    return mantissa;
+}
+
+#endif
+
+// Square root lane by lane, each lane is a single square root instruction and no library call
+inline FloatPack sqrt(const FloatPack& x) {
+    FloatPack result;
+    for (size_t i = 0; i < WIDTH; i++) {
+        result[i] = std::sqrt(x[i]);
+    }
+    return result;
+}
+
+// Natural logarithm of positive normal floats as ln(m) = 2 atanh(s), s = (m - 1) / (m + 1). With the mantissa in
+// [sqrt(1/2), sqrt(2)) |s| stays under 0.172 and the series is cut at s^9, 1e-9 from the exact value.
+inline FloatPack log(const FloatPack& x) {
+    FloatPack       exponent;
+    const FloatPack mantissa = splitExponent(x, exponent);
+
+    const FloatPack s = (mantissa - 1.0f) / (mantissa + 1.0f);
+    const FloatPack s2 = s * s;
+    const FloatPack series = 1.0f + s2 * (1.0f / 3.0f + s2 * (1.0f / 5.0f + s2 * (1.0f / 7.0f + s2 * (1.0f / 9.0f))));
+    return exponent * std::numbers::ln2_v<float> + 2.0f * s * series;
+}
+
+// Sine and cosine of the same angles, reduced to [-pi/4, pi/4] around the closest multiple of pi/2 and evaluated with
+// Taylor series good to 1e-9 there. The reduction stays within a few ulps for angles up to a few thousand radians.
+inline void sincos(const FloatPack& x, FloatPack& sine, FloatPack& cosine) {
+    // pi/2 split in three so the first products with the quadrant are exact
+    constexpr float PI_2_HIGH = 1.5703125f;
+    constexpr float PI_2_MID = 4.837512969970703125e-4f;
+    constexpr float PI_2_LOW = 7.54978995489188216e-8f;
+
+    const FloatPack quadrant = floor(x * (2.0f / std::numbers::pi_v<float>) + 0.5f);
+    const FloatPack r = ((x - quadrant * PI_2_HIGH) - quadrant * PI_2_MID) - quadrant * PI_2_LOW;
+    const FloatPack r2 = r * r;
+
+    const FloatPack s = r * (1.0f + r2 * (-1.0f / 6.0f + r2 * (1.0f / 120.0f + r2 * (-1.0f / 5040.0f + r2 * (1.0f / 362880.0f)))));
+    const FloatPack c =
+        1.0f + r2 * (-0.5f + r2 * (1.0f / 24.0f + r2 * (-1.0f / 720.0f + r2 * (1.0f / 40320.0f + r2 * (-1.0f / 3628800.0f)))));
+
+    // Quadrants 0 to 3 turn (s, c) into (s, c), (c, -s), (-s, -c) and (-c, s), odd and sign are exact 0/1 and +-1
+    const FloatPack half = floor(quadrant * 0.5f);
+    const FloatPack odd = quadrant - 2.0f * half;
+    const FloatPack even = 1.0f - odd;
+    const FloatPack sign = 1.0f - 2.0f * (half - 2.0f * floor(half * 0.5f));
+    sine = sign * (s * even + c * odd);
+    cosine = sign * (c * even - s * odd);
+}
+
+// Unaligned load/store of WIDTH consecutive floats
+inline FloatPack load(const float* data) {
+    FloatPack pack;
+    std::memcpy(&pack, data, sizeof(FloatPack));
+    return pack;
+}
+
+inline void store(float* data, const FloatPack& pack) {
+    std::memcpy(data, &pack, sizeof(FloatPack));
+}
+
+// Scalar overloads so the same templated kernels compile for float and FloatPack
+inline float min(float a, float b) {
+    return (a < b) ? a : b;
+}
+
+inline float max(float a, float b) {
+    return (a > b) ? a : b;
+}
+
+// Rounds count up to a whole number of packs
+constexpr size_t paddedSize(size_t count) {
+    return (count + WIDTH - 1) / WIDTH * WIDTH;
+}
+
+}  // namespace micrasverse::simd
+
+#endif  // MICRASVERSE_CORE_SIMD_HPP
@@ -12,9 +12,9 @@ public:
     float x, y;
 
     // Constructors
-    Vec2() : x(0.0f), y(0.0f) { }
+    constexpr Vec2() : x(0.0f), y(0.0f) { }
 
-    Vec2(float x, float y) : x(x), y(y) { }
+    constexpr Vec2(float x, float y) : x(x), y(y) { }
 
     // Basic vector operations
     Vec2 operator+(const Vec2& other) const { return Vec2(x + other.x, y + other.y); }
@@ -0,0 +1,111 @@
+#include "micrasverse_core/allocation_audit.hpp"
+
+#include <array>
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+namespace micrasverse::allocation_audit {
+
+namespace {
+
+// Constant initialized, so they are usable by allocations made before main and while threads exit
+std::array<std::atomic<uint64_t>, PHASE_COUNT> allocationCounts{};
+std::array<std::atomic<uint64_t>, PHASE_COUNT> byteCounts{};
+thread_local Phase                              currentPhase = Phase::OTHER;
+
+[[maybe_unused]] void count(size_t size) {
+    const auto phase = static_cast<size_t>(currentPhase);
+    allocationCounts[phase].fetch_add(1, std::memory_order_relaxed);
+    byteCounts[phase].fetch_add(size, std::memory_order_relaxed);
+}
+
+}  // namespace
+
+const char* getPhaseName(Phase phase) {
+    switch (phase) {
+        case Phase::FIRMWARE:
+            return "Firmware";
+        case Phase::PHYSICS:
+            return "Physics";
+        case Phase::TELEMETRY:
+            return "Telemetry";
+        case Phase::UI:
+            return "UI";
+        default:
+            return "Other";
+    }
+}
+
+PhaseCounts getCounts(Phase phase) {
+    const auto index = static_cast<size_t>(phase);
+    return {allocationCounts[index].load(std::memory_order_relaxed), byteCounts[index].load(std::memory_order_relaxed)};
+}
+
+void reset() {
+    for (size_t i = 0; i < allocationCounts.size(); i++) {
+        allocationCounts[i].store(0, std::memory_order_relaxed);
+        byteCounts[i].store(0, std::memory_order_relaxed);
+    }
+}
+
+void* allocate(size_t size) {
+#if MICRASVERSE_ALLOCATION_AUDIT
+    count(size);
+#endif
+    return std::malloc(size);
+}
+
+void deallocate(void* pointer) {
+    std::free(pointer);
+}
+
+Phase detail::setCurrentPhase(Phase phase) {
+    const Phase previous = currentPhase;
+    currentPhase = phase;
+    return previous;
+}
+
+}  // namespace micrasverse::allocation_audit
+
+#if MICRASVERSE_ALLOCATION_AUDIT
+
+// The default nothrow, array and sized forms all forward to these. Over-aligned allocations have their own path and
+// are not counted.
+void* operator new(std::size_t size) {
+    micrasverse::allocation_audit::count(size);
+
+    while (true) {
+        if (void* pointer = std::malloc(size == 0 ? 1 : size)) {
+            return pointer;
+        }
+
+        const std::new_handler handler = std::get_new_handler();
+        if (handler == nullptr) {
+            throw std::bad_alloc();
+        }
+        handler();
+    }
+}
+
+void* operator new[](std::size_t size) {
+    return ::operator new(size);
+}
+
+void operator delete(void* pointer) noexcept {
+    std::free(pointer);
+}
+
+void operator delete[](void* pointer) noexcept {
+    std::free(pointer);
+}
+
+void operator delete(void* pointer, std::size_t /*size*/) noexcept {
+    std::free(pointer);
+}
+
+void operator delete[](void* pointer, std::size_t /*size*/) noexcept {
+    std::free(pointer);
+}
+
+#endif
@@ -0,0 +1,70 @@
+#include "micrasverse_core/gaussian_noise.hpp"
+#include "micrasverse_core/simd.hpp"
+
+#include <numbers>
+#include <random>
+
+namespace micrasverse::noise {
+
+namespace {
+
+constexpr size_t PAIRS = GaussianNoise::BLOCK_SIZE / 2;
+
+static_assert(PAIRS % simd::WIDTH == 0, "Box-Muller runs a whole pack of pairs at a time");
+
+// 24 bit integers fit a float exactly
+constexpr float UNIT = 1.0f / 16777216.0f;
+
+// SplitMix64 of the counter, stateless so every pair of the block is independent of the others
+uint64_t hash(uint64_t seed, uint64_t counter) {
+    uint64_t z = seed + (counter + 1) * 0x9E3779B97F4A7C15ULL;
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    return z ^ (z >> 31);
+}
+
+uint64_t randomSeed() {
+    std::random_device device;
+    return (static_cast<uint64_t>(device()) << 32) | device();
+}
+
+}  // namespace
+
+GaussianNoise::GaussianNoise(float stddev) : GaussianNoise(stddev, randomSeed()) { }
+
+GaussianNoise::GaussianNoise(float stddev, uint64_t seed) : stddev(stddev), seed(seed) { }
+
+void GaussianNoise::reset() {
+    this->counter = 0;
+    this->index = BLOCK_SIZE;
+}
+
+void GaussianNoise::refill() {
+    std::array<float, PAIRS> radius;
+    std::array<float, PAIRS> angle;
+
+    // Two uniforms per hash, the radius one in (0, 1] so its logarithm is finite
+    for (size_t i = 0; i < PAIRS; i++) {
+        const uint64_t bits = hash(this->seed, this->counter + i);
+        radius[i] = static_cast<float>((bits >> 40) + 1) * UNIT;
+        angle[i] = static_cast<float>((bits >> 8) & 0xFFFFFF) * UNIT;
+    }
+    this->counter += PAIRS;
+
+    // Box-Muller, each pair of uniforms gives two independent variates. The cosine ones fill the first half of the block
+    // and the sine ones the second, so both halves are stored a whole pack at a time.
+    for (size_t i = 0; i < PAIRS; i += simd::WIDTH) {
+        const simd::FloatPack r = this->stddev * simd::sqrt(-2.0f * simd::log(simd::load(&radius[i])));
+
+        simd::FloatPack sine;
+        simd::FloatPack cosine;
+        simd::sincos(2.0f * std::numbers::pi_v<float> * simd::load(&angle[i]), sine, cosine);
+
+        simd::store(&this->block[i], r * cosine);
+        simd::store(&this->block[PAIRS + i], r * sine);
+    }
+
+    this->index = 0;
+}
+
+}  // namespace micrasverse::noise
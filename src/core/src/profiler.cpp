@@ -0,0 +1,205 @@
+#include "micrasverse_core/profiler.hpp"
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <fstream>
+#include <memory>
+#include <mutex>
+
+namespace micrasverse::profiler {
+
+namespace {
+
+// Zones kept per thread, about a second of the simulation loop at full instrumentation
+constexpr size_t BUFFER_SIZE = 1 << 16;
+
+// One zone of a ring buffer. Readers copy slots the writer may be reusing, so the fields are relaxed atomics and the
+// sequence brackets them like a seqlock: odd while entry n is written, 2n + 2 once it is complete.
+struct Slot {
+    std::atomic<uint64_t>    sequence{0};
+    std::atomic<const char*> name{nullptr};
+    std::atomic<uint64_t>    startTime{0};
+    std::atomic<uint64_t>    endTime{0};
+    std::atomic<uint32_t>    depth{0};
+};
+
+// Written only by its own thread, the write index is published with release so readers never lock the writer out
+struct ThreadBuffer {
+    std::array<Slot, BUFFER_SIZE> events;
+    std::atomic<uint64_t>         writeIndex{0};
+    uint32_t                      index = 0;
+    uint32_t                      depth = 0;
+    std::string                   name;
+};
+
+struct Registry {
+    std::mutex                                 mutex;
+    std::vector<std::shared_ptr<ThreadBuffer>> buffers;  // kept after their thread exits, for exports
+};
+
+Registry& getRegistry() {
+    static Registry registry;
+    return registry;
+}
+
+const std::chrono::steady_clock::time_point epoch = std::chrono::steady_clock::now();
+
+ThreadBuffer& getThreadBuffer() {
+    thread_local std::shared_ptr<ThreadBuffer> buffer = [] {
+        auto      newBuffer = std::make_shared<ThreadBuffer>();
+        Registry& registry = getRegistry();
+
+        std::lock_guard<std::mutex> lock(registry.mutex);
+        newBuffer->index = static_cast<uint32_t>(registry.buffers.size());
+        newBuffer->name = "Thread " + std::to_string(newBuffer->index);
+        registry.buffers.push_back(newBuffer);
+        return newBuffer;
+    }();
+
+    return *buffer;
+}
+
+// False when the writer reused the slot for a later entry before or while it was copied
+bool readSlot(const ThreadBuffer& buffer, uint64_t entry, ZoneEvent& event) {
+    const Slot&    slot = buffer.events[entry % BUFFER_SIZE];
+    const uint64_t sequence = 2 * entry + 2;
+
+    if (slot.sequence.load(std::memory_order_acquire) != sequence) {
+        return false;
+    }
+
+    event = {
+        slot.name.load(std::memory_order_relaxed), slot.startTime.load(std::memory_order_relaxed), slot.endTime.load(std::memory_order_relaxed),
+        slot.depth.load(std::memory_order_relaxed), buffer.index
+    };
+
+    std::atomic_thread_fence(std::memory_order_acquire);
+    return slot.sequence.load(std::memory_order_relaxed) == sequence;
+}
+
+void collectThread(const ThreadBuffer& buffer, std::vector<ZoneEvent>& events, uint64_t since) {
+    const uint64_t end = buffer.writeIndex.load(std::memory_order_acquire);
+    uint64_t       first = (end > BUFFER_SIZE) ? end - BUFFER_SIZE : 0;
+
+    // Zones are appended when they end, so the end times of a thread only grow along the buffer
+    while (first < end && buffer.events[first % BUFFER_SIZE].endTime.load(std::memory_order_relaxed) < since) {
+        first++;
+    }
+
+    ZoneEvent event;
+    for (uint64_t i = first; i < end; i++) {
+        if (readSlot(buffer, i, event) && event.endTime >= since) {
+            events.push_back(event);
+        }
+    }
+}
+
+void writeJsonString(std::ostream& output, const char* text) {
+    output << '"';
+    for (; *text != '\0'; text++) {
+        if (*text == '"' || *text == '\\') {
+            output << '\\';
+        }
+        output << *text;
+    }
+    output << '"';
+}
+
+}  // namespace
+
+uint64_t now() {
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - epoch).count());
+}
+
+void setThreadName(std::string name) {
+    ThreadBuffer& buffer = getThreadBuffer();
+
+    std::lock_guard<std::mutex> lock(getRegistry().mutex);
+    buffer.name = std::move(name);
+}
+
+void collect(std::vector<ZoneEvent>& events, uint64_t since) {
+    Registry& registry = getRegistry();
+
+    std::lock_guard<std::mutex> lock(registry.mutex);
+    for (const auto& buffer : registry.buffers) {
+        collectThread(*buffer, events, since);
+    }
+}
+
+std::vector<ThreadInfo> getThreads() {
+    Registry& registry = getRegistry();
+
+    std::lock_guard<std::mutex> lock(registry.mutex);
+    std::vector<ThreadInfo>     threads;
+    threads.reserve(registry.buffers.size());
+    for (const auto& buffer : registry.buffers) {
+        threads.push_back({buffer->index, buffer->name});
+    }
+    return threads;
+}
+
+bool writeChromeTrace(const std::filesystem::path& path) {
+    std::vector<ZoneEvent> events;
+    collect(events);
+
+    std::ofstream output(path);
+    if (!output) {
+        return false;
+    }
+
+    output << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n";
+
+    bool first = true;
+    for (const auto& thread : getThreads()) {
+        output << (first ? "" : ",\n") << "{\"ph\":\"M\",\"name\":\"thread_name\",\"pid\":0,\"tid\":" << thread.index << ",\"args\":{\"name\":";
+        writeJsonString(output, thread.name.c_str());
+        output << "}}";
+        first = false;
+    }
+
+    // Complete events, timestamps in microseconds
+    output.setf(std::ios::fixed);
+    output.precision(3);
+    for (const auto& event : events) {
+        output << (first ? "" : ",\n") << "{\"ph\":\"X\",\"name\":";
+        writeJsonString(output, event.name);
+        output << ",\"pid\":0,\"tid\":" << event.threadIndex << ",\"ts\":" << event.startTime / 1000.0
+               << ",\"dur\":" << (event.endTime - event.startTime) / 1000.0 << "}";
+        first = false;
+    }
+
+    output << "\n]}\n";
+    return static_cast<bool>(output);
+}
+
+namespace detail {
+
+ZoneStart beginZone(const char* name) {
+    ThreadBuffer& buffer = getThreadBuffer();
+    return {name, now(), buffer.depth++};
+}
+
+void endZone(const ZoneStart& zone) {
+    const uint64_t endTime = now();
+    ThreadBuffer&  buffer = getThreadBuffer();
+    buffer.depth--;
+
+    const uint64_t index = buffer.writeIndex.load(std::memory_order_relaxed);
+    Slot&          slot = buffer.events[index % BUFFER_SIZE];
+
+    slot.sequence.store(2 * index + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    slot.name.store(zone.name, std::memory_order_relaxed);
+    slot.startTime.store(zone.startTime, std::memory_order_relaxed);
+    slot.endTime.store(endTime, std::memory_order_relaxed);
+    slot.depth.store(zone.depth, std::memory_order_relaxed);
+    slot.sequence.store(2 * index + 2, std::memory_order_release);
+
+    buffer.writeIndex.store(index + 1, std::memory_order_release);
+}
+
+}  // namespace detail
+
+}  // namespace micrasverse::profiler
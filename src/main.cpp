@@ -1,10 +1,12 @@
 #include "constants.hpp"
 #include "simulation/simulation_engine.hpp"
+#include "physics/task_scheduler.hpp"
 #include "micras/micras.hpp"
 #include "micras/proxy/proxy_bridge.hpp"
 #include "target.hpp"
 #include "box2d/box2d.h"
 #include "io/keyboard.hpp"
+#include "micrasverse_core/profiler.hpp"
 
 #define GLFW_INCLUDE_VULKAN
 #include <GLFW/glfw3.h>
@@ -12,6 +14,8 @@
 #include "vulkan_engine/vulkan_engine.hpp"
 #include "vulkan_engine/simple_render_system.hpp"
 #include "vulkan_engine/lve_imgui.hpp"
+#include "vulkan_engine/lve_frame_writer.hpp"
+#include "vulkan_engine/lve_frame_pacer.hpp"
 
 #include <imgui.h>
 #include <imgui_impl_glfw.h>
@@ -19,18 +23,170 @@
 
 #include <iostream>
 #include <memory>
+#include <optional>
+#include <algorithm>
+#include <charconv>
 #include <chrono>
+#include <cmath>
+#include <string>
+#include <string_view>
 #include <vector>
 
-int main() {
-    auto simulationEngine = std::make_shared<micrasverse::simulation::SimulationEngine>();
+namespace {
 
+void printUsage() {
+    std::cerr << "Usage: micrasverse [--physics-workers N] [--robots N] [--robot-collisions]\n"
+              << "                   [--offscreen] [--capture PATH] [--capture-format ppm|raw] [--frames N]\n"
+              << "                   [--present-mode fifo|mailbox|immediate] [--fps-cap FPS] [--frame-pacing skip|sleep]\n"
+              << "                   [--benchmark FRAMES] [--profile] [--trace PATH]" << std::endl;
+}
+
+// The whole argument has to be a number no smaller than min, std::stoi throws on junk and ignores trailing characters
+template <typename T>
+bool parseNumber(std::string_view text, T min, T& value) {
+    const auto [end, error] = std::from_chars(text.data(), text.data() + text.size(), value);
+    return error == std::errc{} && end == text.data() + text.size() && value >= min;
+}
+
+int rejectValue(std::string_view arg, std::string_view value) {
+    std::cerr << "Invalid value for " << arg << ": " << value << std::endl;
+    printUsage();
+    return 1;
+}
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+    size_t                                   robotCount = 1;
+    micrasverse::physics::RobotCollisionMode collisionMode = micrasverse::physics::RobotCollisionMode::GHOST;
+    bool                                     offscreen = false;
+    std::string                              capturePath;
+    lve::LveFrameWriter::Format              captureFormat = lve::LveFrameWriter::Format::IMAGE_SEQUENCE;
+    int                                      frameCount = 600;
+    std::optional<VkPresentModeKHR>          presentMode;
+    lve::LveFramePacer                       framePacer;
+    int                                      benchmarkFrames = 0;
+    std::string                              tracePath;
+
+    micrasverse::profiler::setThreadName("Main");
+
+    for (int i = 1; i < argc; i++) {
+        const std::string_view arg = argv[i];
+
+        if (arg == "--physics-workers" && i + 1 < argc) {
+            int workerCount = 0;  // 0 uses every hardware thread
+            if (!parseNumber(argv[++i], 0, workerCount)) {
+                return rejectValue(arg, argv[i]);
+            }
+            micrasverse::physics::TaskScheduler::setSharedWorkerCount(workerCount);
+        } else if (arg == "--robots" && i + 1 < argc) {
+            if (!parseNumber(argv[++i], size_t{1}, robotCount)) {
+                return rejectValue(arg, argv[i]);
+            }
+        } else if (arg == "--robot-collisions") {
+            collisionMode = micrasverse::physics::RobotCollisionMode::INTERACTION;
+        } else if (arg == "--offscreen") {
+            offscreen = true;
+        } else if (arg == "--capture" && i + 1 < argc) {
+            offscreen = true;
+            capturePath = argv[++i];
+        } else if (arg == "--capture-format" && i + 1 < argc) {
+            const std::string_view format = argv[++i];
+            if (format == "ppm") {
+                captureFormat = lve::LveFrameWriter::Format::IMAGE_SEQUENCE;
+            } else if (format == "raw") {
+                captureFormat = lve::LveFrameWriter::Format::RAW_VIDEO;
+            } else {
+                std::cerr << "Unknown capture format: " << format << std::endl;
+                return 1;
+            }
+        } else if (arg == "--frames" && i + 1 < argc) {
+            if (!parseNumber(argv[++i], 1, frameCount)) {
+                return rejectValue(arg, argv[i]);
+            }
+        } else if (arg == "--present-mode" && i + 1 < argc) {
+            const std::string_view mode = argv[++i];
+            if (mode == "fifo") {
+                presentMode = VK_PRESENT_MODE_FIFO_KHR;
+            } else if (mode == "mailbox") {
+                presentMode = VK_PRESENT_MODE_MAILBOX_KHR;
+            } else if (mode == "immediate") {
+                presentMode = VK_PRESENT_MODE_IMMEDIATE_KHR;
+            } else {
+                std::cerr << "Unknown present mode: " << mode << std::endl;
+                return 1;
+            }
+        } else if (arg == "--fps-cap" && i + 1 < argc) {
+            float fps = 0.0f;  // 0 leaves the frame rate uncapped
+            if (!parseNumber(argv[++i], 0.0f, fps)) {
+                return rejectValue(arg, argv[i]);
+            }
+            framePacer.setTargetFps(fps);
+        } else if (arg == "--frame-pacing" && i + 1 < argc) {
+            const std::string_view pacing = argv[++i];
+            if (pacing == "skip") {
+                framePacer.setPacing(lve::LveFramePacer::Pacing::SKIP);
+            } else if (pacing == "sleep") {
+                framePacer.setPacing(lve::LveFramePacer::Pacing::SLEEP);
+            } else {
+                std::cerr << "Unknown frame pacing: " << pacing << std::endl;
+                return 1;
+            }
+        } else if (arg == "--benchmark" && i + 1 < argc) {
+            if (!parseNumber(argv[++i], 1, benchmarkFrames)) {
+                return rejectValue(arg, argv[i]);
+            }
+        } else if (arg == "--profile") {
+            micrasverse::profiler::setEnabled(true);
+        } else if (arg == "--trace" && i + 1 < argc) {
+            micrasverse::profiler::setEnabled(true);
+            tracePath = argv[++i];
+        } else {
+            std::cerr << "Unknown argument: " << arg << std::endl;
+            printUsage();
+            return 1;
+        }
+    }
+
+    // Raw video piped to stdout has to be the only thing written there, the status messages of the renderer, the physics
+    // and the firmware go to stderr instead
+    if (capturePath == "-") {
+        std::cout.rdbuf(std::cerr.rdbuf());
+    }
+
+    // Benchmarks measure the render cost alone, without vsync or a frame cap
+    if (benchmarkFrames > 0) {
+        presentMode = VK_PRESENT_MODE_IMMEDIATE_KHR;
+        framePacer.setTargetFps(0.0f);
+        framePacer.setHistorySize(static_cast<size_t>(benchmarkFrames));
+    }
+
+    // Dumps the zones still in the ring buffers, open the file in chrome://tracing or Perfetto
+    const auto writeTrace = [&tracePath]() {
+        if (!tracePath.empty() && !micrasverse::profiler::writeChromeTrace(tracePath)) {
+            std::cerr << "Could not write trace to " << tracePath << std::endl;
+        }
+    };
+
+    if (robotCount > 1 && collisionMode == micrasverse::physics::RobotCollisionMode::INTERACTION) {
+        std::cerr << "WARNING: Every robot starts at the same pose, colliding robots are pushed apart on the first step" << std::endl;
+    }
+
+    auto simulationEngine = std::make_shared<micrasverse::simulation::SimulationEngine>(robotCount, collisionMode);
+
+    // The GUI inspects and controls the first robot
     auto& micrasBody = simulationEngine->physicsEngine->getMicras();
-    micras::initializeProxyConfigs(&micrasBody);
-    micras::Micras micrasController;
-    auto           proxyBridge = std::make_shared<micras::ProxyBridge>(micrasController, micrasBody);
+    auto  proxyBridge = simulationEngine->getRobot().getProxyBridge();
 
-    auto vulkanEngine = std::make_shared<lve::VulkanEngine>(simulationEngine);
+    // Covers instance, device and pipeline creation, the pipeline cache makes warm starts much faster
+    const auto rendererStartTime = std::chrono::steady_clock::now();
+    const auto printStartupTime = [rendererStartTime](lve::LveDevice& device) {
+        const float elapsed = std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - rendererStartTime).count();
+        std::cout << "Renderer startup: " << elapsed << " ms (pipeline cache " << (device.isPipelineCacheWarm() ? "warm" : "cold") << ")"
+                  << std::endl;
+    };
+
+    auto vulkanEngine = std::make_shared<lve::VulkanEngine>(simulationEngine, offscreen);
     vulkanEngine->setProxyBridge(proxyBridge);
 
     struct GlobalUbo {
@@ -55,13 +211,7 @@ int main() {
         lve::LveDescriptorWriter(*globalSetLayout, *vulkanEngine->globalPool).writeBuffer(0, &bufferInfo).build(globalDescriptorSets[i]);
     }
 
-    lve::LveImgui lveImgui{
-        vulkanEngine->lveWindow, vulkanEngine->lveDevice, vulkanEngine->lveRenderer.getSwapChainRenderPass(),
-        vulkanEngine->lveRenderer.getImageCount()
-    };
-
-    lveImgui.setSimulationEngine(simulationEngine);
-    lveImgui.setProxyBridge(proxyBridge);
+    auto& gpuProfiler = vulkanEngine->lveRenderer.getGpuProfiler();
 
     lve::SimpleRenderSystem simpleRenderSystem{
         vulkanEngine->lveDevice, vulkanEngine->lveRenderer.getSwapChainRenderPass(), globalSetLayout->getDescriptorSetLayout()
@@ -73,9 +223,95 @@ int main() {
     auto currentTime = std::chrono::high_resolution_clock::now();
     viewerObject.transform.translation = {-0.25f, -micrasverse::MAZE_FLOOR_HALFHEIGHT, -4.0f};
 
+    // Offscreen the robot explores on its own and every frame is rendered at a fixed simulated frame rate, without the GUI
+    if (offscreen) {
+        printStartupTime(vulkanEngine->lveDevice);
+
+        constexpr float CAPTURE_FPS = 60.0f;
+        const int       stepsPerFrame = std::max(1, static_cast<int>(std::lround(1.0f / (CAPTURE_FPS * micrasverse::STEP))));
+        const float     frameTime = stepsPerFrame * micrasverse::STEP;
+
+        std::unique_ptr<lve::LveFrameWriter> frameWriter;
+        if (!capturePath.empty()) {
+            frameWriter = std::make_unique<lve::LveFrameWriter>(capturePath, captureFormat);
+            vulkanEngine->lveRenderer.getOffscreenTarget()->setFrameCallback([&frameWriter](const lve::CapturedFrame& frame) {
+                frameWriter->write(frame);
+            });
+        }
+
+        camera.setViewYXZ(viewerObject.transform.translation, viewerObject.transform.rotation);
+        camera.setPerspectiveProjection(glm::radians(50.f), vulkanEngine->lveRenderer.getAspectRatio(), 0.1f, 1000.f);
+
+        simulationEngine->sendCommand({.robot = 0, .action = micrasverse::simulation::commands::SendEvent{micras::Interface::Event::EXPLORE}});
+
+        for (int frame = 0; frame < frameCount; frame++) {
+            for (int step = 0; step < stepsPerFrame; step++) {
+                simulationEngine->updateSimulation();
+                simulationEngine->stepCounter++;
+            }
+
+            vulkanEngine->updateRenderableModels();
+            auto commandBuffer = vulkanEngine->lveRenderer.beginFrame();
+            int  frameIndex = vulkanEngine->lveRenderer.getFrameIndex();
+
+            lve::FrameInfo frameInfo{frameIndex, frameTime, commandBuffer, camera, globalDescriptorSets[frameIndex]};
+
+            GlobalUbo ubo{};
+            ubo.projectionView = camera.getProjection() * camera.getView();
+            uboBuffers[frameIndex]->writeToBuffer(&ubo);
+            uboBuffers[frameIndex]->flush();
+
+            vulkanEngine->lveRenderer.beginSwapChainRenderPass(commandBuffer);
+            const uint32_t sceneScope = gpuProfiler.beginScope(commandBuffer, "Scene");
+            simpleRenderSystem.renderGameObjects(frameInfo, vulkanEngine->gameObjects);
+            gpuProfiler.endScope(commandBuffer, sceneScope);
+            vulkanEngine->lveRenderer.endSwapChainRenderPass(commandBuffer);
+            vulkanEngine->lveRenderer.endFrame();
+        }
+
+        // Hands the last frames in flight to the writer before it drains its queue
+        vulkanEngine->lveRenderer.getOffscreenTarget()->flush();
+        vkDeviceWaitIdle(vulkanEngine->lveDevice.device());
+        writeTrace();
+        return 0;
+    }
+
+    lve::LveImgui lveImgui{
+        vulkanEngine->lveWindow, vulkanEngine->lveDevice, vulkanEngine->lveRenderer.getSwapChainRenderPass(),
+        vulkanEngine->lveRenderer.getImageCount()
+    };
+
+    lveImgui.setSimulationEngine(simulationEngine);
+    lveImgui.setProxyBridge(proxyBridge);
+    lveImgui.setFrameControls(&vulkanEngine->lveRenderer, &framePacer);
+
+    if (presentMode) {
+        vulkanEngine->lveRenderer.setPresentMode(*presentMode);
+    }
+
+    printStartupTime(vulkanEngine->lveDevice);
+
+    // While paused, frames are only redrawn for a few iterations after input or a state change, otherwise the loop
+    // sleeps on the event queue instead of spinning
+    constexpr int    IDLE_REDRAW_FRAMES = 3;    // ImGui needs a couple of frames to settle hover and click states
+    constexpr double IDLE_WAIT_TIMEOUT = 0.25;  // seconds
+    int              idleRedrawFrames = IDLE_REDRAW_FRAMES;
+    int              lastStepCounter = simulationEngine->stepCounter;
+
     // Main loop
     while (!glfwWindowShouldClose(vulkanEngine->lveWindow.window)) {
-        glfwPollEvents();
+        if (simulationEngine->isPaused && idleRedrawFrames == 0) {
+            glfwWaitEventsTimeout(IDLE_WAIT_TIMEOUT);
+            currentTime = std::chrono::high_resolution_clock::now();
+        } else {
+            glfwPollEvents();
+        }
+
+        if (vulkanEngine->lveWindow.wasInputReceived() || simulationEngine->stepCounter != lastStepCounter) {
+            vulkanEngine->lveWindow.resetInputReceivedFlag();
+            lastStepCounter = simulationEngine->stepCounter;
+            idleRedrawFrames = IDLE_REDRAW_FRAMES;
+        }
 
         auto  newTime = std::chrono::high_resolution_clock::now();
         float frameTime = std::chrono::duration<float, std::chrono::seconds::period>(newTime - currentTime).count();
@@ -95,11 +331,19 @@ int main() {
             simulationEngine->updateRunTimer();
         }
 
+        // Steps apply the commands the UI queued themselves, while paused they are applied every frame
+        if (simulationEngine->isPaused) {
+            simulationEngine->applyCommands();
+        }
+
         if (!simulationEngine->isPaused) {
-            micrasController.update();
+            // The first paused frames still show the latest state
+            idleRedrawFrames = IDLE_REDRAW_FRAMES;
+
             simulationEngine->updateSimulation();
             simulationEngine->stepCounter++;
-            if (simulationEngine->stepCounter % lveImgui.physicsStepsPerFrame == 0) {
+            if (simulationEngine->stepCounter % lveImgui.physicsStepsPerFrame == 0 && framePacer.shouldRenderFrame()) {
+                framePacer.beginFrame();
                 vulkanEngine->updateRenderableModels();
                 if (auto commandBuffer = vulkanEngine->lveRenderer.beginFrame()) {
                     lveImgui.newFrame();
@@ -115,14 +359,21 @@ int main() {
 
                     // render
                     vulkanEngine->lveRenderer.beginSwapChainRenderPass(commandBuffer);
+                    const uint32_t sceneScope = gpuProfiler.beginScope(commandBuffer, "Scene");
                     simpleRenderSystem.renderGameObjects(frameInfo, vulkanEngine->gameObjects);
+                    gpuProfiler.endScope(commandBuffer, sceneScope);
                     lveImgui.runExample(micrasBody);
+                    const uint32_t imguiScope = gpuProfiler.beginScope(commandBuffer, "ImGui");
                     lveImgui.render(commandBuffer);
+                    gpuProfiler.endScope(commandBuffer, imguiScope);
                     vulkanEngine->lveRenderer.endSwapChainRenderPass(commandBuffer);
                     vulkanEngine->lveRenderer.endFrame();
                 }
+                framePacer.endFrame();
             }
-        } else {
+        } else if (idleRedrawFrames > 0 && framePacer.shouldRenderFrame()) {
+            idleRedrawFrames--;
+            framePacer.beginFrame();
             vulkanEngine->updateRenderableModels();
             if (auto commandBuffer = vulkanEngine->lveRenderer.beginFrame()) {
                 lveImgui.newFrame();
@@ -138,15 +389,32 @@ int main() {
 
                 // render
                 vulkanEngine->lveRenderer.beginSwapChainRenderPass(commandBuffer);
+                const uint32_t sceneScope = gpuProfiler.beginScope(commandBuffer, "Scene");
                 simpleRenderSystem.renderGameObjects(frameInfo, vulkanEngine->gameObjects);
+                gpuProfiler.endScope(commandBuffer, sceneScope);
                 lveImgui.runExample(micrasBody);
+                const uint32_t imguiScope = gpuProfiler.beginScope(commandBuffer, "ImGui");
                 lveImgui.render(commandBuffer);
+                gpuProfiler.endScope(commandBuffer, imguiScope);
                 vulkanEngine->lveRenderer.endSwapChainRenderPass(commandBuffer);
                 vulkanEngine->lveRenderer.endFrame();
             }
+            framePacer.endFrame();
+        }
+
+        if (benchmarkFrames > 0 && framePacer.getFrameCount() >= static_cast<uint64_t>(benchmarkFrames)) {
+            std::cout << "Benchmark: " << framePacer.getFrameCount() << " frames, "
+                      << lve::LveSwapChain::getPresentModeName(vulkanEngine->lveRenderer.getPresentMode()) << " present mode\n"
+                      << "  frame interval p50 " << framePacer.getFrameIntervalPercentile(50.0f) << " ms, p95 "
+                      << framePacer.getFrameIntervalPercentile(95.0f) << " ms, p99 " << framePacer.getFrameIntervalPercentile(99.0f) << " ms\n"
+                      << "  render time    p50 " << framePacer.getRenderTimePercentile(50.0f) << " ms, p95 "
+                      << framePacer.getRenderTimePercentile(95.0f) << " ms, p99 " << framePacer.getRenderTimePercentile(99.0f) << " ms"
+                      << std::endl;
+            break;
         }
     }
     vkDeviceWaitIdle(vulkanEngine->lveDevice.device());
+    writeTrace();
 
     return 0;
 }
@@ -0,0 +1,239 @@
+#include "physics/box2d_allocator.hpp"
+
+#include "box2d/box2d.h"
+
+#include <algorithm>
+#include <bit>
+#include <cassert>
+#include <cstdlib>
+
+namespace micrasverse::physics {
+
+namespace {
+
+// Box2D asks for blocks aligned to B2_ALIGNMENT, 32 bytes, so the header keeps the payload aligned
+constexpr size_t HEADER_SIZE = 32;
+constexpr size_t CHUNK_ALIGNMENT = 64;
+constexpr size_t MIN_BLOCK_SIZE = 64;
+constexpr size_t CHUNK_SIZE = 256 * 1024;
+
+struct BlockHeader {
+    Box2DArena*         arena;   // null for blocks of the global heap
+    void*               memory;  // pointer to free for blocks of the global heap
+    uint32_t            size;
+    uint8_t             sizeClass;
+    Box2DMemoryCategory category;
+};
+
+static_assert(sizeof(BlockHeader) <= HEADER_SIZE);
+
+thread_local Box2DArena*         currentArena = nullptr;
+thread_local Box2DMemoryCategory currentCategory = Box2DMemoryCategory::WORLD;
+
+std::mutex       unscopedMutex;
+Box2DMemoryStats unscopedStats;
+
+BlockHeader* getHeader(void* memory) {
+    return reinterpret_cast<BlockHeader*>(static_cast<std::byte*>(memory) - HEADER_SIZE);
+}
+
+// Over-allocates so the returned pointer is aligned to CHUNK_ALIGNMENT, original is the pointer to free
+std::byte* allocateAligned(size_t size, void*& original) {
+    original = std::malloc(size + CHUNK_ALIGNMENT);
+    if (original == nullptr) {
+        return nullptr;
+    }
+
+    const auto address = reinterpret_cast<uintptr_t>(original);
+    return reinterpret_cast<std::byte*>((address + CHUNK_ALIGNMENT - 1) & ~(CHUNK_ALIGNMENT - 1));
+}
+
+void addAllocation(Box2DMemoryStats& stats, Box2DMemoryCategory category, size_t size) {
+    stats.bytesByCategory[static_cast<size_t>(category)] += size;
+    stats.bytesInUse += size;
+    stats.peakBytesInUse = std::max(stats.peakBytesInUse, stats.bytesInUse);
+    stats.allocations++;
+}
+
+void removeAllocation(Box2DMemoryStats& stats, Box2DMemoryCategory category, size_t size) {
+    stats.bytesByCategory[static_cast<size_t>(category)] -= size;
+    stats.bytesInUse -= size;
+}
+
+void* allocateBox2D(unsigned int size, int alignment) {
+    assert(static_cast<size_t>(alignment) <= HEADER_SIZE);
+    (void)alignment;
+
+    if (currentArena != nullptr) {
+        return currentArena->allocate(size, currentCategory);
+    }
+
+    void*      original = nullptr;
+    std::byte* block = allocateAligned(size + HEADER_SIZE, original);
+    if (block == nullptr) {
+        return nullptr;
+    }
+
+    *reinterpret_cast<BlockHeader*>(block) = {nullptr, original, size, 0, currentCategory};
+
+    {
+        const std::lock_guard<std::mutex> lock(unscopedMutex);
+        addAllocation(unscopedStats, currentCategory, size);
+        unscopedStats.reservedBytes += size + HEADER_SIZE + CHUNK_ALIGNMENT;
+        unscopedStats.peakReservedBytes = std::max(unscopedStats.peakReservedBytes, unscopedStats.reservedBytes);
+    }
+
+    return block + HEADER_SIZE;
+}
+
+void freeBox2D(void* memory) {
+    if (memory == nullptr) {
+        return;
+    }
+
+    const BlockHeader* header = getHeader(memory);
+    if (header->arena != nullptr) {
+        header->arena->deallocate(memory);
+        return;
+    }
+
+    {
+        const std::lock_guard<std::mutex> lock(unscopedMutex);
+        removeAllocation(unscopedStats, header->category, header->size);
+        unscopedStats.reservedBytes -= header->size + HEADER_SIZE + CHUNK_ALIGNMENT;
+    }
+
+    std::free(header->memory);
+}
+
+}  // namespace
+
+const char* getBox2DMemoryCategoryName(Box2DMemoryCategory category) {
+    switch (category) {
+        case Box2DMemoryCategory::WORLD:
+            return "World";
+        case Box2DMemoryCategory::MAZE:
+            return "Maze";
+        case Box2DMemoryCategory::ROBOTS:
+            return "Robots";
+        case Box2DMemoryCategory::STEP:
+            return "Step";
+        default:
+            return "Unknown";
+    }
+}
+
+Box2DArena::~Box2DArena() {
+    // Blocks still held by the world are released with their chunks, Box2D must not free them afterwards
+    for (void* chunk : this->chunks) {
+        std::free(chunk);
+    }
+}
+
+void* Box2DArena::allocate(size_t size, Box2DMemoryCategory category) {
+    const size_t  blockSize = std::max(MIN_BLOCK_SIZE, std::bit_ceil(size + HEADER_SIZE));
+    const uint8_t sizeClass = static_cast<uint8_t>(std::countr_zero(blockSize));
+
+    const std::lock_guard<std::mutex> lock(this->mutex);
+
+    std::byte* block = this->freeLists[sizeClass];
+    if (block != nullptr) {
+        this->freeLists[sizeClass] = *reinterpret_cast<std::byte**>(block);
+    } else {
+        block = this->carve(blockSize);
+        if (block == nullptr) {
+            return nullptr;
+        }
+    }
+
+    *reinterpret_cast<BlockHeader*>(block) = {this, nullptr, static_cast<uint32_t>(size), sizeClass, category};
+    addAllocation(this->stats, category, size);
+
+    return block + HEADER_SIZE;
+}
+
+void Box2DArena::deallocate(void* memory) {
+    const BlockHeader header = *getHeader(memory);
+
+    const std::lock_guard<std::mutex> lock(this->mutex);
+    removeAllocation(this->stats, header.category, header.size);
+    this->pushFreeBlock(reinterpret_cast<std::byte*>(getHeader(memory)), header.sizeClass);
+}
+
+Box2DMemoryStats Box2DArena::getStats() const {
+    const std::lock_guard<std::mutex> lock(this->mutex);
+    return this->stats;
+}
+
+std::byte* Box2DArena::carve(size_t blockSize) {
+    const size_t chunkSize = std::max(blockSize, CHUNK_SIZE);
+
+    if (blockSize > CHUNK_SIZE || this->cursor == nullptr || static_cast<size_t>(this->chunkEnd - this->cursor) < blockSize) {
+        void*      original = nullptr;
+        std::byte* chunk = allocateAligned(chunkSize, original);
+        if (chunk == nullptr) {
+            return nullptr;
+        }
+
+        this->chunks.push_back(original);
+        this->stats.reservedBytes += chunkSize + CHUNK_ALIGNMENT;
+        this->stats.peakReservedBytes = std::max(this->stats.peakReservedBytes, this->stats.reservedBytes);
+
+        // Large blocks get a chunk of their own and are reused through their free list
+        if (blockSize > CHUNK_SIZE) {
+            return chunk;
+        }
+
+        // The rest of the previous chunk is split into free blocks instead of being wasted
+        while (this->cursor != nullptr && static_cast<size_t>(this->chunkEnd - this->cursor) >= MIN_BLOCK_SIZE) {
+            const size_t remainderSize = std::bit_floor(static_cast<size_t>(this->chunkEnd - this->cursor));
+            this->pushFreeBlock(this->cursor, static_cast<uint8_t>(std::countr_zero(remainderSize)));
+            this->cursor += remainderSize;
+        }
+
+        this->cursor = chunk;
+        this->chunkEnd = chunk + chunkSize;
+    }
+
+    std::byte* block = this->cursor;
+    this->cursor += blockSize;
+    return block;
+}
+
+void Box2DArena::pushFreeBlock(std::byte* block, uint8_t sizeClass) {
+    *reinterpret_cast<std::byte**>(block) = this->freeLists[sizeClass];
+    this->freeLists[sizeClass] = block;
+}
+
+Box2DArenaScope::Box2DArenaScope(Box2DArena& arena, Box2DMemoryCategory category) : Box2DArenaScope(&arena, category) { }
+
+Box2DArenaScope::Box2DArenaScope(Box2DArena* arena, Box2DMemoryCategory category) :
+    previousArena(currentArena), previousCategory(currentCategory) {
+    currentArena = arena;
+    currentCategory = category;
+}
+
+Box2DArenaScope::~Box2DArenaScope() {
+    currentArena = this->previousArena;
+    currentCategory = this->previousCategory;
+}
+
+Box2DArena* Box2DArenaScope::getCurrentArena() {
+    return currentArena;
+}
+
+Box2DMemoryCategory Box2DArenaScope::getCurrentCategory() {
+    return currentCategory;
+}
+
+void installBox2DAllocator() {
+    static std::once_flag installed;
+    std::call_once(installed, [] { b2SetAllocator(allocateBox2D, freeBox2D); });
+}
+
+Box2DMemoryStats getUnscopedBox2DMemoryStats() {
+    const std::lock_guard<std::mutex> lock(unscopedMutex);
+    return unscopedStats;
+}
+
+}  // namespace micrasverse::physics
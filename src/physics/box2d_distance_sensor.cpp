@@ -1,6 +1,7 @@
 #include "physics/box2d_distance_sensor.hpp"
 #include "constants.hpp"
 #include <cmath>
+#include <algorithm>
 
 namespace micrasverse::physics {
 
@@ -12,17 +13,12 @@ Box2DDistanceSensor::Box2DDistanceSensor(
     localPosition{localPosition.x, localPosition.y},
     localDirection{std::cos(angle), std::sin(angle)},
     rayDirections{{
-        {std::cos(angle - B2_PI / 18.0F), std::sin(angle - B2_PI / 18.0F)},
-        {std::cos(angle - B2_PI / 36.0F), std::sin(angle - B2_PI / 36.0F)},
-        {std::cos(angle + B2_PI / 18.0F), std::sin(angle + B2_PI / 18.0F)},
-        {std::cos(angle + B2_PI / 36.0F), std::sin(angle + B2_PI / 36.0F)},
-    }},
-    sensorWeights{{
-        0.8F,
-        0.97F,
-        0.8F,
-        0.97F,
+        {std::cos(angle + RAY_ANGLE_OFFSETS[0]), std::sin(angle + RAY_ANGLE_OFFSETS[0])},
+        {std::cos(angle + RAY_ANGLE_OFFSETS[1]), std::sin(angle + RAY_ANGLE_OFFSETS[1])},
+        {std::cos(angle + RAY_ANGLE_OFFSETS[2]), std::sin(angle + RAY_ANGLE_OFFSETS[2])},
+        {std::cos(angle + RAY_ANGLE_OFFSETS[3]), std::sin(angle + RAY_ANGLE_OFFSETS[3])},
     }},
+    sensorWeights{RAY_WEIGHTS},
     maxDistance(maxDistance),
     reading(0.0f),
     rayDirection{0.0f, 0.0f} {
@@ -49,6 +45,29 @@ void Box2DDistanceSensor::setDirection(const micrasverse::types::Vec2& newDirect
     update();
 }
 
+void Box2DDistanceSensor::setQueryFilter(const b2QueryFilter& filter) {
+    this->queryFilter = filter;
+    this->invalidateCache();
+}
+
+void Box2DDistanceSensor::attach(b2WorldId worldId, b2BodyId bodyId) {
+    this->worldId = worldId;
+    this->bodyId = bodyId;
+    this->invalidateCache();
+    update();
+}
+
+void Box2DDistanceSensor::setCacheSettings(const RaycastCacheSettings& settings) {
+    this->cacheSettings = settings;
+    this->invalidateCache();
+}
+
+void Box2DDistanceSensor::invalidateCache() {
+    for (auto& cache : this->rayCache) {
+        cache.valid = false;
+    }
+}
+
 micrasverse::types::Vec2 Box2DDistanceSensor::getRayDirection() const {
     return {rayDirection.x, rayDirection.y};
 }
@@ -74,19 +93,15 @@ void Box2DDistanceSensor::performRayCast() {
     for (size_t i = 0; i < this->rayDirections.size(); i++) {
         const auto& rayDirection = this->rayDirections[i];
         this->worldDirection = b2Body_GetWorldVector(this->bodyId, rayDirection);
-        const b2Vec2        translation = this->maxDistance * worldDirection;
-        const b2QueryFilter filter = b2DefaultQueryFilter();
-        const b2RayResult   output = b2World_CastRayClosest(b2Body_GetWorld(this->bodyId), origin, translation, filter);
-        this->intersectionPoint = origin + output.fraction * translation;
+        const float fraction = this->castRay(this->rayCache[i], origin, this->worldDirection);
+        this->intersectionPoint = origin + (fraction * this->maxDistance) * worldDirection;
         this->reading += this->sensorWeights[i] * b2Length(intersectionPoint - origin);
         totalWeight += this->sensorWeights[i];
     }
 
     this->worldDirection = b2Body_GetWorldVector(this->bodyId, this->localDirection);
-    const b2Vec2        translation = this->maxDistance * worldDirection;
-    const b2QueryFilter filter = b2DefaultQueryFilter();
-    const b2RayResult   output = b2World_CastRayClosest(b2Body_GetWorld(this->bodyId), origin, translation, filter);
-    this->intersectionPoint = origin + output.fraction * translation;
+    const float fraction = this->castRay(this->rayCache.back(), origin, this->worldDirection);
+    this->intersectionPoint = origin + (fraction * this->maxDistance) * worldDirection;
     this->reading += b2Length(intersectionPoint - origin);
 
     this->reading /= totalWeight + 1.0F;
@@ -99,4 +114,27 @@ void Box2DDistanceSensor::performRayCast() {
     this->visualMidPoint = b2Vec2{origin.x + (intersectionPoint.x - origin.x) * 0.5f, origin.y + (intersectionPoint.y - origin.y) * 0.5f};
 }
 
+float Box2DDistanceSensor::castRay(CachedRay& cache, b2Vec2 origin, b2Vec2 direction) {
+    const b2Vec2 translation = this->maxDistance * direction;
+
+    // Robots move on their own, only rays that see nothing but the static maze can keep their results
+    const bool cacheable = this->cacheSettings.enabled && (this->queryFilter.maskBits & ~MAZE_CATEGORY) == 0;
+
+    // A ray that moved at all is cast again, a closest-hit world cast already stops at the first wall it finds
+    if (cacheable && cache.valid) {
+        const b2Vec2 originOffset = origin - cache.origin;
+        if (b2Dot(originOffset, originOffset) <= this->cacheSettings.originEpsilon * this->cacheSettings.originEpsilon &&
+            1.0F - b2Dot(direction, cache.direction) <= this->cacheSettings.directionEpsilon) {
+            this->cacheStats.reused++;
+            return cache.fraction;
+        }
+    }
+
+    const b2RayResult output = b2World_CastRayClosest(b2Body_GetWorld(this->bodyId), origin, translation, this->queryFilter);
+    this->cacheStats.cast++;
+
+    cache = {origin, direction, output.fraction, cacheable};
+    return output.fraction;
+}
+
 }  // namespace micrasverse::physics
@@ -4,11 +4,13 @@
 
 #include "box2d/box2d.h"
 
+#include <cmath>
 #include <fstream>
 #include <stdexcept>
 #include <regex>
 #include <iostream>
 #include <filesystem>
+#include <unordered_map>
 
 namespace micrasverse::physics {
 
@@ -19,7 +21,13 @@ Maze::Maze(b2WorldId worldId, const std::string_view filename) : worldId(worldId
 
 // Parse maze from file
 void Maze::loadFromFile(const std::string_view filename) {
-    std::string filenameStr = std::string(filename);
+    this->elements = parseFile(filename);
+    this->createBox2dObjects();
+}
+
+std::vector<Maze::Element> Maze::parseFile(const std::string_view filename) {
+    std::vector<Element> elements;
+    std::string          filenameStr = std::string(filename);
 
     if (!std::filesystem::exists(filenameStr)) {
         throw std::runtime_error("File does not exist: " + filenameStr);
@@ -80,7 +88,7 @@ void Maze::loadFromFile(const std::string_view filename) {
         row++;
     }
 
-    this->createBox2dObjects();
+    return elements;
 }
 
 const std::vector<Maze::Element>& Maze::getElements() const {
@@ -89,19 +97,76 @@ const std::vector<Maze::Element>& Maze::getElements() const {
 
 // Create Box2D objects
 void Maze::createBox2dObjects() {
+    this->mazeBodies.reserve(this->mazeBodies.size() + this->elements.size());
+    this->mazeBodiesObjects.reserve(this->mazeBodiesObjects.size() + this->elements.size());
+
     for (const auto& element : this->elements) {
-        auto rectangleBody = std::make_unique<RectangleBody>(worldId, element.position, element.size, b2_staticBody, 100.0f, 0.0f, 0.5f);
-        this->mazeBodies.push_back(rectangleBody->getBodyId());
-        this->mazeBodiesObjects.push_back(std::move(rectangleBody));
+        this->mazeBodiesObjects.push_back(this->createBody(element));
+        this->mazeBodies.push_back(this->mazeBodiesObjects.back().getBodyId());
     }
 }
 
+RectangleBody Maze::createBody(const Element& element) const {
+    b2Filter filter = b2DefaultFilter();
+    filter.categoryBits = MAZE_CATEGORY;
+    filter.maskBits = ROBOT_CATEGORY;
+
+    return RectangleBody(worldId, element.position, element.size, b2_staticBody, 100.0f, 0.0f, 0.5f, filter);
+}
+
+uint64_t Maze::getElementKey(const Element& element) {
+    // Every file places its elements with the same grid formula, micrometers are far finer than the grid
+    const auto x = static_cast<uint64_t>(std::lround(element.position.x * 1e6f)) & 0xFFFFFFF;
+    const auto y = static_cast<uint64_t>(std::lround(element.position.y * 1e6f)) & 0xFFFFFFF;
+    return (static_cast<uint64_t>(static_cast<uint8_t>(element.type)) << 56) | (x << 28) | y;
+}
+
 void Maze::reloadFromFile(const std::string_view filename) {
     std::string filenameStr = std::string(filename);
     this->destroy();                  // Destroy existing Box2D objects
     this->loadFromFile(filenameStr);  // Load the maze from the new file
 }
 
+MazeDelta Maze::reloadIncrementally(const std::string_view filename) {
+    // Parsing first leaves the current maze untouched when the file can't be read
+    std::vector<Element> newElements = parseFile(filename);
+
+    std::unordered_map<uint64_t, size_t> currentIndices;
+    currentIndices.reserve(this->elements.size());
+    for (size_t i = 0; i < this->elements.size(); i++) {
+        currentIndices.emplace(getElementKey(this->elements[i]), i);
+    }
+
+    MazeDelta                  delta;
+    std::vector<b2BodyId>      bodies;
+    std::vector<RectangleBody> bodiesObjects;
+    bodies.reserve(newElements.size());
+    bodiesObjects.reserve(newElements.size());
+
+    for (const auto& element : newElements) {
+        const auto current = currentIndices.find(getElementKey(element));
+        if (current != currentIndices.end()) {
+            // A body is moved over once, a repeated element of the new file gets a body of its own
+            bodiesObjects.push_back(std::move(this->mazeBodiesObjects[current->second]));
+            currentIndices.erase(current);
+            delta.kept++;
+        } else {
+            bodiesObjects.push_back(this->createBody(element));
+            delta.added++;
+        }
+        bodies.push_back(bodiesObjects.back().getBodyId());
+    }
+
+    // Bodies that were not moved over belong to walls the new maze doesn't have, they are destroyed with the old list
+    delta.removed = this->mazeBodiesObjects.size() - delta.kept;
+
+    this->mazeBodiesObjects = std::move(bodiesObjects);
+    this->mazeBodies = std::move(bodies);
+    this->elements = std::move(newElements);
+
+    return delta;
+}
+
 // Destroy Box2D objects
 void Maze::destroy() {
     for (auto& bodyId : mazeBodies) {
@@ -113,4 +178,13 @@ void Maze::destroy() {
     mazeBodiesObjects.clear();  // Clear the list of maze body objects
     elements.clear();           // Clear the list of maze elements
 }
+
+void Maze::release() {
+    for (auto& bodyObject : mazeBodiesObjects) {
+        bodyObject.release();
+    }
+    mazeBodies.clear();
+    mazeBodiesObjects.clear();
+    elements.clear();
+}
 }  // namespace micrasverse::physics
@@ -3,59 +3,126 @@
 #include "physics/box2d_motor.hpp"
 #include "physics/box2d_rectanglebody.hpp"
 #include "constants.hpp"
+#include "micrasverse_core/profiler.hpp"
 #include "micrasverse_core/types.hpp"
 #include "io/keyboard.hpp"
 
+#include <array>
 #include <cstdint>
-#include <vector>
+#include <utility>
 #include <cmath>
 #include <iostream>
 
-// Helper struct for sensor configuration
-struct SensorConfig {
-    float  angle;
-    b2Vec2 local_position;
-};
-
 namespace micrasverse::physics {
-// Constructor
-Box2DMicrasBody::Box2DMicrasBody(b2WorldId worldId, b2Vec2 position, b2Vec2 size, b2BodyType type, float density, float friction, float restitution) :
-    size(size), rectBody(std::make_unique<RectangleBody>(worldId, position, size, type, density, friction, restitution)) {
-    bodyId = rectBody->getBodyId();
-
-    // Initialize distance sensors
-    SensorConfig sensorConfigs[4] = {
-        {B2_PI / 2.0f, {-MICRAS_HALFWIDTH, MICRAS_HALFHEIGHT}},
-        {5.0f * B2_PI / 6.0f, {-MICRAS_HALFWIDTH / 2, MICRAS_HALFHEIGHT}},
-        {B2_PI / 6.0f, {MICRAS_HALFWIDTH / 2, MICRAS_HALFHEIGHT}},
-        {B2_PI / 2.0f, {MICRAS_HALFWIDTH, MICRAS_HALFHEIGHT}}
-    };
-
-    for (size_t i = 0; i < 4; i++) {
-        const auto& config = sensorConfigs[i];
-
-        // Convert b2Vec2 to types::Vec2 for the constructor
-        micrasverse::types::Vec2 localPos = {config.local_position.x, config.local_position.y};
-
-        distanceSensors.push_back(std::make_unique<Box2DDistanceSensor>(
-            worldId, bodyId, localPos, config.angle,
-            MAZE_FLOOR_WIDTH  // max distance
-        ));
-    }
 
-    // Initialize motors with proper wheel positions
-    leftMotor = std::make_unique<Box2DMotor>(
+namespace {
+
+// One sensor per mount, built in place in the array
+template <size_t... Index>
+std::array<Box2DDistanceSensor, DISTANCE_SENSOR_COUNT> makeDistanceSensors(b2WorldId worldId, b2BodyId bodyId, std::index_sequence<Index...>) {
+    return {Box2DDistanceSensor(
+        worldId, bodyId, DISTANCE_SENSOR_MOUNTS[Index].localPosition, DISTANCE_SENSOR_MOUNTS[Index].angle,
+        MAZE_FLOOR_WIDTH  // max distance
+    )...};
+}
+
+}  // namespace
+
+// Constructor
+Box2DMicrasBody::Box2DMicrasBody(
+    b2WorldId worldId, b2Vec2 position, b2Vec2 size, b2BodyType type, float density, float friction, float restitution,
+    RobotCollisionMode collisionMode
+) :
+    rectBody(std::in_place, worldId, position, size, type, density, friction, restitution),
+    bodyId(rectBody->getBodyId()),
+    size(size),
+    type(type),
+    density(density),
+    friction(friction),
+    restitution(restitution),
+    collisionMode(collisionMode),
+    distanceSensors(makeDistanceSensors(worldId, bodyId, std::make_index_sequence<DISTANCE_SENSOR_COUNT>{})),
+    // Motors with proper wheel positions
+    leftMotor(
         bodyId, micrasverse::types::Vec2{-MICRAS_HALFWIDTH, 0.0f},
         true  // isLeftWheel
-    );
-
-    rightMotor = std::make_unique<Box2DMotor>(
+    ),
+    rightMotor(
         bodyId, micrasverse::types::Vec2{MICRAS_HALFWIDTH, 0.0f},
         false  // isLeftWheel
-    );
+    ) {
+    b2Shape_EnableHitEvents(this->rectBody->getShapeId(), true);
+    this->setCollisionMode(collisionMode);
+    this->publishState();
+}
+
+void Box2DMicrasBody::setCollisionMode(RobotCollisionMode collisionMode) {
+    this->collisionMode = collisionMode;
+    const uint64_t collisionMask = (collisionMode == RobotCollisionMode::INTERACTION) ? (MAZE_CATEGORY | ROBOT_CATEGORY) : MAZE_CATEGORY;
+
+    b2Filter filter = b2DefaultFilter();
+    filter.categoryBits = ROBOT_CATEGORY;
+    filter.maskBits = collisionMask;
+    b2Shape_SetFilter(this->rectBody->getShapeId(), filter);
+
+    b2QueryFilter queryFilter = b2DefaultQueryFilter();
+    queryFilter.categoryBits = ROBOT_CATEGORY;
+    queryFilter.maskBits = collisionMask;
+    for (auto& sensor : this->distanceSensors) {
+        sensor.setQueryFilter(queryFilter);
+    }
+}
+
+void Box2DMicrasBody::resetState() {
+    this->leftMotor.reset();
+    this->rightMotor.reset();
+
+    this->linearVelocity = {0.0f, 0.0f};
+    this->linearSpeed = 0.0f;
+    this->acceleration = {0.0f, 0.0f};
+    this->linearAcceleration = 0.0f;
+
+    this->robotBody.leftCommand = 0.0f;
+    this->robotBody.rightCommand = 0.0f;
+    this->robotBody.isFanOn = false;
+    this->robotBody.wallCollisions = 0;
+
+    for (auto& sensor : this->distanceSensors) {
+        sensor.invalidateCache();
+    }
+}
+
+void Box2DMicrasBody::moveToWorld(b2WorldId worldId) {
+    const b2Transform transform = b2Body_GetTransform(this->bodyId);
+    const b2Vec2      velocity = b2Body_GetLinearVelocity(this->bodyId);
+    const float       angularVelocity = b2Body_GetAngularVelocity(this->bodyId);
+
+    this->rectBody.emplace(worldId, transform.p, this->size, this->type, this->density, this->friction, this->restitution);
+    this->bodyId = this->rectBody->getBodyId();
+    b2Shape_EnableHitEvents(this->rectBody->getShapeId(), true);
+
+    b2Body_SetTransform(this->bodyId, transform.p, transform.q);
+    b2Body_SetLinearVelocity(this->bodyId, velocity);
+    b2Body_SetAngularVelocity(this->bodyId, angularVelocity);
+
+    for (auto& sensor : this->distanceSensors) {
+        sensor.attach(worldId, this->bodyId);
+    }
+    this->leftMotor.setBodyId(this->bodyId);
+    this->rightMotor.setBodyId(this->bodyId);
+
+    this->setCollisionMode(this->collisionMode);
+    this->publishState();
+}
+
+void Box2DMicrasBody::releaseBody() {
+    this->rectBody->release();
+    this->bodyId = b2_nullBodyId;
 }
 
 void Box2DMicrasBody::update(float deltaTime) {
+    MICRASVERSE_PROFILE_ZONE("Box2DMicrasBody::update");
+
     // Calculate acceleration as change in velocity over time
     b2Vec2 currentVelocity = b2Body_GetLinearVelocity(bodyId);
     this->acceleration = (currentVelocity - this->linearVelocity) * (1.0f / deltaTime);
@@ -66,16 +133,72 @@ void Box2DMicrasBody::update(float deltaTime) {
     this->linearSpeed = b2Length(currentVelocity);
 
     // Update physical components
-    updateFriction();
+    {
+        MICRASVERSE_PROFILE_ZONE("friction");
+        updateFriction();
+    }
 
     // Update sensors
-    for (auto& sensor : distanceSensors) {
-        sensor->update();
+    {
+        MICRASVERSE_PROFILE_ZONE("sensors");
+        for (auto& sensor : distanceSensors) {
+            sensor.update();
+        }
     }
 
     // Update motors
-    leftMotor->update(deltaTime);
-    rightMotor->update(deltaTime);
+    MICRASVERSE_PROFILE_ZONE("motors");
+    leftMotor.setCommand(robotBody.leftCommand);
+    rightMotor.setCommand(robotBody.rightCommand);
+    leftMotor.isFanOn = robotBody.isFanOn;
+    rightMotor.isFanOn = robotBody.isFanOn;
+    leftMotor.update(deltaTime);
+    rightMotor.update(deltaTime);
+}
+
+void Box2DMicrasBody::publishState() {
+    const b2Transform transform = b2Body_GetTransform(bodyId);
+    const b2Vec2      velocity = b2Body_GetLinearVelocity(bodyId);
+
+    robotBody.position = {transform.p.x, transform.p.y};
+    robotBody.angle = b2Rot_GetAngle(transform.q);
+    robotBody.linearVelocity = {velocity.x, velocity.y};
+    robotBody.angularVelocity = b2Body_GetAngularVelocity(bodyId);
+    robotBody.leftWheelPosition = leftMotor.getPosition();
+    robotBody.rightWheelPosition = rightMotor.getPosition();
+
+    for (size_t i = 0; i < distanceSensors.size(); i++) {
+        robotBody.distanceReadings[i] = distanceSensors[i].getReading();
+    }
+
+    // A rectangle in a maze never touches more than a handful of shapes at once
+    std::array<b2ContactData, 8> contacts;
+    const int                    contactCount = b2Body_GetContactData(bodyId, contacts.data(), static_cast<int>(contacts.size()));
+
+    robotBody.isTouchingWall = false;
+    for (int i = 0; i < contactCount; i++) {
+        const uint64_t categories = b2Shape_GetFilter(contacts[i].shapeIdA).categoryBits | b2Shape_GetFilter(contacts[i].shapeIdB).categoryBits;
+        if (contacts[i].manifold.pointCount > 0 && (categories & MAZE_CATEGORY) != 0) {
+            robotBody.isTouchingWall = true;
+            break;
+        }
+    }
+}
+
+void Box2DMicrasBody::setRaycastCacheSettings(const RaycastCacheSettings& settings) {
+    for (auto& sensor : this->distanceSensors) {
+        sensor.setCacheSettings(settings);
+    }
+}
+
+RaycastCacheStats Box2DMicrasBody::getRaycastCacheStats() const {
+    RaycastCacheStats total;
+    for (const auto& sensor : this->distanceSensors) {
+        const RaycastCacheStats& stats = sensor.getCacheStats();
+        total.reused += stats.reused;
+        total.cast += stats.cast;
+    }
+    return total;
 }
 
 void Box2DMicrasBody::processInput(float deltaTime) {
@@ -113,13 +236,4 @@ b2Vec2 Box2DMicrasBody::getLateralVelocity() const {
     return b2Dot(lateralNormal, linearVelocity) * lateralNormal;
 }
 
-// Explicit destructor definition
-Box2DMicrasBody::~Box2DMicrasBody() {
-    // Explicitly destroy components in reverse order of creation
-    rightMotor.reset();
-    leftMotor.reset();
-    distanceSensors.clear();
-    rectBody.reset();
-}
-
 }  // namespace micrasverse::physics
@@ -1,4 +1,5 @@
 #include "physics/box2d_motor.hpp"
+#include "physics/motor_model.hpp"
 #include <cmath>
 
 namespace micrasverse::physics {
@@ -33,6 +34,17 @@ Box2DMotor::Box2DMotor(
     bodyMass = b2Body_GetMass(bodyId);
 }
 
+void Box2DMotor::reset() {
+    this->inputCommand = 0.0f;
+    this->current = 0.0f;
+    this->rotorAngularVelocity = 0.0f;
+    this->appliedForce = 0.0f;
+    this->torque = 0.0f;
+    this->bodyLinearVelocity = 0.0f;
+    this->bodyAngularVelocity = 0.0f;
+    this->isFanOn = false;
+}
+
 types::Vec2 Box2DMotor::getPosition() const {
     b2Vec2 worldPos = b2Body_GetWorldPoint(bodyId, localPosition);
     return {worldPos.x, worldPos.y};
@@ -44,10 +56,6 @@ void Box2DMotor::setCommand(float command) {
 }
 
 void Box2DMotor::update(float deltaTime, bool fanState) {
-    // Calculate input voltage based on the command
-    float inputVoltage = this->maxCommandVoltage * (this->inputCommand / 100.0f);
-
-    // Compute back EMF
     float angularVelocitySign = (this->leftWheel ? -1.0f : +1.0f);
     float linearVelocityDirection = b2Dot(b2Body_GetLinearVelocity(this->bodyId), b2Body_GetWorldVector(this->bodyId, this->localDirection));
 
@@ -55,36 +63,20 @@ void Box2DMotor::update(float deltaTime, bool fanState) {
 
     this->bodyAngularVelocity = b2Body_GetAngularVelocity(this->bodyId);
 
-    float wheelAngularVelocity =
-        (bodyLinearVelocity + angularVelocitySign * MICRAS_TRACK_WIDTH / 2.0f * b2Body_GetAngularVelocity(this->bodyId)) / (MICRAS_WHEEL_RADIUS);
-
-    this->rotorAngularVelocity = wheelAngularVelocity * MICRAS_GEAR_RATIO;
-
-    float backEMF = this->ke * this->rotorAngularVelocity;
-
-    // Compute current through the motor
-    this->current = (inputVoltage - backEMF) / this->resistance;
-
-    // Compute torque
-    this->torque = this->kt * this->current;
-
-    // Compute force applied at each wheel
-    float force = (this->torque * MICRAS_GEAR_RATIO) / (MICRAS_WHEEL_RADIUS);
-
-    float fanEffect = isFanOn ? 5.0f : 1.0f;
-
-    // Compute maximum frictional force
-    float maxFrictionForce = fanEffect * MICRAS_FRICTION * MICRAS_MASS * 9.81f;
-
-    // Apply the smaller of motor force and friction force
-    float appliedForce = ((std::abs(force) < maxFrictionForce) ? force : std::copysign(maxFrictionForce, force));
+    const MotorOutput<float> output = computeMotorOutput<float>(
+        this->inputCommand, this->bodyLinearVelocity, this->bodyAngularVelocity, getFanEffect(this->isFanOn), angularVelocitySign,
+        {this->resistance, this->ke, this->kt, this->maxCommandVoltage}
+    );
 
-    this->appliedForce = appliedForce;
+    this->rotorAngularVelocity = output.rotorAngularVelocity;
+    this->current = output.current;
+    this->torque = output.torque;
+    this->appliedForce = output.appliedForce;
 
     // Apply force at the position of the motor in the direction of angle
     const b2Vec2 worldDirection = b2Body_GetWorldVector(this->bodyId, this->localDirection);
 
-    b2Vec2 forceVector = appliedForce * worldDirection;
+    b2Vec2 forceVector = this->appliedForce * worldDirection;
 
     b2Body_ApplyForce(this->bodyId, forceVector, b2Body_GetWorldPoint(this->bodyId, this->localPosition), true);
 }
@@ -10,56 +10,182 @@
 #include "micras/proxy/argb.hpp"
 #include "micras/proxy/dip_switch.hpp"
 #include "constants.hpp"
+#include "micrasverse_core/profiler.hpp"
+#include <chrono>
 #include <filesystem>
 #include <iostream>
+#include <utility>
 
 namespace micrasverse::physics {
 
-Box2DPhysicsEngine::Box2DPhysicsEngine(const std::string_view mazePath) {
-    p_World = std::make_unique<World>();
+Box2DPhysicsEngine::Box2DPhysicsEngine(
+    const std::string_view mazePath, size_t micrasCount, RobotCollisionMode collisionMode, std::shared_ptr<TaskScheduler> taskScheduler
+) :
+    collisionMode(collisionMode) {
+    p_World = std::make_unique<World>(std::move(taskScheduler));
     b2WorldId worldId = p_World->getWorldId();
-    p_Maze = std::make_unique<Maze>(worldId, mazePath);
-    p_Micras = std::make_unique<Box2DMicrasBody>(
-        worldId, b2Vec2((CELL_SIZE + WALL_THICKNESS) / 2.0f, MICRAS_HALFHEIGHT + WALL_THICKNESS),
-        // b2Vec2((CELL_SIZE + WALL_THICKNESS) / 2.0f, CELL_SIZE + WALL_THICKNESS / 2.0f),
-        b2Vec2(MICRAS_WIDTH, MICRAS_HEIGHT), b2_dynamicBody, MICRAS_MASS, MICRAS_FRICTION, MICRAS_RESTITUTION
-    );
+    {
+        const auto allocationScope = p_World->scopeAllocations(Box2DMemoryCategory::MAZE);
+        p_Maze = std::make_unique<Maze>(worldId, mazePath);
+    }
+
+    for (size_t i = 0; i < micrasCount; i++) {
+        this->addMicras();
+    }
 }
 
 void Box2DPhysicsEngine::update(float deltaTime) {
-    if (p_World && p_Micras) {
-        p_Micras->update(deltaTime);
-        p_World->runStep(deltaTime, 1);
+    MICRASVERSE_PROFILE_ZONE("Box2DPhysicsEngine::update");
+
+    if (!p_World) {
+        return;
+    }
+
+    // All bodies apply their sensors and motors first so a single world step advances every robot
+    for (auto& micras : p_MicrasBodies) {
+        micras->update(deltaTime);
+    }
+
+    p_World->runStep(deltaTime, 1);
+    this->countWallCollisions();
+
+    MICRASVERSE_PROFILE_ZONE("publishState");
+    for (auto& micras : p_MicrasBodies) {
+        micras->getRobotBody().simulatedTime += deltaTime;
+        micras->publishState();
+    }
+}
+
+void Box2DPhysicsEngine::countWallCollisions() {
+    // Hit events are only raised when a touch starts faster than WALL_HIT_SPEED. Begin events would also count the
+    // speculative contact with the wall behind the start cell and robots resting or grazing along a wall.
+    const b2ContactEvents events = b2World_GetContactEvents(p_World->getWorldId());
+
+    for (int i = 0; i < events.hitCount; i++) {
+        const b2ContactHitEvent& event = events.hitEvents[i];
+        const uint64_t           categories = b2Shape_GetFilter(event.shapeIdA).categoryBits | b2Shape_GetFilter(event.shapeIdB).categoryBits;
+        if ((categories & MAZE_CATEGORY) == 0) {
+            continue;
+        }
+
+        for (auto& micras : p_MicrasBodies) {
+            const b2ShapeId shapeId = micras->getShapeId();
+            if (B2_ID_EQUALS(event.shapeIdA, shapeId) || B2_ID_EQUALS(event.shapeIdB, shapeId)) {
+                micras->getRobotBody().wallCollisions++;
+                break;
+            }
+        }
     }
 }
 
 void Box2DPhysicsEngine::loadMaze(const std::string_view mazePath) {
-    p_Maze->reloadFromFile(mazePath);
-    for (size_t i = 0; i < 4; i++) {
-        p_Micras->getDistanceSensor(i).update();
+    const auto startTime = std::chrono::steady_clock::now();
+
+    if (this->mazeReloadMode == MazeReloadMode::INCREMENTAL) {
+        const auto allocationScope = p_World->scopeAllocations(Box2DMemoryCategory::MAZE);
+        this->lastMazeReload.delta = p_Maze->reloadIncrementally(mazePath);
+    } else {
+        this->lastMazeReload.delta = this->rebuildWorld(mazePath);
     }
+
+    // Kept walls keep their shape ids, so cached hits would survive a reload that put a wall in front of them
+    for (auto& micras : p_MicrasBodies) {
+        for (auto& sensor : micras->getDistanceSensors()) {
+            sensor.invalidateCache();
+            sensor.update();
+        }
+        micras->publishState();
+    }
+
+    this->lastMazeReload.mode = this->mazeReloadMode;
+    this->lastMazeReload.milliseconds = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - startTime).count();
+}
+
+MazeDelta Box2DPhysicsEngine::rebuildWorld(const std::string_view mazePath) {
+    // The maze goes to a new world and the robots follow it, so the old world is destroyed whole instead of destroying
+    // every wall body. b2DestroyWorld still frees each of its blocks, but only to the arena's free lists. A maze that
+    // fails to load leaves the current world untouched.
+    auto      world = std::make_unique<World>(p_World->getSharedTaskScheduler());
+    b2WorldId worldId = world->getWorldId();
+
+    std::unique_ptr<Maze> maze;
+    {
+        const auto allocationScope = world->scopeAllocations(Box2DMemoryCategory::MAZE);
+        maze = std::make_unique<Maze>(worldId, mazePath);
+    }
+
+    {
+        const auto allocationScope = world->scopeAllocations(Box2DMemoryCategory::ROBOTS);
+        for (auto& micras : p_MicrasBodies) {
+            micras->moveToWorld(worldId);
+        }
+    }
+
+    const MazeDelta delta{maze->getElements().size(), p_Maze->getElements().size(), 0};
+
+    // The old walls go away with the old world, they must not touch their ids once it is destroyed
+    p_Maze->release();
+    std::swap(p_World, world);
+    world.reset();
+    p_Maze = std::move(maze);
+
+    return delta;
 }
 
 void Box2DPhysicsEngine::resetMicrasPosition() {
-    b2BodyId bodyId = p_Micras->getBodyId();
+    for (size_t i = 0; i < p_MicrasBodies.size(); i++) {
+        this->resetMicrasPosition(i);
+    }
+}
+
+void Box2DPhysicsEngine::resetMicrasPosition(size_t index) {
+    auto&      micras = p_MicrasBodies.at(index);
+    b2BodyId   bodyId = micras->getBodyId();
+    const auto allocationScope = p_World->scopeAllocations(Box2DMemoryCategory::ROBOTS);
     if (b2Body_IsValid(bodyId)) {
         b2Body_SetTransform(bodyId, (b2Vec2){(CELL_SIZE + WALL_THICKNESS) / 2.0f, MICRAS_HALFHEIGHT + WALL_THICKNESS}, (b2Rot){1.0f, 0.0f});
         b2Body_SetLinearVelocity(bodyId, (b2Vec2){0.0f, 0.0f});
         b2Body_SetAngularVelocity(bodyId, 0.0f);
     }
+    micras->resetState();
 
-    for (size_t i = 0; i < 4; i++) {
-        p_Micras->getDistanceSensor(i).update();
+    for (auto& sensor : micras->getDistanceSensors()) {
+        sensor.update();
+    }
+    micras->publishState();
+}
+
+size_t Box2DPhysicsEngine::addMicras() {
+    // Every robot starts at the same pose in the start cell, the firmware's pose estimate assumes it
+    const auto allocationScope = p_World->scopeAllocations(Box2DMemoryCategory::ROBOTS);
+    p_MicrasBodies.push_back(std::make_unique<Box2DMicrasBody>(
+        p_World->getWorldId(), b2Vec2((CELL_SIZE + WALL_THICKNESS) / 2.0f, MICRAS_HALFHEIGHT + WALL_THICKNESS),
+        // b2Vec2((CELL_SIZE + WALL_THICKNESS) / 2.0f, CELL_SIZE + WALL_THICKNESS / 2.0f),
+        b2Vec2(MICRAS_WIDTH, MICRAS_HEIGHT), b2_dynamicBody, MICRAS_MASS, MICRAS_FRICTION, MICRAS_RESTITUTION, this->collisionMode
+    ));
+
+    return p_MicrasBodies.size() - 1;
+}
+
+void Box2DPhysicsEngine::setCollisionMode(RobotCollisionMode collisionMode) {
+    this->collisionMode = collisionMode;
+    const auto allocationScope = p_World->scopeAllocations(Box2DMemoryCategory::ROBOTS);
+    for (auto& micras : p_MicrasBodies) {
+        micras->setCollisionMode(collisionMode);
     }
 }
 
 // Destructor to ensure proper cleanup
 Box2DPhysicsEngine::~Box2DPhysicsEngine() {
-    std::cout << "Box2DPhysicsEngine destructor called - destroying physics world" << std::endl;
-    // b2World_DumpMemoryStats(p_World->getWorldId());
-    p_Micras.reset();
-    p_Maze.reset();
+    // Destroying the world frees its blocks to the arena, which then returns its chunks. The bodies and walls forget
+    // their ids before, a destroyed world's slot may already hold another world and stale ids would reach its bodies.
+    for (auto& micras : p_MicrasBodies) {
+        micras->releaseBody();
+    }
+    p_Maze->release();
     p_World.reset();
+    p_MicrasBodies.clear();
+    p_Maze.reset();
 }
 }  // namespace micrasverse::physics
 #endif  // BOX2D_PHYSICS_ENGINE_CPP
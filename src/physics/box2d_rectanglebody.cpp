@@ -7,7 +7,7 @@ namespace micrasverse::physics {
 // Constructor
 RectangleBody::RectangleBody(
     const b2WorldId worldId, const b2Vec2 position, const b2Vec2 size, const b2BodyType type, const float mass, const float restitution,
-    const float friction
+    const float friction, const b2Filter filter
 ) {
     // Validate the world ID is valid
     if (!b2World_IsValid(worldId)) {
@@ -37,6 +37,9 @@ RectangleBody::RectangleBody(
     // Set density, friction and restitution
     shapeDef.density = (type == b2_staticBody) ? 0.0f : (mass / (size.x * size.y));
 
+    // Set which bodies this shape collides with
+    shapeDef.filter = filter;
+
     // Create polygon shape to the body
     this->shapeId = b2CreatePolygonShape(bodyId, &shapeDef, &boxShape);
 }
@@ -51,12 +54,39 @@ RectangleBody::~RectangleBody() {
     }
 }
 
+RectangleBody::RectangleBody(RectangleBody&& other) noexcept : bodyId(other.bodyId), shapeId(other.shapeId) {
+    other.bodyId = b2_nullBodyId;
+    other.shapeId = b2_nullShapeId;
+}
+
+RectangleBody& RectangleBody::operator=(RectangleBody&& other) noexcept {
+    if (this != &other) {
+        if (b2Shape_IsValid(this->shapeId)) {
+            b2DestroyShape(this->shapeId, true);
+        }
+        if (b2Body_IsValid(this->bodyId)) {
+            b2DestroyBody(this->bodyId);
+        }
+
+        this->bodyId = other.bodyId;
+        this->shapeId = other.shapeId;
+        other.bodyId = b2_nullBodyId;
+        other.shapeId = b2_nullShapeId;
+    }
+    return *this;
+}
+
+void RectangleBody::release() {
+    this->bodyId = b2_nullBodyId;
+    this->shapeId = b2_nullShapeId;
+}
+
 // Accessor for the Box2D body
 b2BodyId RectangleBody::getBodyId() const {
     return bodyId;
 }
 
-b2ShapeId RectangleBody::getShapeId() {
+b2ShapeId RectangleBody::getShapeId() const {
     return shapeId;
 }
 
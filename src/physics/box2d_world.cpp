@@ -1,32 +1,55 @@
 #include "physics/box2d_world.hpp"
 #include "constants.hpp"
+#include "micrasverse_core/profiler.hpp"
 #include <stdexcept>
 #include <iostream>
 #include <sstream>
 #include <cstring>  // For memcpy
+#include <mutex>
 
 namespace micrasverse::physics {
 
-// No need for world counting as we should only have one world
-std::atomic<bool> World::worldExists(false);
+namespace {
 
-World::World() {
-    // Check if a world already exists
-    if (worldExists.exchange(true)) {
-        std::cerr << "ERROR: Attempting to create a second world!" << std::endl;
-        throw std::runtime_error("A Box2D world already exists. Only one world should be created during simulation.");
+// b2CreateWorld and b2DestroyWorld claim and free slots of Box2D's global world array without any locking, and sweep
+// workers build and tear down worlds concurrently
+std::mutex worldLifetimeMutex;
+
+}  // namespace
+
+std::atomic<int> World::worldCount(0);
+
+World::World(std::shared_ptr<TaskScheduler> taskScheduler) : taskScheduler(std::move(taskScheduler)) {
+    // Batch runs keep several worlds alive, but Box2D only has a fixed number of world slots
+    if (worldCount.fetch_add(1) >= micrasverse::MAX_WORLDS) {
+        worldCount--;
+        std::cerr << "ERROR: Attempting to create more than " << micrasverse::MAX_WORLDS << " worlds!" << std::endl;
+        throw std::runtime_error("Too many Box2D worlds alive at the same time.");
     }
 
+    installBox2DAllocator();
+
     b2WorldDef worldDef = b2DefaultWorldDef();
     worldDef.gravity = micrasverse::GRAVITY;
+    worldDef.hitEventThreshold = micrasverse::WALL_HIT_SPEED;
     this->gravity = worldDef.gravity;
 
+    if (this->taskScheduler) {
+        this->taskScheduler->configureWorldDef(worldDef);
+    }
+
+    const std::lock_guard<std::mutex> lock(worldLifetimeMutex);
+    const Box2DArenaScope             allocationScope(this->arena, Box2DMemoryCategory::WORLD);
     this->worldId = b2CreateWorld(&worldDef);
 }
 
 World::~World() {
-    b2DestroyWorld(this->worldId);
-    worldExists = false;  // Reset the flag so a new world can be created if needed
+    // Box2D still frees its blocks one by one, but only back to the arena, which then hands its chunks to the heap
+    {
+        const std::lock_guard<std::mutex> lock(worldLifetimeMutex);
+        b2DestroyWorld(this->worldId);
+    }
+    worldCount--;
 }
 
 b2WorldId World::getWorldId() const {
@@ -35,6 +58,8 @@ b2WorldId World::getWorldId() const {
 
 void World::runStep(const float timeStep, const int subStepCount) {
     if (b2World_IsValid(this->worldId)) {
+        MICRASVERSE_PROFILE_ZONE("b2World_Step");
+        const Box2DArenaScope allocationScope(this->arena, Box2DMemoryCategory::STEP);
         b2World_Step(this->worldId, timeStep, subStepCount);
     } else {
         std::cerr << "WARNING: Attempting to step an invalid Box2D world, index: " << this->worldId.index1 << std::endl;
@@ -0,0 +1,191 @@
+#include "physics/grid_raycaster.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <utility>
+
+namespace micrasverse::physics {
+
+GridRaycaster::GridRaycaster(float cellSize) : cellSize(cellSize) { }
+
+void GridRaycaster::build(const std::vector<Maze::Element>& elements) {
+    this->boxes.clear();
+    this->cellStarts.clear();
+    this->cellBoxes.clear();
+    this->columns = 0;
+    this->rows = 0;
+
+    if (elements.empty()) {
+        return;
+    }
+
+    b2Vec2 lower{std::numeric_limits<float>::max(), std::numeric_limits<float>::max()};
+    b2Vec2 upper{std::numeric_limits<float>::lowest(), std::numeric_limits<float>::lowest()};
+
+    this->boxes.reserve(elements.size());
+    for (const auto& element : elements) {
+        const Box box{
+            {element.position.x - element.size.x / 2.0f, element.position.y - element.size.y / 2.0f},
+            {element.position.x + element.size.x / 2.0f, element.position.y + element.size.y / 2.0f},
+        };
+        lower = {std::min(lower.x, box.lower.x), std::min(lower.y, box.lower.y)};
+        upper = {std::max(upper.x, box.upper.x), std::max(upper.y, box.upper.y)};
+        this->boxes.push_back(box);
+    }
+
+    this->gridOrigin = lower;
+    this->columns = std::max(1, static_cast<int>(std::ceil((upper.x - lower.x) / this->cellSize)));
+    this->rows = std::max(1, static_cast<int>(std::ceil((upper.y - lower.y) / this->cellSize)));
+
+    const auto cellRange = [this](const Box& box, int& minColumn, int& maxColumn, int& minRow, int& maxRow) {
+        minColumn = std::clamp(static_cast<int>((box.lower.x - this->gridOrigin.x) / this->cellSize), 0, this->columns - 1);
+        maxColumn = std::clamp(static_cast<int>((box.upper.x - this->gridOrigin.x) / this->cellSize), 0, this->columns - 1);
+        minRow = std::clamp(static_cast<int>((box.lower.y - this->gridOrigin.y) / this->cellSize), 0, this->rows - 1);
+        maxRow = std::clamp(static_cast<int>((box.upper.y - this->gridOrigin.y) / this->cellSize), 0, this->rows - 1);
+    };
+
+    // Counting sort of the boxes into their cells
+    this->cellStarts.assign(static_cast<size_t>(this->columns) * this->rows + 1, 0);
+    for (const auto& box : this->boxes) {
+        int minColumn, maxColumn, minRow, maxRow;
+        cellRange(box, minColumn, maxColumn, minRow, maxRow);
+        for (int row = minRow; row <= maxRow; row++) {
+            for (int column = minColumn; column <= maxColumn; column++) {
+                this->cellStarts[row * this->columns + column + 1]++;
+            }
+        }
+    }
+
+    for (size_t i = 1; i < this->cellStarts.size(); i++) {
+        this->cellStarts[i] += this->cellStarts[i - 1];
+    }
+
+    this->cellBoxes.resize(this->cellStarts.back());
+    std::vector<uint32_t> cellFill(this->cellStarts.begin(), this->cellStarts.end() - 1);
+    for (uint32_t boxIndex = 0; boxIndex < this->boxes.size(); boxIndex++) {
+        int minColumn, maxColumn, minRow, maxRow;
+        cellRange(this->boxes[boxIndex], minColumn, maxColumn, minRow, maxRow);
+        for (int row = minRow; row <= maxRow; row++) {
+            for (int column = minColumn; column <= maxColumn; column++) {
+                this->cellBoxes[cellFill[row * this->columns + column]++] = boxIndex;
+            }
+        }
+    }
+}
+
+GridRaycaster::RayHit GridRaycaster::castRay(b2Vec2 origin, b2Vec2 translation) const {
+    RayHit result;
+
+    if (this->boxes.empty()) {
+        return result;
+    }
+
+    // Clip the ray to the grid bounds
+    const Box  gridBounds{this->gridOrigin, {this->gridOrigin.x + this->columns * this->cellSize, this->gridOrigin.y + this->rows * this->cellSize}};
+    const bool startsInside = origin.x >= gridBounds.lower.x && origin.x <= gridBounds.upper.x && origin.y >= gridBounds.lower.y &&
+                              origin.y <= gridBounds.upper.y;
+    float      enter = 0.0f;
+    if (!startsInside) {
+        enter = intersect(gridBounds, origin, translation);
+        if (enter < 0.0f) {
+            return result;
+        }
+    }
+
+    const b2Vec2 start{origin.x + enter * translation.x, origin.y + enter * translation.y};
+    int          column = std::clamp(static_cast<int>((start.x - this->gridOrigin.x) / this->cellSize), 0, this->columns - 1);
+    int          row = std::clamp(static_cast<int>((start.y - this->gridOrigin.y) / this->cellSize), 0, this->rows - 1);
+
+    constexpr float infinity = std::numeric_limits<float>::infinity();
+
+    const int   stepColumn = (translation.x > 0.0f) ? 1 : -1;
+    const int   stepRow = (translation.y > 0.0f) ? 1 : -1;
+    const float deltaColumn = (translation.x != 0.0f) ? this->cellSize / std::abs(translation.x) : infinity;
+    const float deltaRow = (translation.y != 0.0f) ? this->cellSize / std::abs(translation.y) : infinity;
+
+    // Ray fraction at which the next column / row boundary is crossed
+    float nextColumn = infinity;
+    float nextRow = infinity;
+    if (translation.x != 0.0f) {
+        const float boundary = this->gridOrigin.x + (column + (stepColumn > 0 ? 1 : 0)) * this->cellSize;
+        nextColumn = (boundary - origin.x) / translation.x;
+    }
+    if (translation.y != 0.0f) {
+        const float boundary = this->gridOrigin.y + (row + (stepRow > 0 ? 1 : 0)) * this->cellSize;
+        nextRow = (boundary - origin.y) / translation.y;
+    }
+
+    float closest = infinity;
+
+    while (true) {
+        const size_t cell = static_cast<size_t>(row) * this->columns + column;
+        for (uint32_t i = this->cellStarts[cell]; i < this->cellStarts[cell + 1]; i++) {
+            const float fraction = intersect(this->boxes[this->cellBoxes[i]], origin, translation);
+            if (fraction >= 0.0f && fraction < closest) {
+                closest = fraction;
+            }
+        }
+
+        // A hit inside the current cell can't be beaten by boxes further along the ray
+        const float cellExit = std::min(nextColumn, nextRow);
+        if (closest <= cellExit || cellExit > 1.0f) {
+            break;
+        }
+
+        if (nextColumn < nextRow) {
+            column += stepColumn;
+            nextColumn += deltaColumn;
+        } else {
+            row += stepRow;
+            nextRow += deltaRow;
+        }
+
+        if (column < 0 || column >= this->columns || row < 0 || row >= this->rows) {
+            break;
+        }
+    }
+
+    if (closest <= 1.0f) {
+        result.hit = true;
+        result.fraction = closest;
+    }
+
+    return result;
+}
+
+float GridRaycaster::intersect(const Box& box, b2Vec2 origin, b2Vec2 translation) {
+    float entry = std::numeric_limits<float>::lowest();
+    float exit = std::numeric_limits<float>::max();
+
+    const float origins[2] = {origin.x, origin.y};
+    const float directions[2] = {translation.x, translation.y};
+    const float lowers[2] = {box.lower.x, box.lower.y};
+    const float uppers[2] = {box.upper.x, box.upper.y};
+
+    for (int axis = 0; axis < 2; axis++) {
+        if (directions[axis] == 0.0f) {
+            if (origins[axis] < lowers[axis] || origins[axis] > uppers[axis]) {
+                return -1.0f;
+            }
+            continue;
+        }
+
+        float lowerFraction = (lowers[axis] - origins[axis]) / directions[axis];
+        float upperFraction = (uppers[axis] - origins[axis]) / directions[axis];
+        if (lowerFraction > upperFraction) {
+            std::swap(lowerFraction, upperFraction);
+        }
+        entry = std::max(entry, lowerFraction);
+        exit = std::min(exit, upperFraction);
+    }
+
+    // Misses, boxes behind the origin and boxes containing the origin all report no hit
+    if (entry > exit || entry < 0.0f || entry > 1.0f) {
+        return -1.0f;
+    }
+
+    return entry;
+}
+
+}  // namespace micrasverse::physics
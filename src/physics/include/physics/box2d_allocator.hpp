@@ -0,0 +1,93 @@
+#ifndef BOX2D_ALLOCATOR_HPP
+#define BOX2D_ALLOCATOR_HPP
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <vector>
+
+namespace micrasverse::physics {
+
+// What the world was doing when Box2D asked for memory, Box2D itself doesn't say what a block is for
+enum class Box2DMemoryCategory : uint8_t {
+    WORLD,   // world creation, broad phase and solver sets
+    MAZE,    // static wall bodies and shapes
+    ROBOTS,  // robot bodies, shapes and filter changes
+    STEP,    // contacts, islands and the stack arena grown while stepping
+    COUNT,
+};
+
+constexpr size_t BOX2D_MEMORY_CATEGORY_COUNT = static_cast<size_t>(Box2DMemoryCategory::COUNT);
+
+const char* getBox2DMemoryCategoryName(Box2DMemoryCategory category);
+
+struct Box2DMemoryStats {
+    std::array<uint64_t, BOX2D_MEMORY_CATEGORY_COUNT> bytesByCategory{};  // requested by Box2D and not freed yet
+    uint64_t                                          bytesInUse = 0;
+    uint64_t                                          peakBytesInUse = 0;
+    uint64_t                                          reservedBytes = 0;  // taken from the heap, with free blocks and size rounding
+    uint64_t                                          peakReservedBytes = 0;
+    uint64_t                                          allocations = 0;  // since creation
+};
+
+// Memory of one Box2D world. Freed blocks go to a free list per power of two size class and are reused by the same
+// world. b2DestroyWorld still frees every block one by one, but only to the free lists, the chunks go back to the heap
+// together when the arena is destroyed after its world.
+class Box2DArena {
+public:
+    Box2DArena() = default;
+    ~Box2DArena();
+
+    Box2DArena(const Box2DArena&) = delete;
+    Box2DArena& operator=(const Box2DArena&) = delete;
+
+    void* allocate(size_t size, Box2DMemoryCategory category);
+    void  deallocate(void* memory);
+
+    Box2DMemoryStats getStats() const;
+
+private:
+    static constexpr size_t SIZE_CLASS_COUNT = 64;
+
+    // Takes a block of a power of two size from the current chunk, or from a new one
+    std::byte* carve(size_t blockSize);
+    void       pushFreeBlock(std::byte* block, uint8_t sizeClass);
+
+    mutable std::mutex                       mutex;
+    std::array<std::byte*, SIZE_CLASS_COUNT> freeLists{};
+    std::vector<void*>                       chunks;
+    std::byte*                               cursor = nullptr;
+    std::byte*                               chunkEnd = nullptr;
+    Box2DMemoryStats                         stats;
+};
+
+// Sends the Box2D allocations of the calling thread to the arena until destroyed, nested scopes restore the outer one
+class Box2DArenaScope {
+public:
+    Box2DArenaScope(Box2DArena& arena, Box2DMemoryCategory category);
+    // A null arena sends the allocations to the global heap
+    Box2DArenaScope(Box2DArena* arena, Box2DMemoryCategory category);
+    ~Box2DArenaScope();
+
+    Box2DArenaScope(const Box2DArenaScope&) = delete;
+    Box2DArenaScope& operator=(const Box2DArenaScope&) = delete;
+
+    // Innermost scope of the calling thread, so work handed to another thread can allocate inside it too
+    static Box2DArena*         getCurrentArena();
+    static Box2DMemoryCategory getCurrentCategory();
+
+private:
+    Box2DArena*         previousArena;
+    Box2DMemoryCategory previousCategory;
+};
+
+// Replaces the Box2D allocator, has to run before the first world is created
+void installBox2DAllocator();
+
+// Allocations made outside of every arena scope, they are served by the global heap
+Box2DMemoryStats getUnscopedBox2DMemoryStats();
+
+}  // namespace micrasverse::physics
+
+#endif  // BOX2D_ALLOCATOR_HPP
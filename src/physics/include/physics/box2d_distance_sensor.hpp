@@ -2,14 +2,36 @@
 #define MICRASVERSE_PHYSICS_BOX2D_DISTANCE_SENSOR_HPP
 
 #include <array>
+#include <cstdint>
 
 #include "box2d/box2d.h"
 #include "micrasverse_core/types.hpp"
 
 namespace micrasverse::physics {
 
+// When a ray may keep its last result instead of being cast against the whole world again. Kept readings can lag a
+// full cast by up to the epsilons, well under the noise of the real sensors.
+struct RaycastCacheSettings {
+    bool  enabled = true;
+    float originEpsilon = 0.0001F;      // meters, below this the last fraction is reused as is
+    float directionEpsilon = 0.00001F;  // 1 - cos of the angle between the directions
+};
+
+struct RaycastCacheStats {
+    uint64_t reused = 0;  // rays that kept their last fraction
+    uint64_t cast = 0;    // rays cast against the whole world
+
+    uint64_t getHits() const { return reused; }
+
+    uint64_t getTotal() const { return reused + cast; }
+};
+
 class Box2DDistanceSensor {
 public:
+    // Extra rays spread around the sensor axis to model the emitter cone, and their weights in the averaged reading
+    static constexpr std::array<float, 4> RAY_ANGLE_OFFSETS{-B2_PI / 18.0F, -B2_PI / 36.0F, B2_PI / 18.0F, B2_PI / 36.0F};
+    static constexpr std::array<float, 4> RAY_WEIGHTS{0.8F, 0.97F, 0.8F, 0.97F};
+
     Box2DDistanceSensor(b2WorldId worldId, b2BodyId bodyId, const micrasverse::types::Vec2& localPosition, float angle, float maxDistance);
 
     micrasverse::types::Vec2 getLocalPosition() const;
@@ -20,6 +42,12 @@ public:
 
     void setDirection(const micrasverse::types::Vec2& direction);
 
+    // Select which shapes the rays can hit
+    void setQueryFilter(const b2QueryFilter& filter);
+
+    // Casts the rays in another world from the body that replaced the sensor's own
+    void attach(b2WorldId worldId, b2BodyId bodyId);
+
     micrasverse::types::Vec2 getRayDirection() const;
 
     void update();
@@ -32,9 +60,29 @@ public:
 
     b2Vec2 getVisualMidPoint() const { return this->visualMidPoint; }
 
+    void setCacheSettings(const RaycastCacheSettings& settings);
+
+    const RaycastCacheSettings& getCacheSettings() const { return this->cacheSettings; }
+
+    const RaycastCacheStats& getCacheStats() const { return this->cacheStats; }
+
+    // Forces the next update to cast every ray against the world, needed when static shapes were added or removed
+    void invalidateCache();
+
     // private:
+    // Last result of one ray, the center ray uses the last entry
+    struct CachedRay {
+        b2Vec2 origin;  // where the cached fraction was computed
+        b2Vec2 direction;
+        float  fraction;
+        bool   valid = false;
+    };
+
     void performRayCast();
 
+    // Fraction of the translation to the closest hit, as b2World_CastRayClosest reports it
+    float castRay(CachedRay& cache, b2Vec2 origin, b2Vec2 direction);
+
     b2WorldId             worldId;
     b2BodyId              bodyId;
     b2Vec2                localPosition;
@@ -49,6 +97,11 @@ public:
     b2Vec2                intersectionPoint;
     float                 visualReading;
     b2Vec2                visualMidPoint;
+    b2QueryFilter         queryFilter = b2DefaultQueryFilter();
+
+    std::array<CachedRay, 5> rayCache{};
+    RaycastCacheSettings     cacheSettings;
+    RaycastCacheStats        cacheStats;
 };
 
 }  // namespace micrasverse::physics
@@ -4,12 +4,19 @@
 #include "physics/box2d_rectanglebody.hpp"
 #include "box2d/box2d.h"
 
+#include <cstdint>
 #include <vector>
 #include <string>
-#include <memory>
 
 namespace micrasverse::physics {
 
+// Walls that changed between two loads of a maze
+struct MazeDelta {
+    size_t added = 0;
+    size_t removed = 0;
+    size_t kept = 0;
+};
+
 class Maze {
 private:
     b2WorldId worldId;  // Box2d world ID
@@ -21,9 +28,9 @@ public:
         b2Vec2 size;      // Size of the element
     };
 
-    std::vector<Element>                        elements;           // List of maze elements
-    std::vector<b2BodyId>                       mazeBodies;         // List of maze bodies
-    std::vector<std::unique_ptr<RectangleBody>> mazeBodiesObjects;  // List of maze bodies objects
+    std::vector<Element>       elements;           // List of maze elements
+    std::vector<b2BodyId>      mazeBodies;         // List of maze bodies
+    std::vector<RectangleBody> mazeBodiesObjects;  // List of maze bodies objects, stored inline in the order of elements
 
     // Constructor
     Maze(b2WorldId worldId, const std::string_view filename);
@@ -31,6 +38,9 @@ public:
     // Parse maze from file
     void loadFromFile(const std::string_view filename);
 
+    // Parse the maze elements of a file without creating any Box2D object
+    static std::vector<Element> parseFile(const std::string_view filename);
+
     const std::vector<Element>& getElements() const;
 
     b2WorldId getWorldId() const { return worldId; }
@@ -38,10 +48,22 @@ public:
     // Create Box2D objects
     void createBox2dObjects();
 
+    // Same type and position means the same wall, so a wall keeps its key across maze files
+    static uint64_t getElementKey(const Element& element);
+
     // Destroy Box2D objects
     void destroy();
 
+    // Drops the wall objects without destroying their bodies, which go away with the world
+    void release();
+
     void reloadFromFile(const std::string_view filename);
+
+    // Only destroys the bodies of walls the new file doesn't have and creates the ones it adds, the rest are kept
+    MazeDelta reloadIncrementally(const std::string_view filename);
+
+private:
+    RectangleBody createBody(const Element& element) const;
 };
 
 }  // namespace micrasverse::physics
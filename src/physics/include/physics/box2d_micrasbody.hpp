@@ -2,30 +2,46 @@
 #define BOX2D_MICRASBODY_HPP
 
 #include "box2d/box2d.h"
+#include "physics/box2d_distance_sensor.hpp"
+#include "physics/box2d_motor.hpp"
 #include "physics/box2d_rectanglebody.hpp"
+#include "physics/robot_body.hpp"
 
-#include <memory>
-#include <vector>
+#include <array>
+#include <cstdint>
+#include <optional>
 
 namespace micrasverse::physics {
 
-// Forward declarations for all component types used in this class
-class Box2DDistanceSensor;
-class Box2DMotor;
+// How robots sharing the same world see each other
+enum class RobotCollisionMode : uint8_t {
+    GHOST,        // robots pass through each other and their sensors only see the maze
+    INTERACTION,  // robots collide and their sensors see each other
+};
 
+// The components are stored inline with a layout fixed at compile time, so a step walks one contiguous object
+// instead of following a pointer per component
 class Box2DMicrasBody {
 private:
-    // Rectangle body to manage the Box2D body
-    std::unique_ptr<RectangleBody> rectBody;
-    b2BodyId                       bodyId;
-
-    // Size of the body
-    b2Vec2 size;
+    // Rectangle body to manage the Box2D body, replaced when the robot moves to another world
+    std::optional<RectangleBody> rectBody;
+    b2BodyId                     bodyId;
+
+    // Size and material of the body, kept to recreate it in another world
+    b2Vec2             size;
+    b2BodyType         type;
+    float              density;
+    float              friction;
+    float              restitution;
+    RobotCollisionMode collisionMode;
 
     // Physical components
-    std::vector<std::unique_ptr<Box2DDistanceSensor>> distanceSensors;
-    std::unique_ptr<Box2DMotor>                       leftMotor;
-    std::unique_ptr<Box2DMotor>                       rightMotor;
+    std::array<Box2DDistanceSensor, DISTANCE_SENSOR_COUNT> distanceSensors;
+    Box2DMotor                                             leftMotor;
+    Box2DMotor                                             rightMotor;
+
+    // State shared with the firmware proxies
+    RobotBody robotBody;
 
     // Acceleration and velocity tracking
     float  linearSpeed = 0.0f;
@@ -44,17 +60,40 @@ public:
     float getLinearSpeed() const { return linearSpeed; }
 
     // Constructor
-    Box2DMicrasBody(b2WorldId worldId, b2Vec2 position, b2Vec2 size, b2BodyType type, float density, float friction, float restitution);
+    Box2DMicrasBody(
+        b2WorldId worldId, b2Vec2 position, b2Vec2 size, b2BodyType type, float density, float friction, float restitution,
+        RobotCollisionMode collisionMode = RobotCollisionMode::GHOST
+    );
 
-    // Destructor
-    ~Box2DMicrasBody();
+    // The sensors and motors hold the id of the body, a copy would share it
+    Box2DMicrasBody(const Box2DMicrasBody&) = delete;
+    Box2DMicrasBody& operator=(const Box2DMicrasBody&) = delete;
 
     // Get the body ID
     b2BodyId getBodyId() const { return bodyId; }
 
-    // Update the body
+    b2ShapeId getShapeId() const { return rectBody->getShapeId(); }
+
+    // Set whether this body collides with and senses other robots
+    void setCollisionMode(RobotCollisionMode collisionMode);
+
+    // Clears the motors, the velocity tracking and the commands of the robot body, the pose is left to the caller
+    void resetState();
+
+    // Recreates the body in another world with the same pose and velocity, the robot body and the motor state are kept
+    void moveToWorld(b2WorldId worldId);
+
+    // Forgets the body without any Box2D call, its world is about to be destroyed
+    void releaseBody();
+
+    // Update the body, applying the commands last written to the robot body
     void update(float deltaTime);
 
+    // Copy the current pose and sensor readings to the robot body
+    void publishState();
+
+    RobotBody& getRobotBody() { return robotBody; }
+
     // Process input
     void processInput(float deltaTime);
 
@@ -77,13 +116,21 @@ public:
     b2Vec2 getLinearVelocity() const { return linearVelocity; }
 
     // Getters for physical components
-    Box2DDistanceSensor& getDistanceSensor(size_t index) { return *distanceSensors[index]; }
+    Box2DDistanceSensor& getDistanceSensor(size_t index) { return distanceSensors[index]; }
+
+    std::array<Box2DDistanceSensor, DISTANCE_SENSOR_COUNT>& getDistanceSensors() { return distanceSensors; }
+
+    static constexpr size_t getDistanceSensorCount() { return DISTANCE_SENSOR_COUNT; }
+
+    // Applies the same raycast cache tolerances to every distance sensor
+    void setRaycastCacheSettings(const RaycastCacheSettings& settings);
 
-    size_t getDistanceSensorCount() const { return distanceSensors.size(); }
+    // Raycast cache counters summed over every distance sensor
+    RaycastCacheStats getRaycastCacheStats() const;
 
-    Box2DMotor& getLeftMotor() { return *leftMotor; }
+    Box2DMotor& getLeftMotor() { return leftMotor; }
 
-    Box2DMotor& getRightMotor() { return *rightMotor; }
+    Box2DMotor& getRightMotor() { return rightMotor; }
 };
 }  // namespace micrasverse::physics
 
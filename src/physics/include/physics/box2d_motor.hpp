@@ -43,6 +43,12 @@ public:
 
     bool getFanState() const { return isFanOn; }
 
+    // Stops the rotor and clears the command, current and forces, as when the robot is placed back at the start
+    void reset();
+
+    // Moves the motor to the body that replaced its own, the motor state is kept
+    void setBodyId(b2BodyId bodyId) { this->bodyId = bodyId; }
+
     bool isFanOn{false};  // Is the fan on?
 
 private:
@@ -4,34 +4,86 @@
 #include "physics/box2d_world.hpp"
 #include "physics/box2d_maze.hpp"
 #include "physics/box2d_micrasbody.hpp"
+#include "physics/physics_backend.hpp"
+#include <cstdint>
 #include <memory>
 #include <string>
 #include <string_view>
+#include <vector>
 #include "constants.hpp"
 
 namespace micrasverse::physics {
 
+enum class MazeReloadMode : uint8_t {
+    FULL,         // builds the maze in a new world and destroys the old one whole
+    INCREMENTAL,  // keeps the world and only replaces the walls that changed
+};
+
+struct MazeReload {
+    MazeReloadMode mode = MazeReloadMode::FULL;
+    MazeDelta      delta;
+    double         milliseconds = 0.0;
+};
+
 class Box2DPhysicsEngine {
 public:
-    Box2DPhysicsEngine(const std::string_view mazePath = DEFAULT_MAZE_PATH);
+    // A null task scheduler steps the world serially on the calling thread
+    Box2DPhysicsEngine(
+        const std::string_view mazePath = DEFAULT_MAZE_PATH, size_t micrasCount = 1, RobotCollisionMode collisionMode = RobotCollisionMode::GHOST,
+        std::shared_ptr<TaskScheduler> taskScheduler = TaskScheduler::getShared()
+    );
     ~Box2DPhysicsEngine();
 
+    // Updates every body and then steps the world once for all of them
     void update(float step = STEP);
     void loadMaze(const std::string_view mazePath);
+
+    // Puts robots back in the start cell at rest, with their motors and commands cleared
     void resetMicrasPosition();
+    void resetMicrasPosition(size_t index);
+
+    // Adds a new body at the start cell and returns its index. Every robot spawns at the same pose, since each firmware
+    // starts its pose estimate there. Ghost robots share it harmlessly. Interacting robots overlap until the caller moves
+    // them, otherwise the solver pushes them apart on the first step.
+    size_t addMicras();
+
+    void               setCollisionMode(RobotCollisionMode collisionMode);
+    RobotCollisionMode getCollisionMode() const { return collisionMode; }
+
+    void           setMazeReloadMode(MazeReloadMode mazeReloadMode) { this->mazeReloadMode = mazeReloadMode; }
+    MazeReloadMode getMazeReloadMode() const { return mazeReloadMode; }
+
+    // What the last loadMaze changed and how long it took
+    const MazeReload& getLastMazeReload() const { return lastMazeReload; }
 
     World& getWorld() { return *p_World; }
 
     Maze& getMaze() { return *p_Maze; }
 
-    Box2DMicrasBody& getMicras() { return *p_Micras; }
+    Box2DMicrasBody& getMicras(size_t index = 0) { return *p_MicrasBodies[index]; }
+
+    size_t getMicrasCount() const { return p_MicrasBodies.size(); }
+
+    RobotBody& getRobotBody(size_t index = 0) { return p_MicrasBodies[index]->getRobotBody(); }
+
+    size_t getRobotCount() const { return p_MicrasBodies.size(); }
 
 private:
-    std::unique_ptr<World>           p_World;
-    std::unique_ptr<Maze>            p_Maze;
-    std::unique_ptr<Box2DMicrasBody> p_Micras;
+    std::unique_ptr<World>                        p_World;
+    std::unique_ptr<Maze>                         p_Maze;
+    std::vector<std::unique_ptr<Box2DMicrasBody>> p_MicrasBodies;
+    RobotCollisionMode                            collisionMode;
+    MazeReloadMode                                mazeReloadMode = MazeReloadMode::INCREMENTAL;
+    MazeReload                                    lastMazeReload;
+
+    MazeDelta rebuildWorld(const std::string_view mazePath);
+
+    // Adds the robot and maze touches that began during the last step to the robot bodies
+    void countWallCollisions();
 };
 
+static_assert(PhysicsBackend<Box2DPhysicsEngine>);
+
 }  // namespace micrasverse::physics
 
 #endif  // MICRASVERSE_PHYSICS_BOX2D_PHYSICS_ENGINE_HPP
@@ -16,16 +16,25 @@ public:
     // Constructor
     RectangleBody(
         const b2WorldId worldId, const b2Vec2 position, const b2Vec2 size, const b2BodyType type, const float mass, const float restitution = 0.0f,
-        const float friction = 0.0f
+        const float friction = 0.0f, const b2Filter filter = b2DefaultFilter()
     );
 
     // Destructor
     virtual ~RectangleBody();
 
+    // Owns its Box2D body, a moved-from rectangle holds null ids and destroys nothing
+    RectangleBody(const RectangleBody&) = delete;
+    RectangleBody& operator=(const RectangleBody&) = delete;
+    RectangleBody(RectangleBody&& other) noexcept;
+    RectangleBody& operator=(RectangleBody&& other) noexcept;
+
+    // Forgets the body without any Box2D call, for when its world is about to be destroyed with everything in it
+    void release();
+
     // Accessor for the Box2D body
     b2BodyId getBodyId() const;
 
-    b2ShapeId getShapeId();
+    b2ShapeId getShapeId() const;
 
     // Optional: Add methods to modify the body
     void setPose(const b2Vec2& position, const b2Rot& rotation);
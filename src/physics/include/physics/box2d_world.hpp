@@ -2,29 +2,44 @@
 #define WORLD_HPP
 
 #include "box2d/box2d.h"
+#include "physics/box2d_allocator.hpp"
+#include "physics/task_scheduler.hpp"
 #include <stdexcept>
 #include <atomic>
+#include <memory>
 #include <string>
 
 namespace micrasverse::physics {
 
 class World {
 private:
-    b2WorldId worldId;
-    b2Vec2    gravity;
+    b2WorldId                      worldId;
+    b2Vec2                         gravity;
+    std::shared_ptr<TaskScheduler> taskScheduler;
+    Box2DArena                     arena;  // every block of the world, its chunks are released after it is destroyed
 
-    // Flag to ensure only one world exists at a time
-    static std::atomic<bool> worldExists;
+    // Number of live worlds, Box2D supports a limited amount of them at the same time
+    static std::atomic<int> worldCount;
 
 public:
-    explicit World();
+    // A null task scheduler steps the world serially on the calling thread
+    explicit World(std::shared_ptr<TaskScheduler> taskScheduler = TaskScheduler::getShared());
     ~World();
 
     b2WorldId getWorldId() const;
     void      runStep(const float timeStep, const int subStepCount);
 
+    TaskScheduler* getTaskScheduler() const { return this->taskScheduler.get(); }
+
+    const std::shared_ptr<TaskScheduler>& getSharedTaskScheduler() const { return this->taskScheduler; }
+
+    Box2DMemoryStats getMemoryStats() const { return this->arena.getStats(); }
+
+    // Box2D calls that create or change bodies of this world should allocate inside this scope
+    Box2DArenaScope scopeAllocations(Box2DMemoryCategory category) { return Box2DArenaScope(this->arena, category); }
+
     // Check if a world already exists
-    static bool hasExistingWorld() { return worldExists; }
+    static bool hasExistingWorld() { return worldCount > 0; }
 };
 
 }  // namespace micrasverse::physics
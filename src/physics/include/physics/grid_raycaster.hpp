@@ -0,0 +1,53 @@
+#ifndef MICRASVERSE_PHYSICS_GRID_RAYCASTER_HPP
+#define MICRASVERSE_PHYSICS_GRID_RAYCASTER_HPP
+
+#include "physics/box2d_maze.hpp"
+#include "box2d/box2d.h"
+#include "constants.hpp"
+
+#include <cstdint>
+#include <vector>
+
+namespace micrasverse::physics {
+
+// Ray casts against the static maze without a Box2D world. Every maze element is an axis aligned box, binned in a
+// uniform grid, and rays walk the grid cells in order (DDA) so only the walls around the ray are tested.
+class GridRaycaster {
+public:
+    struct RayHit {
+        bool  hit = false;
+        float fraction = 0.0f;  // fraction of the translation where the ray hits, same meaning as b2RayResult
+    };
+
+    explicit GridRaycaster(float cellSize = CELL_SIZE / 2.0f);
+
+    // Rebuilds the grid from a new set of maze elements
+    void build(const std::vector<Maze::Element>& elements);
+
+    // Closest hit along origin + t * translation, t in [0, 1]. Boxes containing the origin are ignored.
+    RayHit castRay(b2Vec2 origin, b2Vec2 translation) const;
+
+    size_t getBoxCount() const { return boxes.size(); }
+
+private:
+    struct Box {
+        b2Vec2 lower;
+        b2Vec2 upper;
+    };
+
+    // Entry fraction of the ray in the box, or a negative value when it misses
+    static float intersect(const Box& box, b2Vec2 origin, b2Vec2 translation);
+
+    float  cellSize;
+    b2Vec2 gridOrigin{0.0f, 0.0f};
+    int    columns{0};
+    int    rows{0};
+
+    std::vector<Box>      boxes;
+    std::vector<uint32_t> cellStarts;  // boxes of cell i are cellBoxes[cellStarts[i]..cellStarts[i + 1])
+    std::vector<uint32_t> cellBoxes;
+};
+
+}  // namespace micrasverse::physics
+
+#endif  // MICRASVERSE_PHYSICS_GRID_RAYCASTER_HPP
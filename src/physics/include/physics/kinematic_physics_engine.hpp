@@ -0,0 +1,74 @@
+#ifndef MICRASVERSE_PHYSICS_KINEMATIC_PHYSICS_ENGINE_HPP
+#define MICRASVERSE_PHYSICS_KINEMATIC_PHYSICS_ENGINE_HPP
+
+#include "physics/box2d_maze.hpp"
+#include "physics/grid_raycaster.hpp"
+#include "physics/motor_model.hpp"
+#include "physics/physics_backend.hpp"
+#include "physics/robot_body.hpp"
+#include "constants.hpp"
+
+#include <deque>
+#include <string_view>
+#include <vector>
+
+namespace micrasverse::physics {
+
+// Lightweight backend for large batches of robots on a static maze, without a Box2D world.
+// Robots are rigid boxes driven by the same motor equations as Box2DMotor, with no lateral slip and no robot-robot
+// contact. Their state lives in structure-of-arrays form so the motor and velocity update runs in SIMD packs; pose
+// integration, wall collision and the distance sensors use the grid raycaster one robot at a time.
+// Touching a wall stops the robot instead of sliding along it.
+class KinematicPhysicsEngine {
+public:
+    explicit KinematicPhysicsEngine(const std::string_view mazePath = DEFAULT_MAZE_PATH, size_t micrasCount = 1);
+
+    // Reads the commands of every robot body, advances all robots and publishes their new state
+    void update(float step = STEP);
+    void loadMaze(const std::string_view mazePath);
+    void resetMicrasPosition();
+    void resetMicrasPosition(size_t index);
+
+    // Adds a new robot at the start cell and returns its index, every robot spawns at the same pose
+    size_t addMicras();
+
+    const std::vector<Maze::Element>& getMazeElements() const { return mazeElements; }
+
+    const GridRaycaster& getRaycaster() const { return raycaster; }
+
+    RobotBody& getRobotBody(size_t index = 0) { return robotBodies[index]; }
+
+    size_t getRobotCount() const { return robotBodies.size(); }
+
+private:
+    // One entry per robot, padded with idle robots up to a whole number of SIMD packs
+    struct RobotArrays {
+        std::vector<float> positionX;
+        std::vector<float> positionY;
+        std::vector<float> angle;
+        std::vector<float> linearSpeed;  // along the robot heading
+        std::vector<float> angularVelocity;
+        std::vector<float> leftCommand;
+        std::vector<float> rightCommand;
+        std::vector<float> fanEffect;
+    };
+
+    void   resizeArrays();
+    void   updateVelocities(size_t first, float deltaTime);
+    void   integratePose(size_t index, float deltaTime);
+    void   updateDistanceSensors(size_t index);
+    void   publishState(size_t index);
+    b2Vec2 getWorldPoint(size_t index, const types::Vec2& localPoint) const;
+
+    std::vector<Maze::Element> mazeElements;
+    GridRaycaster              raycaster;
+    MotorParameters            motorParameters;
+    RobotArrays                arrays;
+    std::deque<RobotBody>      robotBodies;  // deque so the proxies' pointers survive addMicras
+};
+
+static_assert(PhysicsBackend<KinematicPhysicsEngine>);
+
+}  // namespace micrasverse::physics
+
+#endif  // MICRASVERSE_PHYSICS_KINEMATIC_PHYSICS_ENGINE_HPP
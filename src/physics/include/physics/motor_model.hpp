@@ -0,0 +1,68 @@
+#ifndef MICRASVERSE_PHYSICS_MOTOR_MODEL_HPP
+#define MICRASVERSE_PHYSICS_MOTOR_MODEL_HPP
+
+#include "constants.hpp"
+#include "micrasverse_core/simd.hpp"
+
+namespace micrasverse::physics {
+
+struct MotorParameters {
+    float resistance = MOTOR_RESISTANCE;                 // Motor resistance (R)
+    float ke = MOTOR_KE;                                 // Back EMF constant
+    float kt = MOTOR_KT;                                 // Torque constant
+    float maxCommandVoltage = MOTOR_MAX_COMMAND_VOLTAGE;  // Maximum input voltage
+};
+
+template <typename T>
+struct MotorOutput {
+    T rotorAngularVelocity;  // Angular velocity of the rotor
+    T current;               // Current through the motor
+    T torque;                // Torque generated by the motor
+    T appliedForce;          // Force applied at the wheel, limited by friction
+};
+
+// DC motor and wheel equations shared by Box2DMotor and the kinematic backend.
+// T is either float or simd::FloatPack, so the body has to stay branch free.
+template <typename T>
+inline MotorOutput<T> computeMotorOutput(
+    const T& command, const T& bodyLinearVelocity, const T& bodyAngularVelocity, const T& fanEffect, float angularVelocitySign,
+    const MotorParameters& parameters
+) {
+    MotorOutput<T> output;
+
+    // Calculate input voltage based on the command
+    const T inputVoltage = parameters.maxCommandVoltage * (command / 100.0f);
+
+    // Compute back EMF
+    const T wheelAngularVelocity = (bodyLinearVelocity + angularVelocitySign * MICRAS_TRACK_WIDTH / 2.0f * bodyAngularVelocity) / MICRAS_WHEEL_RADIUS;
+
+    output.rotorAngularVelocity = wheelAngularVelocity * MICRAS_GEAR_RATIO;
+
+    const T backEMF = parameters.ke * output.rotorAngularVelocity;
+
+    // Compute current through the motor
+    output.current = (inputVoltage - backEMF) / parameters.resistance;
+
+    // Compute torque
+    output.torque = parameters.kt * output.current;
+
+    // Compute force applied at each wheel
+    const T force = (output.torque * MICRAS_GEAR_RATIO) / MICRAS_WHEEL_RADIUS;
+
+    // Compute maximum frictional force
+    const T maxFrictionForce = fanEffect * MICRAS_FRICTION * MICRAS_MASS * 9.81f;
+
+    // Apply the smaller of motor force and friction force
+    output.appliedForce = simd::min(simd::max(force, -maxFrictionForce), maxFrictionForce);
+
+    return output;
+}
+
+// Grip multiplier of the fan pressing the robot against the floor
+inline float getFanEffect(bool isFanOn) {
+    return isFanOn ? 5.0f : 1.0f;
+}
+
+}  // namespace micrasverse::physics
+
+#endif  // MICRASVERSE_PHYSICS_MOTOR_MODEL_HPP
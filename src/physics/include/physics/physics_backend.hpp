@@ -0,0 +1,28 @@
+#ifndef MICRASVERSE_PHYSICS_PHYSICS_BACKEND_HPP
+#define MICRASVERSE_PHYSICS_PHYSICS_BACKEND_HPP
+
+#include "physics/robot_body.hpp"
+
+#include <concepts>
+#include <cstddef>
+#include <string_view>
+
+namespace micrasverse::physics {
+
+// Interface every physics engine offers to the simulation. Engines are plugged in as template parameters instead of
+// through virtual calls, so stepping is resolved at compile time, and the firmware proxies only touch the RobotBody
+// state blocks, which are plain structs.
+template <typename Engine>
+concept PhysicsBackend = requires(Engine engine, const Engine constEngine, float step, std::string_view mazePath, size_t index) {
+    { engine.update(step) } -> std::same_as<void>;
+    { engine.loadMaze(mazePath) } -> std::same_as<void>;
+    { engine.resetMicrasPosition() } -> std::same_as<void>;
+    { engine.resetMicrasPosition(index) } -> std::same_as<void>;
+    { engine.addMicras() } -> std::same_as<size_t>;
+    { engine.getRobotBody(index) } -> std::same_as<RobotBody&>;
+    { constEngine.getRobotCount() } -> std::same_as<size_t>;
+};
+
+}  // namespace micrasverse::physics
+
+#endif  // MICRASVERSE_PHYSICS_PHYSICS_BACKEND_HPP
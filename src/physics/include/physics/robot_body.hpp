@@ -0,0 +1,68 @@
+#ifndef MICRASVERSE_PHYSICS_ROBOT_BODY_HPP
+#define MICRASVERSE_PHYSICS_ROBOT_BODY_HPP
+
+#include "constants.hpp"
+#include "micrasverse_core/types.hpp"
+
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+
+namespace micrasverse::physics {
+
+constexpr size_t DISTANCE_SENSOR_COUNT = 4;
+
+// Where each distance sensor sits on the body and where it points, in body coordinates
+struct DistanceSensorMount {
+    float       angle;
+    types::Vec2 localPosition;
+};
+
+// Known at compile time so the robots store their sensors inline and the per-step sensor loops have a fixed count
+constexpr std::array<DistanceSensorMount, DISTANCE_SENSOR_COUNT> DISTANCE_SENSOR_MOUNTS{{
+    {B2_PI / 2.0f, {-MICRAS_HALFWIDTH, MICRAS_HALFHEIGHT}},
+    {5.0f * B2_PI / 6.0f, {-MICRAS_HALFWIDTH / 2, MICRAS_HALFHEIGHT}},
+    {B2_PI / 6.0f, {MICRAS_HALFWIDTH / 2, MICRAS_HALFHEIGHT}},
+    {B2_PI / 2.0f, {MICRAS_HALFWIDTH, MICRAS_HALFHEIGHT}},
+}};
+
+// Proxy readings of one step. The sampling phase computes them once before the firmware runs, so the firmware, the UI
+// and the telemetry all read the same values no matter how many of them ask.
+struct SensorSample {
+    std::array<float, DISTANCE_SENSOR_COUNT> wallSensorAdcReadings{};   // 0 to the maximum reading of the wall sensors
+    float                                    leftRotaryPosition{0.0f};  // radians integrated by the left rotary sensor
+    float                                    rightRotaryPosition{0.0f};
+};
+
+// Backend independent state of one robot, shared between a physics engine and the firmware proxies.
+// The engine publishes the pose and sensor readings after every step and consumes the motor and fan commands
+// on the next one, so the proxies never talk to the physics library directly.
+struct RobotBody {
+    // Published by the physics engine
+    types::Vec2                              position;               // meters
+    float                                    angle{0.0f};            // radians, the robot faces +y at zero
+    types::Vec2                              linearVelocity;         // meters/second
+    float                                    angularVelocity{0.0f};  // radians/second
+    types::Vec2                              leftWheelPosition;      // meters
+    types::Vec2                              rightWheelPosition;     // meters
+    std::array<float, DISTANCE_SENSOR_COUNT> distanceReadings{};     // meters
+    bool                                     isTouchingWall{false};  // in contact with the maze, not with other robots
+    uint32_t                                 wallCollisions{0};      // impacts with the maze faster than WALL_HIT_SPEED since the last reset
+    double                                   simulatedTime{0.0};     // seconds stepped so far, the clock of the proxy stopwatches
+
+    // Written by the proxies
+    float leftCommand{0.0f};   // -100 to +100
+    float rightCommand{0.0f};  // -100 to +100
+    bool  isFanOn{false};
+
+    // Written by the sampling phase, read by every proxy getter
+    SensorSample sensorSample;
+
+    // Unit vector the robot is facing
+    types::Vec2 getForwardDirection() const { return {-std::sin(angle), std::cos(angle)}; }
+};
+
+}  // namespace micrasverse::physics
+
+#endif  // MICRASVERSE_PHYSICS_ROBOT_BODY_HPP
@@ -0,0 +1,100 @@
+#ifndef TASK_SCHEDULER_HPP
+#define TASK_SCHEDULER_HPP
+
+#include "box2d/box2d.h"
+#include "physics/box2d_allocator.hpp"
+
+#include <array>
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace micrasverse::physics {
+
+// Work-stealing thread pool plugged into Box2D's task system (b2WorldDef::enqueueTask / finishTask).
+// Every worker owns a bounded deque: it pops its own work from the back and steals from the front of the others.
+// The thread that calls b2World_Step always runs as worker 0 and helps with its own tasks while waiting on them,
+// which lets the same pool be shared by several worlds stepping at once (batch runs).
+class TaskScheduler {
+public:
+    static constexpr int MAX_WORKERS = 64;  // Box2D's B2_MAX_WORKERS
+    static constexpr int MAX_TASKS = 128;   // concurrent tasks across every world using the pool
+    static constexpr int QUEUE_CAPACITY = 256;
+
+    // workerCount includes the calling thread, so workerCount - 1 threads are spawned. 0 = hardware concurrency.
+    explicit TaskScheduler(int workerCount = 0);
+    ~TaskScheduler();
+
+    TaskScheduler(const TaskScheduler&) = delete;
+    TaskScheduler& operator=(const TaskScheduler&) = delete;
+
+    int getWorkerCount() const { return this->workerCount; }
+
+    // Fills the task system fields of a world definition so the world runs on this pool
+    void configureWorldDef(b2WorldDef& worldDef);
+
+    // Runs body(index) for every index in [0, count) on the pool and waits for completion
+    void parallelFor(int count, const std::function<void(int)>& body);
+
+    // Pool shared by every world (and batch runner) in the process, created on first use
+    static std::shared_ptr<TaskScheduler> getShared();
+    // Sets the worker count used when the shared pool is created; ignored once it exists
+    static void setSharedWorkerCount(int workerCount);
+
+private:
+    struct Task {
+        b2TaskCallback*     callback = nullptr;
+        void*               context = nullptr;
+        Box2DArena*         arena = nullptr;  // allocation scope of the submitting thread, restored on every worker
+        Box2DMemoryCategory category = Box2DMemoryCategory::WORLD;
+        std::atomic<int>    pendingRanges{0};
+        std::atomic<bool>   inUse{false};
+    };
+
+    struct Range {
+        Task* task;
+        int   start;
+        int   end;
+    };
+
+    struct WorkerQueue {
+        std::mutex                        mutex;
+        std::array<Range, QUEUE_CAPACITY> ranges;
+        int                               head = 0;
+        int                               count = 0;
+
+        bool pushBack(const Range& range);
+        bool popBack(Range& range);
+        bool popFront(Range& range);
+        bool takeTask(const Task* task, Range& range);
+    };
+
+    static void* enqueueTask(b2TaskCallback* callback, int itemCount, int minRange, void* taskContext, void* userContext);
+    static void  finishTask(void* userTask, void* userContext);
+
+    Task* acquireTask();
+    void  submit(Task* task, int itemCount, int rangeCount);
+    void  wait(Task* task);
+    void  execute(const Range& range);
+    bool  findWork(int workerIndex, Range& range);
+    void  workerLoop(int workerIndex);
+
+    int                                  workerCount;
+    std::vector<std::thread>             threads;
+    std::array<WorkerQueue, MAX_WORKERS> queues;
+    std::array<Task, MAX_TASKS>          tasks;
+    std::atomic<int>                     queuedRanges{0};
+    std::atomic<uint32_t>                nextQueue{0};
+    std::atomic<bool>                    running{true};
+    std::mutex                           sleepMutex;
+    std::condition_variable              sleepCondition;
+};
+
+}  // namespace micrasverse::physics
+
+#endif  // TASK_SCHEDULER_HPP
@@ -0,0 +1,94 @@
+#ifndef WORLD_POOL_HPP
+#define WORLD_POOL_HPP
+
+#include "physics/box2d_physics_engine.hpp"
+#include "constants.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace micrasverse::physics {
+
+// Physics engines kept alive between batch runs, keyed by the content of their maze file. Taking the engine of a maze
+// that was already run only resets its robots, so the setup of a run doesn't depend on how many walls the maze has.
+// Box2D keeps its broad phase and contact caches, runs on a reused world are not bit identical to runs on a new one.
+class WorldPool {
+public:
+    // Hands the engine back to the pool when destroyed
+    class Lease {
+    public:
+        Lease(Lease&& other) noexcept = default;
+        Lease& operator=(Lease&& other) noexcept;
+        ~Lease();
+
+        Box2DPhysicsEngine& operator*() const { return *engine; }
+
+        Box2DPhysicsEngine* operator->() const { return engine.get(); }
+
+        // False when the engine was built for this lease
+        bool isReused() const { return reused; }
+
+    private:
+        friend class WorldPool;
+
+        Lease(WorldPool& pool, uint64_t mazeHash, std::unique_ptr<Box2DPhysicsEngine> engine, bool reused);
+
+        WorldPool*                          pool;
+        uint64_t                            mazeHash;
+        std::unique_ptr<Box2DPhysicsEngine> engine;
+        bool                                reused;
+    };
+
+    struct Stats {
+        uint64_t reused = 0;   // leases served by an idle engine
+        uint64_t built = 0;    // leases that had to build their engine
+        uint64_t evicted = 0;  // idle engines destroyed to stay under the limit
+        size_t   idle = 0;
+    };
+
+    // Engines are stepped serially on the thread holding the lease. Idle and leased engines together must stay under
+    // MAX_WORLDS, so the idle limit leaves room for one lease per worker thread.
+    explicit WorldPool(
+        size_t robotCount = 1, RobotCollisionMode collisionMode = RobotCollisionMode::GHOST, size_t maxIdleWorlds = MAX_WORLDS / 2
+    );
+
+    // Safe to call from several threads, every lease gets an engine of its own
+    Lease acquire(std::string_view mazePath);
+
+    Stats getStats() const;
+
+    // FNV-1a of the file content, so copies and renames of a maze share their worlds
+    static uint64_t hashMazeFile(std::string_view mazePath);
+
+private:
+    struct IdleWorld {
+        uint64_t                            mazeHash;
+        uint64_t                            lastUse;
+        std::unique_ptr<Box2DPhysicsEngine> engine;
+    };
+
+    // Hashes each maze file once, a sweep acquires the same few mazes for every run
+    uint64_t getMazeHash(std::string_view mazePath);
+
+    void release(uint64_t mazeHash, std::unique_ptr<Box2DPhysicsEngine> engine);
+
+    size_t             robotCount;
+    RobotCollisionMode collisionMode;
+    size_t             maxIdleWorlds;
+
+    mutable std::mutex                        mutex;
+    std::vector<IdleWorld>                    idleWorlds;
+    std::unordered_map<std::string, uint64_t> mazeHashes;
+    uint64_t                                  useCounter = 0;
+    Stats                                     stats;
+};
+
+}  // namespace micrasverse::physics
+
+#endif  // WORLD_POOL_HPP
@@ -0,0 +1,222 @@
+#include "physics/kinematic_physics_engine.hpp"
+#include "physics/box2d_distance_sensor.hpp"
+#include "micrasverse_core/profiler.hpp"
+#include "micrasverse_core/simd.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+
+namespace micrasverse::physics {
+
+namespace {
+
+// Moment of inertia of the robot box around its center
+constexpr float MICRAS_INERTIA = MICRAS_MASS * (MICRAS_WIDTH * MICRAS_WIDTH + MICRAS_HEIGHT * MICRAS_HEIGHT) / 12.0f;
+
+// Share of the move kept when a wall is hit, so the body stops just short of the wall
+constexpr float CONTACT_SKIN = 0.99f;
+
+const std::array<types::Vec2, 4> BODY_CORNERS{{
+    {-MICRAS_HALFWIDTH, -MICRAS_HALFHEIGHT},
+    {MICRAS_HALFWIDTH, -MICRAS_HALFHEIGHT},
+    {MICRAS_HALFWIDTH, MICRAS_HALFHEIGHT},
+    {-MICRAS_HALFWIDTH, MICRAS_HALFHEIGHT},
+}};
+
+b2Vec2 transformPoint(float x, float y, float angle, const types::Vec2& localPoint) {
+    const float c = std::cos(angle);
+    const float s = std::sin(angle);
+    return {x + c * localPoint.x - s * localPoint.y, y + s * localPoint.x + c * localPoint.y};
+}
+
+}  // namespace
+
+KinematicPhysicsEngine::KinematicPhysicsEngine(const std::string_view mazePath, size_t micrasCount) {
+    this->mazeElements = Maze::parseFile(mazePath);
+    this->raycaster.build(this->mazeElements);
+
+    for (size_t i = 0; i < micrasCount; i++) {
+        this->addMicras();
+    }
+}
+
+void KinematicPhysicsEngine::update(float deltaTime) {
+    MICRASVERSE_PROFILE_ZONE("KinematicPhysicsEngine::update");
+
+    const size_t count = this->robotBodies.size();
+
+    // Sensors see the pose the commands were computed from, like the Box2D backend that casts before stepping
+    for (size_t i = 0; i < count; i++) {
+        const RobotBody& body = this->robotBodies[i];
+        this->arrays.leftCommand[i] = std::clamp(body.leftCommand, -100.0f, 100.0f);
+        this->arrays.rightCommand[i] = std::clamp(body.rightCommand, -100.0f, 100.0f);
+        this->arrays.fanEffect[i] = getFanEffect(body.isFanOn);
+        this->updateDistanceSensors(i);
+    }
+
+    for (size_t first = 0; first < count; first += simd::WIDTH) {
+        this->updateVelocities(first, deltaTime);
+    }
+
+    for (size_t i = 0; i < count; i++) {
+        this->integratePose(i, deltaTime);
+        this->robotBodies[i].simulatedTime += deltaTime;
+        this->publishState(i);
+    }
+}
+
+void KinematicPhysicsEngine::updateVelocities(size_t first, float deltaTime) {
+    const simd::FloatPack linearSpeed = simd::load(&this->arrays.linearSpeed[first]);
+    const simd::FloatPack angularVelocity = simd::load(&this->arrays.angularVelocity[first]);
+    const simd::FloatPack fanEffect = simd::load(&this->arrays.fanEffect[first]);
+
+    const MotorOutput<simd::FloatPack> left = computeMotorOutput<simd::FloatPack>(
+        simd::load(&this->arrays.leftCommand[first]), linearSpeed, angularVelocity, fanEffect, -1.0f, this->motorParameters
+    );
+    const MotorOutput<simd::FloatPack> right = computeMotorOutput<simd::FloatPack>(
+        simd::load(&this->arrays.rightCommand[first]), linearSpeed, angularVelocity, fanEffect, +1.0f, this->motorParameters
+    );
+
+    // The wheels sit at +-MICRAS_HALFWIDTH and push along the heading, the lateral velocity is always cancelled
+    const simd::FloatPack force = left.appliedForce + right.appliedForce;
+    const simd::FloatPack torque = (right.appliedForce - left.appliedForce) * MICRAS_HALFWIDTH;
+
+    simd::store(&this->arrays.linearSpeed[first], linearSpeed + force * (deltaTime / MICRAS_MASS));
+    simd::store(&this->arrays.angularVelocity[first], angularVelocity + torque * (deltaTime / MICRAS_INERTIA));
+}
+
+void KinematicPhysicsEngine::integratePose(size_t index, float deltaTime) {
+    const float x = this->arrays.positionX[index];
+    const float y = this->arrays.positionY[index];
+    const float angle = this->arrays.angle[index];
+    const float distance = this->arrays.linearSpeed[index] * deltaTime;
+
+    const float nextX = x - std::sin(angle) * distance;
+    const float nextY = y + std::cos(angle) * distance;
+    const float nextAngle = angle + this->arrays.angularVelocity[index] * deltaTime;
+
+    // Sweep every corner from its current to its next position and stop at the first wall crossed
+    float fraction = 1.0f;
+    for (const auto& corner : BODY_CORNERS) {
+        const b2Vec2 from = transformPoint(x, y, angle, corner);
+        const b2Vec2 to = transformPoint(nextX, nextY, nextAngle, corner);
+
+        const GridRaycaster::RayHit hit = this->raycaster.castRay(from, {to.x - from.x, to.y - from.y});
+        if (hit.hit) {
+            fraction = std::min(fraction, hit.fraction);
+        }
+    }
+
+    // Like the Box2D hit events, slow touches are resting or grazing contacts rather than crashes
+    if (fraction < 1.0f && !this->robotBodies[index].isTouchingWall && std::abs(this->arrays.linearSpeed[index]) > WALL_HIT_SPEED) {
+        this->robotBodies[index].wallCollisions++;
+    }
+    this->robotBodies[index].isTouchingWall = fraction < 1.0f;
+    if (fraction < 1.0f) {
+        fraction *= CONTACT_SKIN;
+        this->arrays.linearSpeed[index] = 0.0f;
+        this->arrays.angularVelocity[index] = 0.0f;
+    }
+
+    this->arrays.positionX[index] = x + (nextX - x) * fraction;
+    this->arrays.positionY[index] = y + (nextY - y) * fraction;
+    this->arrays.angle[index] = std::remainder(angle + (nextAngle - angle) * fraction, 2.0f * B2_PI);
+}
+
+void KinematicPhysicsEngine::updateDistanceSensors(size_t index) {
+    const float angle = this->arrays.angle[index];
+
+    float totalWeight = 0.0f;
+    for (const float weight : Box2DDistanceSensor::RAY_WEIGHTS) {
+        totalWeight += weight;
+    }
+
+    // Same ray fan and weighting as Box2DDistanceSensor, a miss counts as zero like b2World_CastRayClosest
+    for (size_t sensor = 0; sensor < DISTANCE_SENSOR_COUNT; sensor++) {
+        const DistanceSensorMount& mount = DISTANCE_SENSOR_MOUNTS[sensor];
+        const b2Vec2               origin = this->getWorldPoint(index, mount.localPosition);
+
+        const auto castDistance = [&](float rayAngle) {
+            const b2Vec2 translation{MAZE_FLOOR_WIDTH * std::cos(rayAngle), MAZE_FLOOR_WIDTH * std::sin(rayAngle)};
+            return this->raycaster.castRay(origin, translation).fraction * MAZE_FLOOR_WIDTH;
+        };
+
+        float reading = 0.0f;
+        for (size_t ray = 0; ray < Box2DDistanceSensor::RAY_ANGLE_OFFSETS.size(); ray++) {
+            reading += Box2DDistanceSensor::RAY_WEIGHTS[ray] * castDistance(angle + mount.angle + Box2DDistanceSensor::RAY_ANGLE_OFFSETS[ray]);
+        }
+        reading += castDistance(angle + mount.angle);
+
+        this->robotBodies[index].distanceReadings[sensor] = reading / (totalWeight + 1.0f);
+    }
+}
+
+void KinematicPhysicsEngine::publishState(size_t index) {
+    RobotBody&  body = this->robotBodies[index];
+    const float angle = this->arrays.angle[index];
+    const float linearSpeed = this->arrays.linearSpeed[index];
+
+    body.position = {this->arrays.positionX[index], this->arrays.positionY[index]};
+    body.angle = angle;
+    body.linearVelocity = {-std::sin(angle) * linearSpeed, std::cos(angle) * linearSpeed};
+    body.angularVelocity = this->arrays.angularVelocity[index];
+
+    const b2Vec2 leftWheel = this->getWorldPoint(index, {-MICRAS_HALFWIDTH, 0.0f});
+    const b2Vec2 rightWheel = this->getWorldPoint(index, {MICRAS_HALFWIDTH, 0.0f});
+    body.leftWheelPosition = {leftWheel.x, leftWheel.y};
+    body.rightWheelPosition = {rightWheel.x, rightWheel.y};
+}
+
+b2Vec2 KinematicPhysicsEngine::getWorldPoint(size_t index, const types::Vec2& localPoint) const {
+    return transformPoint(this->arrays.positionX[index], this->arrays.positionY[index], this->arrays.angle[index], localPoint);
+}
+
+void KinematicPhysicsEngine::loadMaze(const std::string_view mazePath) {
+    this->mazeElements = Maze::parseFile(mazePath);
+    this->raycaster.build(this->mazeElements);
+
+    for (size_t i = 0; i < this->robotBodies.size(); i++) {
+        this->updateDistanceSensors(i);
+    }
+}
+
+void KinematicPhysicsEngine::resetMicrasPosition() {
+    for (size_t i = 0; i < this->robotBodies.size(); i++) {
+        this->resetMicrasPosition(i);
+    }
+}
+
+void KinematicPhysicsEngine::resetMicrasPosition(size_t index) {
+    this->arrays.positionX[index] = (CELL_SIZE + WALL_THICKNESS) / 2.0f;
+    this->arrays.positionY[index] = MICRAS_HALFHEIGHT + WALL_THICKNESS;
+    this->arrays.angle[index] = 0.0f;
+    this->arrays.linearSpeed[index] = 0.0f;
+    this->arrays.angularVelocity[index] = 0.0f;
+    this->robotBodies[index].isTouchingWall = false;
+    this->robotBodies[index].wallCollisions = 0;
+
+    this->updateDistanceSensors(index);
+    this->publishState(index);
+}
+
+size_t KinematicPhysicsEngine::addMicras() {
+    this->robotBodies.emplace_back();
+    this->resizeArrays();
+
+    const size_t index = this->robotBodies.size() - 1;
+    this->resetMicrasPosition(index);
+    return index;
+}
+
+void KinematicPhysicsEngine::resizeArrays() {
+    const size_t paddedCount = simd::paddedSize(this->robotBodies.size());
+
+    for (auto* array :
+         {&arrays.positionX, &arrays.positionY, &arrays.angle, &arrays.linearSpeed, &arrays.angularVelocity, &arrays.leftCommand,
+          &arrays.rightCommand, &arrays.fanEffect}) {
+        array->resize(paddedCount, 0.0f);
+    }
+}
+
+}  // namespace micrasverse::physics
@@ -0,0 +1,283 @@
+#include "physics/task_scheduler.hpp"
+#include "constants.hpp"
+#include "micrasverse_core/profiler.hpp"
+
+#include <algorithm>
+#include <string>
+#include <iostream>
+
+namespace micrasverse::physics {
+
+namespace {
+
+// Index of the pool worker running on this thread; threads outside the pool are worker 0
+thread_local int currentWorkerIndex = 0;
+
+std::mutex                     sharedMutex;
+std::shared_ptr<TaskScheduler> sharedScheduler;
+int                            sharedWorkerCount = micrasverse::PHYSICS_WORKER_COUNT;
+
+}  // namespace
+
+bool TaskScheduler::WorkerQueue::pushBack(const Range& range) {
+    std::lock_guard<std::mutex> lock(this->mutex);
+    if (this->count == QUEUE_CAPACITY) {
+        return false;
+    }
+    this->ranges[(this->head + this->count) % QUEUE_CAPACITY] = range;
+    this->count++;
+    return true;
+}
+
+bool TaskScheduler::WorkerQueue::popBack(Range& range) {
+    std::lock_guard<std::mutex> lock(this->mutex);
+    if (this->count == 0) {
+        return false;
+    }
+    this->count--;
+    range = this->ranges[(this->head + this->count) % QUEUE_CAPACITY];
+    return true;
+}
+
+bool TaskScheduler::WorkerQueue::popFront(Range& range) {
+    std::lock_guard<std::mutex> lock(this->mutex);
+    if (this->count == 0) {
+        return false;
+    }
+    range = this->ranges[this->head];
+    this->head = (this->head + 1) % QUEUE_CAPACITY;
+    this->count--;
+    return true;
+}
+
+bool TaskScheduler::WorkerQueue::takeTask(const Task* task, Range& range) {
+    std::lock_guard<std::mutex> lock(this->mutex);
+    for (int i = 0; i < this->count; i++) {
+        const int slot = (this->head + i) % QUEUE_CAPACITY;
+        if (this->ranges[slot].task == task) {
+            range = this->ranges[slot];
+            // Order inside a queue does not matter, so the hole is filled with the last range
+            this->count--;
+            this->ranges[slot] = this->ranges[(this->head + this->count) % QUEUE_CAPACITY];
+            return true;
+        }
+    }
+    return false;
+}
+
+TaskScheduler::TaskScheduler(int workerCount) {
+    if (workerCount <= 0) {
+        workerCount = static_cast<int>(std::thread::hardware_concurrency());
+    }
+    this->workerCount = std::clamp(workerCount, 1, MAX_WORKERS);
+
+    this->threads.reserve(this->workerCount - 1);
+    for (int i = 1; i < this->workerCount; i++) {
+        this->threads.emplace_back(&TaskScheduler::workerLoop, this, i);
+    }
+}
+
+TaskScheduler::~TaskScheduler() {
+    {
+        std::lock_guard<std::mutex> lock(this->sleepMutex);
+        this->running = false;
+    }
+    this->sleepCondition.notify_all();
+
+    for (auto& thread : this->threads) {
+        thread.join();
+    }
+}
+
+void TaskScheduler::configureWorldDef(b2WorldDef& worldDef) {
+    worldDef.workerCount = this->workerCount;
+    worldDef.enqueueTask = &TaskScheduler::enqueueTask;
+    worldDef.finishTask = &TaskScheduler::finishTask;
+    worldDef.userTaskContext = this;
+}
+
+void TaskScheduler::parallelFor(int count, const std::function<void(int)>& body) {
+    if (count <= 0) {
+        return;
+    }
+
+    auto callback = [](int startIndex, int endIndex, uint32_t /*workerIndex*/, void* context) {
+        const auto& function = *static_cast<const std::function<void(int)>*>(context);
+        for (int i = startIndex; i < endIndex; i++) {
+            function(i);
+        }
+    };
+
+    Task* task = (this->workerCount > 1) ? this->acquireTask() : nullptr;
+    if (task == nullptr) {
+        callback(0, count, currentWorkerIndex, const_cast<std::function<void(int)>*>(&body));
+        return;
+    }
+
+    task->callback = callback;
+    task->context = const_cast<std::function<void(int)>*>(&body);
+    // One range per item: batch jobs have very different durations, so fine ranges balance better
+    this->submit(task, count, count);
+    this->wait(task);
+}
+
+std::shared_ptr<TaskScheduler> TaskScheduler::getShared() {
+    std::lock_guard<std::mutex> lock(sharedMutex);
+    if (!sharedScheduler) {
+        sharedScheduler = std::make_shared<TaskScheduler>(sharedWorkerCount);
+        std::cerr << "Physics task scheduler started with " << sharedScheduler->getWorkerCount() << " workers" << std::endl;
+    }
+    return sharedScheduler;
+}
+
+void TaskScheduler::setSharedWorkerCount(int workerCount) {
+    std::lock_guard<std::mutex> lock(sharedMutex);
+    if (sharedScheduler) {
+        std::cerr << "WARNING: Physics task scheduler already running, worker count change ignored" << std::endl;
+        return;
+    }
+    sharedWorkerCount = workerCount;
+}
+
+void* TaskScheduler::enqueueTask(b2TaskCallback* callback, int itemCount, int minRange, void* taskContext, void* userContext) {
+    auto* scheduler = static_cast<TaskScheduler*>(userContext);
+
+    Task* task = scheduler->acquireTask();
+    if (task == nullptr) {
+        // Out of task slots: Box2D accepts a serial execution signalled by a null handle
+        callback(0, itemCount, currentWorkerIndex, taskContext);
+        return nullptr;
+    }
+
+    task->callback = callback;
+    task->context = taskContext;
+
+    const int rangeCount = std::clamp(itemCount / std::max(minRange, 1), 1, scheduler->workerCount);
+    scheduler->submit(task, itemCount, rangeCount);
+    return task;
+}
+
+void TaskScheduler::finishTask(void* userTask, void* userContext) {
+    auto* scheduler = static_cast<TaskScheduler*>(userContext);
+    scheduler->wait(static_cast<Task*>(userTask));
+}
+
+TaskScheduler::Task* TaskScheduler::acquireTask() {
+    for (auto& task : this->tasks) {
+        bool expected = false;
+        if (!task.inUse.load(std::memory_order_relaxed) &&
+            task.inUse.compare_exchange_strong(expected, true, std::memory_order_acquire)) {
+            return &task;
+        }
+    }
+    return nullptr;
+}
+
+void TaskScheduler::submit(Task* task, int itemCount, int rangeCount) {
+    task->arena = Box2DArenaScope::getCurrentArena();
+    task->category = Box2DArenaScope::getCurrentCategory();
+    task->pendingRanges.store(rangeCount, std::memory_order_relaxed);
+
+    const int rangeSize = itemCount / rangeCount;
+    const int remainder = itemCount % rangeCount;
+    int       start = 0;
+
+    for (int i = 0; i < rangeCount; i++) {
+        const int   end = start + rangeSize + (i < remainder ? 1 : 0);
+        const Range range{task, start, end};
+        start = end;
+
+        // Spread ranges round robin so every worker has something to pop before it needs to steal
+        const uint32_t queueIndex = this->nextQueue.fetch_add(1, std::memory_order_relaxed) % this->workerCount;
+        if (this->queues[queueIndex].pushBack(range)) {
+            this->queuedRanges.fetch_add(1, std::memory_order_release);
+        } else {
+            this->execute(range);
+        }
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(this->sleepMutex);
+    }
+    this->sleepCondition.notify_all();
+}
+
+void TaskScheduler::wait(Task* task) {
+    // The waiting thread only picks up ranges of its own task: running another world's work here would reuse
+    // this thread's worker index inside that world while its own stepping thread may be using it too.
+    while (task->pendingRanges.load(std::memory_order_acquire) > 0) {
+        Range range;
+        bool  found = false;
+
+        for (int i = 0; i < this->workerCount && !found; i++) {
+            found = this->queues[i].takeTask(task, range);
+        }
+
+        if (found) {
+            this->queuedRanges.fetch_sub(1, std::memory_order_relaxed);
+            this->execute(range);
+        } else {
+            std::this_thread::yield();
+        }
+    }
+
+    task->inUse.store(false, std::memory_order_release);
+}
+
+void TaskScheduler::execute(const Range& range) {
+    {
+        // Box2D tasks allocate in the arena of the world that queued them, whichever thread runs them
+        const Box2DArenaScope allocationScope(range.task->arena, range.task->category);
+        range.task->callback(range.start, range.end, currentWorkerIndex, range.task->context);
+    }
+    // The task may be recycled as soon as the counter hits zero, so it must not be touched afterwards
+    range.task->pendingRanges.fetch_sub(1, std::memory_order_acq_rel);
+}
+
+bool TaskScheduler::findWork(int workerIndex, Range& range) {
+    if (this->queues[workerIndex].popBack(range)) {
+        return true;
+    }
+
+    for (int i = 1; i < this->workerCount; i++) {
+        const int victim = (workerIndex + i) % this->workerCount;
+        if (this->queues[victim].popFront(range)) {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+void TaskScheduler::workerLoop(int workerIndex) {
+    currentWorkerIndex = workerIndex;
+    profiler::setThreadName("Worker " + std::to_string(workerIndex));
+
+    // Box2D submits many tiny tasks per step, so workers spin for a while before going to sleep
+    constexpr int spinCount = 1000;
+
+    while (this->running.load(std::memory_order_relaxed)) {
+        Range range;
+        bool  found = false;
+
+        for (int spin = 0; spin < spinCount && !found; spin++) {
+            found = this->findWork(workerIndex, range);
+            if (!found && this->queuedRanges.load(std::memory_order_acquire) == 0) {
+                std::this_thread::yield();
+            }
+        }
+
+        if (found) {
+            this->queuedRanges.fetch_sub(1, std::memory_order_relaxed);
+            this->execute(range);
+            continue;
+        }
+
+        std::unique_lock<std::mutex> lock(this->sleepMutex);
+        this->sleepCondition.wait(lock, [this] {
+            return this->queuedRanges.load(std::memory_order_acquire) > 0 || !this->running.load(std::memory_order_relaxed);
+        });
+    }
+}
+
+}  // namespace micrasverse::physics
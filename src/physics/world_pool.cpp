@@ -0,0 +1,128 @@
+#include "physics/world_pool.hpp"
+
+#include <algorithm>
+#include <fstream>
+#include <iterator>
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+namespace micrasverse::physics {
+
+WorldPool::Lease::Lease(WorldPool& pool, uint64_t mazeHash, std::unique_ptr<Box2DPhysicsEngine> engine, bool reused) :
+    pool(&pool), mazeHash(mazeHash), engine(std::move(engine)), reused(reused) { }
+
+WorldPool::Lease& WorldPool::Lease::operator=(Lease&& other) noexcept {
+    if (this != &other) {
+        if (this->engine) {
+            this->pool->release(this->mazeHash, std::move(this->engine));
+        }
+
+        this->pool = other.pool;
+        this->mazeHash = other.mazeHash;
+        this->engine = std::move(other.engine);
+        this->reused = other.reused;
+    }
+    return *this;
+}
+
+WorldPool::Lease::~Lease() {
+    if (this->engine) {
+        this->pool->release(this->mazeHash, std::move(this->engine));
+    }
+}
+
+WorldPool::WorldPool(size_t robotCount, RobotCollisionMode collisionMode, size_t maxIdleWorlds) :
+    robotCount(robotCount), collisionMode(collisionMode), maxIdleWorlds(maxIdleWorlds) { }
+
+WorldPool::Lease WorldPool::acquire(std::string_view mazePath) {
+    const uint64_t mazeHash = this->getMazeHash(mazePath);
+
+    std::unique_ptr<Box2DPhysicsEngine> engine;
+    {
+        const std::lock_guard<std::mutex> lock(this->mutex);
+
+        const auto idle = std::find_if(this->idleWorlds.begin(), this->idleWorlds.end(), [mazeHash](const IdleWorld& world) {
+            return world.mazeHash == mazeHash;
+        });
+
+        if (idle != this->idleWorlds.end()) {
+            engine = std::move(idle->engine);
+            this->idleWorlds.erase(idle);
+            this->stats.reused++;
+        } else {
+            this->stats.built++;
+        }
+    }
+
+    if (!engine) {
+        engine = std::make_unique<Box2DPhysicsEngine>(mazePath, this->robotCount, this->collisionMode, nullptr);
+        return Lease(*this, mazeHash, std::move(engine), false);
+    }
+
+    // The walls stay as they are, only the robots go back to the start with their motors and sensors cleared
+    engine->resetMicrasPosition();
+    return Lease(*this, mazeHash, std::move(engine), true);
+}
+
+WorldPool::Stats WorldPool::getStats() const {
+    const std::lock_guard<std::mutex> lock(this->mutex);
+    Stats                             current = this->stats;
+    current.idle = this->idleWorlds.size();
+    return current;
+}
+
+uint64_t WorldPool::hashMazeFile(std::string_view mazePath) {
+    std::ifstream file{std::string(mazePath), std::ios::binary};
+    if (!file) {
+        throw std::runtime_error("Unable to open maze file: " + std::string(mazePath));
+    }
+
+    uint64_t hash = 14695981039346656037ULL;
+    for (auto character = std::istreambuf_iterator<char>(file); character != std::istreambuf_iterator<char>(); ++character) {
+        hash ^= static_cast<unsigned char>(*character);
+        hash *= 1099511628211ULL;
+    }
+    return hash;
+}
+
+uint64_t WorldPool::getMazeHash(std::string_view mazePath) {
+    {
+        const std::lock_guard<std::mutex> lock(this->mutex);
+        const auto                        cached = this->mazeHashes.find(std::string(mazePath));
+        if (cached != this->mazeHashes.end()) {
+            return cached->second;
+        }
+    }
+
+    // Read outside the lock, two threads hashing the same new maze store the same value
+    const uint64_t                    mazeHash = hashMazeFile(mazePath);
+    const std::lock_guard<std::mutex> lock(this->mutex);
+    this->mazeHashes.emplace(std::string(mazePath), mazeHash);
+    return mazeHash;
+}
+
+void WorldPool::release(uint64_t mazeHash, std::unique_ptr<Box2DPhysicsEngine> engine) {
+    std::unique_ptr<Box2DPhysicsEngine> evicted;
+    {
+        const std::lock_guard<std::mutex> lock(this->mutex);
+
+        // The least recently used engine makes room, it is destroyed after the lock is released
+        if (this->idleWorlds.size() >= this->maxIdleWorlds && !this->idleWorlds.empty()) {
+            const auto oldest = std::min_element(this->idleWorlds.begin(), this->idleWorlds.end(), [](const IdleWorld& a, const IdleWorld& b) {
+                return a.lastUse < b.lastUse;
+            });
+            evicted = std::move(oldest->engine);
+            this->idleWorlds.erase(oldest);
+            this->stats.evicted++;
+        }
+
+        if (this->maxIdleWorlds > 0) {
+            this->idleWorlds.push_back({mazeHash, this->useCounter++, std::move(engine)});
+        } else {
+            evicted = std::move(engine);
+        }
+    }
+}
+
+}  // namespace micrasverse::physics
@@ -3,7 +3,7 @@
 
 #include "micrasverse_core/types.hpp"
 #include "micras/core/types.hpp"
-#include "physics/box2d_micrasbody.hpp"
+#include "physics/robot_body.hpp"
 
 #include <vector>
 #include <array>
@@ -17,9 +17,9 @@ template <uint8_t num_of_leds>
 class TArgb {
 public:
     struct Config {
-        micrasverse::physics::Box2DMicrasBody* micrasBody = nullptr;
-        float                                  uncertainty;
-        std::array<float, num_of_leds>         brightness;
+        micrasverse::physics::RobotBody* micrasBody = nullptr;
+        float                            uncertainty;
+        std::array<float, num_of_leds>   brightness;
     };
 
     /**
@@ -58,9 +58,9 @@ public:
     void encode_color(const micrasverse::types::Color& color, uint8_t index);
 
 private:
-    micrasverse::physics::Box2DMicrasBody* micrasBody;
-    float                                  uncertainty;
-    std::array<float, num_of_leds>         brightness;
+    micrasverse::physics::RobotBody* micrasBody;
+    float                            uncertainty;
+    std::array<float, num_of_leds>   brightness;
 };
 }  // namespace micras::proxy
 
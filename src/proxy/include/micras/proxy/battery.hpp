@@ -2,22 +2,28 @@
 #define MICRAS_PROXY_BATTERY_HPP
 
 #include <cstdint>
-#include "physics/box2d_micrasbody.hpp"
+#include "physics/robot_body.hpp"
+#include "micrasverse_core/butterworth_filter_bank.hpp"
+#include "micrasverse_core/gaussian_noise.hpp"
 
 namespace micras::proxy {
 
 class Battery {
 public:
     struct Config {
-        micrasverse::physics::Box2DMicrasBody* micrasBody = nullptr;
-        float                                  voltage;
-        float                                  voltage_divider;
-        float                                  filter_cutoff;
-        float                                  noise;
+        micrasverse::physics::RobotBody* micrasBody = nullptr;
+        float                            voltage;
+        float                            voltage_divider;
+        float                            filter_cutoff;
+        float                            noise;
     };
 
     explicit Battery(const Config& config);
 
+    // Reads the voltage at the battery rate, far slower than the firmware loop
+    void sample();
+
+    // Filters the last sampled voltage at the firmware loop rate
     void update();
 
     float get_voltage() const;
@@ -27,13 +33,14 @@ public:
     float get_adc_reading() const;
 
 private:
-    micrasverse::physics::Box2DMicrasBody* micrasBody;
-    float                                  voltage;
-    float                                  voltage_divider;
-    float                                  noise;
-    float                                  raw_reading{0.0f};
-    float                                  filtered_reading{0.0f};
-    float                                  max_voltage;
+    micrasverse::physics::RobotBody*               micrasBody;
+    float                                          voltage;
+    float                                          voltage_divider;
+    float                                          noise;
+    float                                          raw_reading{0.0f};
+    float                                          max_voltage;
+    micrasverse::filters::ButterworthFilterBank<1> filter;
+    micrasverse::noise::GaussianNoise              noise_dist;
 };
 
 }  // namespace micras::proxy
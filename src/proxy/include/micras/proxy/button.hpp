@@ -1,7 +1,7 @@
 #pragma once
 
 #include <cstdint>
-#include "physics/box2d_micrasbody.hpp"
+#include "physics/robot_body.hpp"
 
 namespace micras::proxy {
 
@@ -21,9 +21,9 @@ public:
     };
 
     struct Config {
-        micrasverse::physics::Box2DMicrasBody* micrasBody = nullptr;
-        bool                                   initial_state = false;
-        PullType                               pull_type = PullType::PULL_UP;
+        micrasverse::physics::RobotBody* micrasBody = nullptr;
+        bool                             initial_state = false;
+        PullType                         pull_type = PullType::PULL_UP;
     };
 
     explicit Button(const Config& config);
@@ -38,11 +38,11 @@ public:
     void     set_pull_type(PullType pull_type);
 
 private:
-    micrasverse::physics::Box2DMicrasBody* micrasBody;
-    bool                                   current_state;
-    bool                                   previous_state;
-    Status                                 current_status;
-    PullType                               pull_type;
+    micrasverse::physics::RobotBody* micrasBody;
+    bool                             current_state;
+    bool                             previous_state;
+    Status                           current_status;
+    PullType                         pull_type;
 
     bool get_logical_state() const;
 };
@@ -2,7 +2,7 @@
 #define MICRAS_PROXY_BUZZER_HPP
 
 #include "micras/core/types.hpp"
-#include "physics/box2d_micrasbody.hpp"
+#include "physics/robot_body.hpp"
 
 #include <cstdint>
 #include "micras/proxy/stopwatch.hpp"
@@ -13,8 +13,8 @@ namespace micras::proxy {
 class Buzzer {
 public:
     struct Config {
-        micrasverse::physics::Box2DMicrasBody* micrasBody = nullptr;
-        uint8_t                                volume;
+        micrasverse::physics::RobotBody* micrasBody = nullptr;
+        uint8_t                          volume;
     };
 
     explicit Buzzer(const Config& config);
@@ -34,14 +34,14 @@ public:
     bool is_playing() const;
 
 private:
-    micrasverse::physics::Box2DMicrasBody* micrasBody;
-    float                                  volume;
-    bool                                   playing{false};
-    uint32_t                               duration{0};
-    float                                  start_time{0.0f};
-    uint32_t                               current_frequency{0};
-    std::unique_ptr<Stopwatch>             tone_timer;
-    std::unique_ptr<Stopwatch>             wait_timer;
+    micrasverse::physics::RobotBody* micrasBody;
+    float                            volume;
+    bool                             playing{false};
+    uint32_t                         duration{0};
+    float                            start_time{0.0f};
+    uint32_t                         current_frequency{0};
+    std::unique_ptr<Stopwatch>       tone_timer;
+    std::unique_ptr<Stopwatch>       wait_timer;
 };
 
 }  // namespace micras::proxy
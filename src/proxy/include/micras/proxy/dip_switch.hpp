@@ -2,7 +2,7 @@
 #define MICRAS_PROXY_DIP_SWITCH_HPP
 
 #include "micras/core/types.hpp"
-#include "physics/box2d_micrasbody.hpp"
+#include "physics/robot_body.hpp"
 
 #include <array>
 #include <cstdint>
@@ -13,8 +13,8 @@ template <uint8_t num_of_switches>
 class TDipSwitch {
 public:
     struct Config {
-        micrasverse::physics::Box2DMicrasBody* micrasBody = nullptr;
-        std::array<bool, num_of_switches>      initial_states;
+        micrasverse::physics::RobotBody*  micrasBody = nullptr;
+        std::array<bool, num_of_switches> initial_states;
     };
 
     explicit TDipSwitch(const Config& config);
@@ -28,8 +28,8 @@ public:
     void setState(uint8_t value);
 
 private:
-    micrasverse::physics::Box2DMicrasBody* micrasBody;
-    std::array<bool, num_of_switches>      switch_states;
+    micrasverse::physics::RobotBody*  micrasBody;
+    std::array<bool, num_of_switches> switch_states;
 };
 
 }  // namespace micras::proxy
@@ -3,7 +3,7 @@
 
 #include <cstdint>
 #include <memory>
-#include "physics/box2d_micrasbody.hpp"
+#include "physics/robot_body.hpp"
 
 namespace micras::proxy {
 
@@ -15,7 +15,7 @@ public:
     };
 
     struct Config {
-        micrasverse::physics::Box2DMicrasBody* micrasBody = nullptr;
+        micrasverse::physics::RobotBody* micrasBody = nullptr;
     };
 
     explicit Fan(const Config& config);
@@ -35,11 +35,11 @@ public:
     void set_direction(RotationDirection direction);
 
 private:
-    micrasverse::physics::Box2DMicrasBody* micrasBody;
-    float                                  current_speed = 0.0f;
-    bool                                   enabled = false;
-    float                                  last_update_time{0.0f};
-    RotationDirection                      current_direction = RotationDirection::FORWARD;
+    micrasverse::physics::RobotBody* micrasBody;
+    float                            current_speed = 0.0f;
+    bool                             enabled = false;
+    float                            last_update_time{0.0f};
+    RotationDirection                current_direction = RotationDirection::FORWARD;
 };
 
 }  // namespace micras::proxy
@@ -3,17 +3,18 @@
 
 #include <array>
 #include <cstdint>
-#include "box2d/box2d.h"
-#include "physics/box2d_micrasbody.hpp"
+#include "physics/robot_body.hpp"
+#include "micrasverse_core/gaussian_noise.hpp"
+#include "micrasverse_core/types.hpp"
 
 namespace micras::proxy {
 
 class Imu {
 public:
     struct Config {
-        micrasverse::physics::Box2DMicrasBody* micrasBody = nullptr;
-        float                                  gyroscope_noise;
-        float                                  accelerometer_noise;
+        micrasverse::physics::RobotBody* micrasBody = nullptr;
+        float                            gyroscope_noise;
+        float                            accelerometer_noise;
     };
 
     enum Axis : uint8_t {
@@ -26,6 +27,10 @@ public:
 
     bool check_whoami();
 
+    // Reads the body state at the IMU rate, elapsed is the time since the previous sample in seconds
+    void sample(float elapsed);
+
+    // The readings are refreshed by sample, the firmware loop only reads the last one
     void update();
 
     float get_angular_velocity(Axis axis) const;
@@ -37,12 +42,13 @@ public:
     bool was_initialized() const;
 
 private:
-    micrasverse::physics::Box2DMicrasBody* micrasBody;
-    b2BodyId                               bodyId;
-    float                                  gyroscope_noise;
-    float                                  accelerometer_noise;
-    b2Vec2                                 current_linear_velocity;
-    b2Vec2                                 previous_linear_velocity;
+    micrasverse::physics::RobotBody*  micrasBody;
+    float                             gyroscope_noise;
+    float                             accelerometer_noise;
+    micrasverse::types::Vec2          current_linear_velocity;
+    micrasverse::types::Vec2          previous_linear_velocity;
+    micrasverse::noise::GaussianNoise gyro_noise_dist;
+    micrasverse::noise::GaussianNoise accel_noise_dist;
 
     std::array<float, 3>   angular_velocity{};
     std::array<float, 3>   linear_acceleration{};
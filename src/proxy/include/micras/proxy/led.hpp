@@ -2,7 +2,7 @@
 #define MICRAS_PROXY_LED_HPP
 
 #include "micras/core/types.hpp"
-#include "physics/box2d_micrasbody.hpp"
+#include "physics/robot_body.hpp"
 
 #include <cstdint>
 
@@ -11,11 +11,11 @@ namespace micras::proxy {
 class Led {
 public:
     struct Config {
-        micrasverse::physics::Box2DMicrasBody* micrasBody;
-        bool                                   initial_state;
-        uint8_t                                red;
-        uint8_t                                green;
-        uint8_t                                blue;
+        micrasverse::physics::RobotBody* micrasBody;
+        bool                             initial_state;
+        uint8_t                          red;
+        uint8_t                          green;
+        uint8_t                          blue;
     };
 
     explicit Led(const Config& config);
@@ -37,13 +37,13 @@ public:
     uint8_t get_blue() const;
 
 private:
-    void                                   updateColor();
-    micrasverse::physics::Box2DMicrasBody* micrasBody;
-    uint8_t                                ledIndex;
-    bool                                   state{false};
-    uint8_t                                red{255};
-    uint8_t                                green{255};
-    uint8_t                                blue{255};
+    void                             updateColor();
+    micrasverse::physics::RobotBody* micrasBody;
+    uint8_t                          ledIndex;
+    bool                             state{false};
+    uint8_t                          red{255};
+    uint8_t                          green{255};
+    uint8_t                          blue{255};
 };
 
 }  // namespace micras::proxy
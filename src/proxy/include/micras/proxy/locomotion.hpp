@@ -1,14 +1,14 @@
 #ifndef MICRAS_PROXY_LOCOMOTION_HPP
 #define MICRAS_PROXY_LOCOMOTION_HPP
 
-#include "physics/box2d_micrasbody.hpp"
+#include "physics/robot_body.hpp"
 
 namespace micras::proxy {
 
 class Locomotion {
 public:
     struct Config {
-        micrasverse::physics::Box2DMicrasBody* micrasBody = nullptr;
+        micrasverse::physics::RobotBody* micrasBody = nullptr;
     };
 
     explicit Locomotion(const Config& config);
@@ -26,7 +26,7 @@ public:
     void stop();
 
 private:
-    micrasverse::physics::Box2DMicrasBody* micrasBody;
+    micrasverse::physics::RobotBody* micrasBody;
 };
 
 }  // namespace micras::proxy
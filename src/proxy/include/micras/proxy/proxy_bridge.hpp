@@ -15,11 +15,12 @@
 #include "micras/proxy/stopwatch.hpp"
 #include "micras/core/types.hpp"
 #include "micrasverse_core/types.hpp"
-#include "physics/box2d_micrasbody.hpp"
+#include "physics/robot_body.hpp"
 #include "micras/nav/state.hpp"
 #include "micras/nav/actions/base.hpp"
 #include <limits>
 #include <algorithm>
+#include <array>
 #include <unordered_map>
 #include <vector>
 #include "constants.hpp"
@@ -36,9 +37,24 @@ public:
      * @brief Construct a new ProxyBridge object.
      *
      * @param micras Reference to the Micras controller.
-     * @param micrasBody Reference to the Box2D Micras body.
+     * @param micrasBody Reference to the simulated body state, from any physics backend.
      */
-    explicit ProxyBridge(Micras& micras, micrasverse::physics::Box2DMicrasBody& micrasBody);
+    explicit ProxyBridge(Micras& micras, micrasverse::physics::RobotBody& micrasBody);
+
+    // Sensors sampled together at the same rate
+    enum class SensorGroup : uint8_t {
+        WALL_SENSORS,
+        ENCODERS,
+        IMU,
+        TORQUE,
+        BATTERY,
+    };
+
+    // Sampling phase of a group, computes its proxy readings from the published body state exactly once. Elapsed is
+    // the time since the previous sample of the group in seconds.
+    void sample_sensors(SensorGroup group, float elapsed);
+
+    const micrasverse::physics::SensorSample& get_sensor_sample() const { return micrasBody.sensorSample; }
 
     // Button access
     proxy::Button::Status   get_button_status() const;
@@ -107,7 +123,7 @@ public:
 
     // Dip switch access
     bool              get_dip_switch_state(uint8_t index) const;
-    std::vector<bool> get_dip_switch_states() const;
+    std::array<bool, 4> get_dip_switch_states() const;
     void              set_dip_switch_state(uint8_t index, bool state);
     uint8_t           get_dip_switch_value() const;
 
@@ -124,8 +140,8 @@ public:
     // MicrasController access
     micras::core::Objective              get_objective() const;
     std::shared_ptr<micras::nav::Action> get_current_action() const;
-    std::string                          get_objective_string() const;
-    std::string                          get_action_type_string() const;
+    const char*                          get_objective_string() const;
+    const char*                          get_action_type_string() const;
 
     // Speed controller access
     micras::nav::SpeedController& get_speed_controller() const;
@@ -194,9 +210,16 @@ public:
     int get_maze_height() const { return micras::maze_height; }
 
     std::vector<int16_t> get_maze_cell_costs() const {
-        const int            width = get_maze_width();
-        const int            height = get_maze_height();
-        std::vector<int16_t> costs(width * height);
+        std::vector<int16_t> costs;
+        get_maze_cell_costs(costs);
+        return costs;
+    }
+
+    // Reuses the storage of costs, so redrawing the costs every frame doesn't allocate
+    void get_maze_cell_costs(std::vector<int16_t>& costs) const {
+        const int width = get_maze_width();
+        const int height = get_maze_height();
+        costs.resize(width * height);
 
         for (int y = 0; y < height; y++) {
             for (int x = 0; x < width; x++) {
@@ -205,16 +228,14 @@ public:
                 costs[y * width + x] = cost > 125 ? 125 : cost;
             }
         }
-
-        return costs;
     }
 
     core::Vector getOffset() const {
         micras::nav::Pose pose;
         pose.position = {
-            micrasBody.getPosition().x - micrasverse::WALL_THICKNESS / 2.0f, micrasBody.getPosition().y - micrasverse::WALL_THICKNESS / 2.0f
+            micrasBody.position.x - micrasverse::WALL_THICKNESS / 2.0f, micrasBody.position.y - micrasverse::WALL_THICKNESS / 2.0f
         };
-        pose.orientation = micrasBody.getAngle() + B2_PI / 2.0f;
+        pose.orientation = micrasBody.angle + B2_PI / 2.0f;
         core::Vector offset = pose.to_cell(micras::cell_size);
         return offset;
     }
@@ -225,7 +246,7 @@ public:
         return offset;
     }
 
-    static std::string get_side_string(micras::nav::Side side) {
+    static const char* get_side_string(micras::nav::Side side) {
         switch (side) {
             case micras::nav::Side::UP:
                 return "UP";
@@ -249,8 +270,8 @@ public:
     bool peek_event(Interface::Event event) const;
 
 private:
-    Micras&                                micras;
-    micrasverse::physics::Box2DMicrasBody& micrasBody;
+    Micras&                          micras;
+    micrasverse::physics::RobotBody& micrasBody;
 };
 
 }  // namespace micras
@@ -2,8 +2,7 @@
 #define MICRAS_PROXY_ROTARY_SENSOR_HPP
 
 #include "micras/proxy/stopwatch.hpp"
-#include "box2d/box2d.h"
-#include "physics/box2d_micrasbody.hpp"
+#include "physics/robot_body.hpp"
 #include "micrasverse_core/types.hpp"
 
 #include <memory>
@@ -13,27 +12,29 @@ namespace micras::proxy {
 class RotarySensor {
 public:
     struct Config {
-        micrasverse::physics::Box2DMicrasBody* micrasBody = nullptr;
-        float                                  resolution;  // Resolution of the encoder in counts per revolution
-        float                                  noise;       // Noise level in counts
-        bool                                   isLeftWheel;
+        micrasverse::physics::RobotBody* micrasBody = nullptr;
+        float                            resolution;  // Resolution of the encoder in counts per revolution
+        float                            noise;       // Noise level in counts
+        bool                             isLeftWheel;
     };
 
     explicit RotarySensor(const Config& config);
 
+    // Integrates the wheel travel since the last sample, once per step before the firmware runs
+    void sample();
+
     float get_position() const;
 
 private:
-    micrasverse::physics::Box2DMicrasBody* micrasBody;
-    b2BodyId                               bodyId;
-    float                                  resolution;
-    float                                  noise;
-    float                                  position{0.0f};
-    float                                  last_position{0.0f};
-    micrasverse::types::Vec2               global_position{0.0f, 0.0f};
-    micrasverse::types::Vec2               last_global_position{0.0f, 0.0f};
-    std::unique_ptr<Stopwatch>             stopwatch;
-    bool                                   isLeftWheel;
+    micrasverse::physics::RobotBody* micrasBody;
+    float                            resolution;
+    float                            noise;
+    float                            position{0.0f};
+    float                            last_position{0.0f};
+    micrasverse::types::Vec2         global_position{0.0f, 0.0f};
+    micrasverse::types::Vec2         last_global_position{0.0f, 0.0f};
+    std::unique_ptr<Stopwatch>       stopwatch;
+    bool                             isLeftWheel;
 };
 
 }  // namespace micras::proxy
@@ -1,6 +1,8 @@
 #ifndef MICRAS_PROXY_STOPWATCH_HPP
 #define MICRAS_PROXY_STOPWATCH_HPP
 
+#include "physics/robot_body.hpp"
+
 #include <cstdint>
 #include <chrono>
 
@@ -8,8 +10,11 @@ namespace micras::proxy {
 
 class Stopwatch {
 public:
+    // With a body the stopwatch follows the simulated time of its steps, so firmware timings don't depend on how fast
+    // the host runs the simulation. Without one it reads the steady clock.
     struct Config {
-        float looptime{0.0F};  // Step size in seconds
+        const micrasverse::physics::RobotBody* micrasBody = nullptr;
+        float                                  looptime{0.0F};  // Step size in seconds
     };
 
     Stopwatch();
@@ -29,8 +34,10 @@ public:
     void sleep_us(uint32_t time);
 
 private:
-    std::chrono::steady_clock::time_point start_time;
-    float                                 looptime{0.0F};  // Step size in seconds
+    const micrasverse::physics::RobotBody* micrasBody = nullptr;
+    std::chrono::steady_clock::time_point  start_time;
+    double                                 start_simulated_time{0.0};  // seconds
+    float                                  looptime{0.0F};             // Step size in seconds
 };
 
 }  // namespace micras::proxy
@@ -23,6 +23,8 @@ class Storage {
 public:
     /**
      * @brief Configuration struct for the storage.
+     *
+     * An empty storage path keeps the data in memory only, so headless runs don't share or leave files behind.
      */
     struct Config {
         std::filesystem::path storage_path;
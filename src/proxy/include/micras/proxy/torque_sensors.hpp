@@ -3,8 +3,9 @@
 
 #include <array>
 #include <cstdint>
-#include <random>
-#include "physics/box2d_micrasbody.hpp"
+#include "physics/robot_body.hpp"
+#include "micrasverse_core/butterworth_filter_bank.hpp"
+#include "micrasverse_core/gaussian_noise.hpp"
 
 namespace micras::proxy {
 
@@ -18,12 +19,12 @@ public:
      * @brief Configuration struct for torque sensors.
      */
     struct Config {
-        micrasverse::physics::Box2DMicrasBody* micrasBody = nullptr;
-        float                                  shunt_resistor;
-        float                                  max_torque;
-        float                                  max_current;
-        float                                  filter_cutoff;
-        float                                  noise;
+        micrasverse::physics::RobotBody* micrasBody = nullptr;
+        float                            shunt_resistor;
+        float                            max_torque;
+        float                            max_current;
+        float                            filter_cutoff;
+        float                            noise;
     };
 
     /**
@@ -39,7 +40,12 @@ public:
     void calibrate();
 
     /**
-     * @brief Update the torque sensors readings.
+     * @brief Read the simulated torques at the torque sensors rate.
+     */
+    void sample();
+
+    /**
+     * @brief Filter the last sampled torques at the firmware loop rate.
      */
     void update();
 
@@ -92,18 +98,16 @@ public:
     void set_torque(uint8_t sensor_index, float torque);
 
 private:
-    micrasverse::physics::Box2DMicrasBody* micrasBody;
-    float                                  shunt_resistor;
-    float                                  max_torque;
-    float                                  max_current;
-    float                                  filter_cutoff;
-    float                                  noise;
-    std::array<float, num_of_sensors>      base_reading{};
-    std::array<float, num_of_sensors>      simulated_torque{};
-    std::array<float, num_of_sensors>      filtered_readings{};
-    std::random_device                     rd;
-    std::mt19937                           gen;
-    std::normal_distribution<float>        noise_dist;
+    micrasverse::physics::RobotBody*                            micrasBody;
+    float                                                       shunt_resistor;
+    float                                                       max_torque;
+    float                                                       max_current;
+    float                                                       noise;
+    std::array<float, num_of_sensors>                           base_reading{};
+    std::array<float, num_of_sensors>                           simulated_torque{};
+    std::array<float, num_of_sensors>                           sampled_torque{};
+    micrasverse::filters::ButterworthFilterBank<num_of_sensors> filters;
+    micrasverse::noise::GaussianNoise                           noise_dist;
 };
 }  // namespace micras::proxy
 
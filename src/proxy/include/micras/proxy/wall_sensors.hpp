@@ -1,10 +1,9 @@
 #ifndef MICRAS_PROXY_WALL_SENSORS_HPP
 #define MICRAS_PROXY_WALL_SENSORS_HPP
 
-#include "physics/box2d_micrasbody.hpp"
-#include "physics/box2d_distance_sensor.hpp"
+#include "physics/robot_body.hpp"
 #include "micras/core/types.hpp"
-#include "micras/core/butterworth_filter.hpp"
+#include "micrasverse_core/butterworth_filter_bank.hpp"
 
 #include <array>
 #include <cstdint>
@@ -17,13 +16,13 @@ template <uint8_t num_of_sensors>
 class TWallSensors {
 public:
     struct Config {
-        micrasverse::physics::Box2DMicrasBody* micrasBody;
-        float                                  uncertainty;
-        std::array<float, num_of_sensors>      base_readings;
-        float                                  max_sensor_reading;
-        float                                  min_sensor_reading;
-        float                                  max_sensor_distance;
-        float                                  filter_cutoff;
+        micrasverse::physics::RobotBody*  micrasBody;
+        float                             uncertainty;
+        std::array<float, num_of_sensors> base_readings;
+        float                             max_sensor_reading;
+        float                             min_sensor_reading;
+        float                             max_sensor_distance;
+        float                             filter_cutoff;
     };
 
     explicit TWallSensors(const Config& config);
@@ -34,6 +33,9 @@ public:
 
     void turn_off();
 
+    // Converts the distances of the body to ADC readings, once per step before the firmware runs
+    void sample();
+
     void update();
 
     bool get_wall(uint8_t sensor_index, bool disturbed = false) const;
@@ -53,12 +55,12 @@ public:
     void calibrate_sensor(uint8_t sensor_index);
 
 private:
-    micrasverse::physics::Box2DMicrasBody*              micrasBody;
-    float                                               uncertainty;
-    std::array<float, num_of_sensors>                   base_readings{};
-    float                                               max_sensor_reading;
-    float                                               c;
-    std::array<core::ButterworthFilter, num_of_sensors> filters;
+    micrasverse::physics::RobotBody*                            micrasBody;
+    float                                                       uncertainty;
+    std::array<float, num_of_sensors>                           base_readings{};
+    float                                                       max_sensor_reading;
+    float                                                       c;
+    micrasverse::filters::ButterworthFilterBank<num_of_sensors> filters;
 };
 
 }  // namespace micras::proxy
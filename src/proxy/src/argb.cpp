@@ -2,7 +2,6 @@
 #define MICRAS_PROXY_ARGB_CPP
 
 #include "micras/proxy/argb.hpp"
-#include "physics/box2d_micrasbody.hpp"
 #include <iostream>
 
 namespace micras::proxy {
@@ -31,7 +30,7 @@ void TArgb<num_of_leds>::update() { }
 
 template <uint8_t num_of_leds>
 void TArgb<num_of_leds>::attachArgb(b2Vec2 localPosition, b2Vec2 size, micrasverse::types::Color color) {
-    std::cerr << "Warning: attachArgb called on proxy, but it has no effect. ARGBs are managed by Box2DMicrasBody" << std::endl;
+    std::cerr << "Warning: attachArgb called on proxy, but it has no effect. ARGBs are managed by the physics engine" << std::endl;
 }
 
 template <uint8_t num_of_leds>
@@ -1,5 +1,5 @@
 #include "micras/proxy/battery.hpp"
-#include <random>
+#include "constants.hpp"
 #include <algorithm>
 
 namespace micras::proxy {
@@ -9,23 +9,22 @@ Battery::Battery(const Config& config) :
     voltage{config.voltage},
     voltage_divider{config.voltage_divider},
     noise{config.noise},
-    max_voltage{config.voltage * config.voltage_divider} { }
+    max_voltage{config.voltage * config.voltage_divider},
+    filter{config.filter_cutoff, 1.0f / micrasverse::STEP},
+    noise_dist{config.noise} { }
 
-void Battery::update() {
-    static std::random_device              rd;
-    static std::mt19937                    gen(rd());
-    static std::normal_distribution<float> noise_dist(0.0f, noise);
-
-    float noisy_voltage = voltage + noise_dist(gen);
+void Battery::sample() {
+    float noisy_voltage = voltage + this->noise_dist.next();
 
     raw_reading = std::clamp(noisy_voltage / max_voltage, 0.0f, 1.0f);
+}
 
-    const float alpha = 0.1f;
-    filtered_reading = alpha * raw_reading + (1.0f - alpha) * filtered_reading;
+void Battery::update() {
+    this->filter.update(std::span<const float, 1>(&this->raw_reading, 1));
 }
 
 float Battery::get_voltage() const {
-    return filtered_reading * max_voltage;
+    return this->filter.get_last(0) * max_voltage;
 }
 
 float Battery::get_voltage_raw() const {
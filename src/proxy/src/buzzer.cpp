@@ -3,8 +3,8 @@
 namespace micras::proxy {
 
 Buzzer::Buzzer(const Config& config) : micrasBody(config.micrasBody), volume(config.volume), playing(false), duration(0), current_frequency(0) {
-    tone_timer = std::make_unique<Stopwatch>(Stopwatch::Config{});
-    wait_timer = std::make_unique<Stopwatch>(Stopwatch::Config{});
+    tone_timer = std::make_unique<Stopwatch>(Stopwatch::Config{.micrasBody = config.micrasBody});
+    wait_timer = std::make_unique<Stopwatch>(Stopwatch::Config{.micrasBody = config.micrasBody});
 }
 
 void Buzzer::play(uint32_t frequency, uint32_t duration_ms) {
@@ -1,5 +1,4 @@
 #include "micras/proxy/fan.hpp"
-#include "physics/box2d_motor.hpp"
 
 #include <algorithm>
 
@@ -11,14 +10,12 @@ Fan::Fan(const Config& config) : micrasBody{config.micrasBody} {
 
 void Fan::enable() {
     this->enabled = true;
-    this->micrasBody->getLeftMotor().isFanOn = true;
-    this->micrasBody->getRightMotor().isFanOn = true;
+    this->micrasBody->isFanOn = true;
 }
 
 void Fan::disable() {
     this->enabled = false;
-    this->micrasBody->getLeftMotor().isFanOn = false;
-    this->micrasBody->getRightMotor().isFanOn = false;
+    this->micrasBody->isFanOn = false;
 }
 
 void Fan::set_speed(float speed) {
@@ -1,5 +1,4 @@
 #include "micras/proxy/led.hpp"
-#include "physics/box2d_micrasbody.hpp"
 #include "micras/core/types.hpp"
 #include "micrasverse_core/types.hpp"
 
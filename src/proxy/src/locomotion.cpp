@@ -1,5 +1,4 @@
 #include "micras/proxy/locomotion.hpp"
-#include "physics/box2d_motor.hpp"
 
 #include <cmath>
 
@@ -13,27 +12,27 @@ Locomotion::Locomotion(const Config& config) : micrasBody(config.micrasBody) {
 void Locomotion::enable() {
     // Set both motors to active state
     if (micrasBody) {
-        micrasBody->getLeftMotor().setCommand(0.0f);   // Initialize with zero command
-        micrasBody->getRightMotor().setCommand(0.0f);  // Initialize with zero command
+        micrasBody->leftCommand = 0.0f;   // Initialize with zero command
+        micrasBody->rightCommand = 0.0f;  // Initialize with zero command
     }
 }
 
 void Locomotion::disable() {
     // Stop and deactivate both motors
     if (micrasBody) {
-        micrasBody->getLeftMotor().setCommand(0.0f);
-        micrasBody->getRightMotor().setCommand(0.0f);
+        micrasBody->leftCommand = 0.0f;
+        micrasBody->rightCommand = 0.0f;
     }
 }
 
 void Locomotion::update(float deltaTime, bool isFanOn) {
-    // No-op since micrasBody handles motor updates
+    // No-op since the physics engine reads the commands from micrasBody
 }
 
 void Locomotion::set_wheel_command(float left_command, float right_command) {
     if (micrasBody) {
-        micrasBody->getLeftMotor().setCommand(left_command);
-        micrasBody->getRightMotor().setCommand(right_command);
+        micrasBody->leftCommand = left_command;
+        micrasBody->rightCommand = right_command;
     }
 }
 
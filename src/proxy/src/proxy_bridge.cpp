@@ -1,10 +1,33 @@
 #include "micras/proxy/proxy_bridge.hpp"
 #include <iostream>
 #include <algorithm>
+#include <string_view>
+#include <typeinfo>
 
 namespace micras {
 
-ProxyBridge::ProxyBridge(Micras& micras, micrasverse::physics::Box2DMicrasBody& micrasBody) : micras(micras), micrasBody(micrasBody) { }
+ProxyBridge::ProxyBridge(Micras& micras, micrasverse::physics::RobotBody& micrasBody) : micras(micras), micrasBody(micrasBody) { }
+
+void ProxyBridge::sample_sensors(SensorGroup group, float elapsed) {
+    switch (group) {
+        case SensorGroup::WALL_SENSORS:
+            micras.wall_sensors->sample();
+            break;
+        case SensorGroup::ENCODERS:
+            micras.rotary_sensor_left->sample();
+            micras.rotary_sensor_right->sample();
+            break;
+        case SensorGroup::IMU:
+            micras.imu->sample(elapsed);
+            break;
+        case SensorGroup::TORQUE:
+            micras.torque_sensors->sample();
+            break;
+        case SensorGroup::BATTERY:
+            micras.battery->sample();
+            break;
+    }
+}
 
 // Button access
 proxy::Button::Status ProxyBridge::get_button_status() const {
@@ -108,8 +131,7 @@ void ProxyBridge::calibrate_imu() {
 
 // Rotary sensors access
 void ProxyBridge::update_rotary_sensors() {
-    // In the simulation, rotary sensors are updated automatically
-    // No update method to call in RotarySensor class
+    // In the simulation, rotary sensors are integrated by sample_sensors once per step
 }
 
 float ProxyBridge::get_left_rotary_sensor_position() const {
@@ -230,10 +252,10 @@ bool ProxyBridge::get_dip_switch_state(uint8_t index) const {
     return micras.dip_switch->get_switch_state(index);
 }
 
-std::vector<bool> ProxyBridge::get_dip_switch_states() const {
-    std::vector<bool> states;
-    for (uint8_t i = 0; i < 4; ++i) {
-        states.push_back(micras.dip_switch->get_switch_state(i));
+std::array<bool, 4> ProxyBridge::get_dip_switch_states() const {
+    std::array<bool, 4> states{};
+    for (uint8_t i = 0; i < states.size(); ++i) {
+        states[i] = micras.dip_switch->get_switch_state(i);
     }
     return states;
 }
@@ -264,7 +286,7 @@ std::shared_ptr<micras::nav::Action> ProxyBridge::get_current_action() const {
     return micras.current_action;
 }
 
-std::string ProxyBridge::get_objective_string() const {
+const char* ProxyBridge::get_objective_string() const {
     switch (get_objective()) {
         case micras::core::Objective::EXPLORE:
             return "EXPLORE";
@@ -277,7 +299,7 @@ std::string ProxyBridge::get_objective_string() const {
     }
 }
 
-std::string ProxyBridge::get_action_type_string() const {
+const char* ProxyBridge::get_action_type_string() const {
     auto action = get_current_action();
     if (!action) {
         return "NONE";
@@ -286,11 +308,11 @@ std::string ProxyBridge::get_action_type_string() const {
     // We need to use RTTI to check what kind of action it is
     // This is a simplified version - you might need to add more cases
     // based on the actual action classes in MicrasFirmware
-    const auto& typeName = typeid(*action).name();
+    const std::string_view typeName = typeid(*action).name();
 
-    if (std::string(typeName).find("MoveAction") != std::string::npos) {
+    if (typeName.find("MoveAction") != std::string_view::npos) {
         return "MOVE";
-    } else if (std::string(typeName).find("TurnAction") != std::string::npos) {
+    } else if (typeName.find("TurnAction") != std::string_view::npos) {
         return "TURN";
     } else {
         return "UNKNOWN";
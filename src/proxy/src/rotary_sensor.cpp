@@ -1,7 +1,5 @@
 #include "micras/proxy/rotary_sensor.hpp"
 #include "constants.hpp"
-#include "physics/box2d_motor.hpp"
-#include "box2d/box2d.h"
 #include <random>
 
 namespace micras::proxy {
@@ -10,32 +8,35 @@ RotarySensor::RotarySensor(const Config& config) :
     micrasBody{config.micrasBody},
     resolution{config.resolution},
     noise{config.noise},
-    stopwatch{std::make_unique<Stopwatch>(Stopwatch::Config{})},
-    isLeftWheel{config.isLeftWheel} {
-    bodyId = micrasBody->getBodyId();
-}
-
-float RotarySensor::get_position() const {
-    auto modifiable = const_cast<RotarySensor*>(this);
+    stopwatch{std::make_unique<Stopwatch>(Stopwatch::Config{.micrasBody = config.micrasBody})},
+    isLeftWheel{config.isLeftWheel} { }
 
-    float angular_velocity = 0.0f;
+void RotarySensor::sample() {
     if (isLeftWheel) {
-        modifiable->global_position = micrasBody->getLeftMotor().getPosition();
+        global_position = micrasBody->leftWheelPosition;
     } else {
-        modifiable->global_position = micrasBody->getRightMotor().getPosition();
+        global_position = micrasBody->rightWheelPosition;
     }
 
-    micrasverse::types::Vec2 delta_position = modifiable->global_position - modifiable->last_global_position;
-    modifiable->last_global_position = modifiable->global_position;
+    micrasverse::types::Vec2 delta_position = global_position - last_global_position;
+    last_global_position = global_position;
 
-    auto  forward_direction = b2Rot_GetYAxis(b2Body_GetRotation(micrasBody->getBodyId()));
-    float distance_sign = b2Dot((b2Vec2){delta_position.x, delta_position.y}, forward_direction);
+    auto  forward_direction = micrasBody->getForwardDirection();
+    float distance_sign = delta_position.dot(forward_direction);
 
     float distance = std::copysignf(delta_position.length(), distance_sign);
 
-    modifiable->position += distance / micrasverse::MICRAS_WHEEL_RADIUS;
+    position += distance / micrasverse::MICRAS_WHEEL_RADIUS;
 
-    return modifiable->position;
+    if (isLeftWheel) {
+        micrasBody->sensorSample.leftRotaryPosition = position;
+    } else {
+        micrasBody->sensorSample.rightRotaryPosition = position;
+    }
+}
+
+float RotarySensor::get_position() const {
+    return position;
 }
 
 }  // namespace micras::proxy
@@ -1,4 +1,5 @@
 #include "micras/proxy/stopwatch.hpp"
+#include <cmath>
 #include <thread>
 
 namespace micras::proxy {
@@ -7,17 +8,27 @@ Stopwatch::Stopwatch() {
     this->reset_ms();
 }
 
-Stopwatch::Stopwatch(const Config& config) : looptime(config.looptime) {
+Stopwatch::Stopwatch(const Config& config) : micrasBody(config.micrasBody), looptime(config.looptime) {
     this->reset_ms();
 }
 
 void Stopwatch::reset_ms() {
-    this->start_time = std::chrono::steady_clock::now();
+    if (this->micrasBody != nullptr) {
+        this->start_simulated_time = this->micrasBody->simulatedTime;
+    } else {
+        this->start_time = std::chrono::steady_clock::now();
+    }
 }
 
 void Stopwatch::reset_us() { }
 
 uint32_t Stopwatch::elapsed_time_ms() const {
+    if (this->micrasBody != nullptr) {
+        // Rounded to whole microseconds first, so three 1 ms steps are 3 ms and not 2.999
+        const auto elapsed_us = std::llround((this->micrasBody->simulatedTime - this->start_simulated_time) * 1000000.0);
+        return static_cast<uint32_t>(elapsed_us / 1000);
+    }
+
     auto current_time = std::chrono::steady_clock::now();
     auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(current_time - this->start_time);
     return static_cast<uint32_t>(elapsed.count());
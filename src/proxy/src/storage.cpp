@@ -12,6 +12,10 @@
 namespace micras::proxy {
 
 Storage::Storage(const Config& config) : storage_path{config.storage_path} {
+    if (storage_path.empty()) {
+        return;
+    }
+
     // Create storage directory if it doesn't exist
     std::filesystem::create_directories(storage_path);
     this->load();
@@ -83,6 +87,10 @@ void Storage::save() {
     // Pad the buffer to be multiple of 8 bytes
     this->buffer.insert(this->buffer.end(), (8 - (this->buffer.size() % 8)) % 8, 0);
 
+    if (storage_path.empty()) {
+        return;
+    }
+
     // Write to file
     std::filesystem::path file_path = storage_path / "storage.bin";
     std::ofstream         file(file_path, std::ios::binary);
@@ -96,7 +104,7 @@ void Storage::save() {
 
 void Storage::load() {
     std::filesystem::path file_path = storage_path / "storage.bin";
-    if (!std::filesystem::exists(file_path)) {
+    if (storage_path.empty() || !std::filesystem::exists(file_path)) {
         return;
     }
 
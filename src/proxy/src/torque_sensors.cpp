@@ -2,6 +2,7 @@
 #define MICRAS_PROXY_TORQUE_SENSORS_CPP
 
 #include "micras/proxy/torque_sensors.hpp"
+#include "constants.hpp"
 #include <algorithm>
 
 namespace micras::proxy {
@@ -12,8 +13,8 @@ TTorqueSensors<num_of_sensors>::TTorqueSensors(const Config& config) :
     max_current{3.3f / config.shunt_resistor},  // Assuming 3.3V reference voltage
     max_torque{config.max_torque},
     noise{config.noise},
-    gen(rd()),
-    noise_dist(0.0f, noise) {
+    filters{config.filter_cutoff, 1.0f / micrasverse::STEP},
+    noise_dist{config.noise} {
     this->calibrate();
 }
 
@@ -21,26 +22,28 @@ template <uint8_t num_of_sensors>
 void TTorqueSensors<num_of_sensors>::calibrate() {
     for (uint8_t i = 0; i < num_of_sensors; i++) {
         this->base_reading[i] = 0.0f;
-        this->filtered_readings[i] = 0.0f;
+        this->sampled_torque[i] = 0.0f;
         this->simulated_torque[i] = 0.0f;
     }
+    this->filters.reset();
 }
 
 template <uint8_t num_of_sensors>
-void TTorqueSensors<num_of_sensors>::update() {
+void TTorqueSensors<num_of_sensors>::sample() {
     for (uint8_t i = 0; i < num_of_sensors; i++) {
         // Add noise to the simulated torque
-        float noisy_torque = this->simulated_torque[i] + this->noise_dist(this->gen);
-
-        // Simple low-pass filter
-        const float alpha = 0.1f;  // Filter coefficient
-        this->filtered_readings[i] = alpha * noisy_torque + (1.0f - alpha) * this->filtered_readings[i];
+        this->sampled_torque[i] = this->simulated_torque[i] + this->noise_dist.next();
     }
 }
 
+template <uint8_t num_of_sensors>
+void TTorqueSensors<num_of_sensors>::update() {
+    this->filters.update(this->sampled_torque);
+}
+
 template <uint8_t num_of_sensors>
 float TTorqueSensors<num_of_sensors>::get_torque(uint8_t sensor_index) const {
-    return this->filtered_readings.at(sensor_index);
+    return this->filters.get_last(sensor_index);
 }
 
 template <uint8_t num_of_sensors>
@@ -50,7 +53,7 @@ float TTorqueSensors<num_of_sensors>::get_torque_raw(uint8_t sensor_index) const
 
 template <uint8_t num_of_sensors>
 float TTorqueSensors<num_of_sensors>::get_current(uint8_t sensor_index) const {
-    return this->filtered_readings.at(sensor_index) / this->max_torque * this->max_current;
+    return this->filters.get_last(sensor_index) / this->max_torque * this->max_current;
 }
 
 template <uint8_t num_of_sensors>
@@ -60,7 +63,7 @@ float TTorqueSensors<num_of_sensors>::get_current_raw(uint8_t sensor_index) cons
 
 template <uint8_t num_of_sensors>
 float TTorqueSensors<num_of_sensors>::get_adc_reading(uint8_t sensor_index) const {
-    return this->filtered_readings.at(sensor_index) / this->max_torque;
+    return this->filters.get_last(sensor_index) / this->max_torque;
 }
 
 template <uint8_t num_of_sensors>
@@ -4,6 +4,7 @@
 #include "micras/proxy/wall_sensors.hpp"
 #include "micras/core/types.hpp"
 #include "micras/core/utils.hpp"
+#include "constants.hpp"
 
 namespace micras::proxy {
 
@@ -14,7 +15,7 @@ TWallSensors<num_of_sensors>::TWallSensors(const typename TWallSensors<num_of_se
     base_readings{config.base_readings},
     max_sensor_reading{config.max_sensor_reading},
     c{static_cast<float>(-std::pow(config.max_sensor_distance, 2) * std::log(1.0f - config.min_sensor_reading / config.max_sensor_reading))},
-    filters{core::make_array<core::ButterworthFilter, num_of_sensors>(config.filter_cutoff)} { }
+    filters{config.filter_cutoff, 1.0f / micrasverse::STEP} { }
 
 template <uint8_t num_of_sensors>
 TWallSensors<num_of_sensors>::~TWallSensors() { }
@@ -26,12 +27,20 @@ template <uint8_t num_of_sensors>
 void TWallSensors<num_of_sensors>::turn_off() { }
 
 template <uint8_t num_of_sensors>
-void TWallSensors<num_of_sensors>::update() {
+void TWallSensors<num_of_sensors>::sample() {
     for (uint8_t i = 0; i < num_of_sensors; i++) {
-        this->filters[i].update(this->get_adc_reading(i));
+        const float x = micrasBody->distanceReadings[i];
+        const float intensity = 1 / (x * x);
+        micrasBody->sensorSample.wallSensorAdcReadings[i] = max_sensor_reading * (1 - std::exp(-c * intensity));
     }
 }
 
+template <uint8_t num_of_sensors>
+void TWallSensors<num_of_sensors>::update() {
+    static_assert(num_of_sensors <= micrasverse::physics::DISTANCE_SENSOR_COUNT, "more wall sensors than distance sensor readings");
+    this->filters.update(std::span<const float, num_of_sensors>(micrasBody->sensorSample.wallSensorAdcReadings.data(), num_of_sensors));
+}
+
 template <uint8_t num_of_sensors>
 bool TWallSensors<num_of_sensors>::get_wall(uint8_t sensor_index, bool disturbed) const {
     float reading = this->get_reading(sensor_index);
@@ -42,16 +51,12 @@ bool TWallSensors<num_of_sensors>::get_wall(uint8_t sensor_index, bool disturbed
 
 template <uint8_t num_of_sensors>
 float TWallSensors<num_of_sensors>::get_reading(uint8_t sensor_index) const {
-    return this->filters.at(sensor_index).get_last();
+    return this->filters.get_last(sensor_index);
 }
 
 template <uint8_t num_of_sensors>
 float TWallSensors<num_of_sensors>::get_adc_reading(uint8_t sensor_index) const {
-    float x = micrasBody->getDistanceSensor(sensor_index).getReading();
-    float intensity = 1 / std::pow(x, 2);
-    float reading = max_sensor_reading * (1 - std::exp(-c * intensity));
-
-    return reading;
+    return micrasBody->sensorSample.wallSensorAdcReadings.at(sensor_index);
 }
 
 template <uint8_t num_of_sensors>
@@ -2,6 +2,7 @@
 #define PLOT_HPP
 
 #include "physics/box2d_micrasbody.hpp"
+#include "physics/box2d_distance_sensor.hpp"
 #include "micras/proxy/proxy_bridge.hpp"
 #include "micras/nav/grid_pose.hpp"
 #include "simulation/simulation_engine.hpp"
@@ -59,6 +60,8 @@ public:
     };
 
     struct PlotVariable {
+        static constexpr int MAX_POINTS = 2000;
+
         std::string      name;
         std::string      label;
         ImVector<ImVec2> data;
@@ -82,6 +85,9 @@ public:
 
     void setSimulationEngine(std::shared_ptr<simulation::SimulationEngine> simulationEngine) { this->simulationEngine = simulationEngine; }
 
+    // Appends one sample to every plot variable, what draw does each frame while the simulation runs
+    void sample(micrasverse::physics::Box2DMicrasBody& micrasBody, micras::ProxyBridge& proxyBridge);
+
     void destroy();
 
     bool  showPlots;
@@ -108,6 +114,9 @@ private:
     float                     t;
     bool                      variablesInitialized;
 
+    // Counters at the previous sample, the hit rate is plotted per sample interval
+    micrasverse::physics::RaycastCacheStats lastRaycastCacheStats;
+
     // Maze visualization data
     std::vector<int16_t> mazeCostData;
     float                mazeCostColorScale;
@@ -3,6 +3,8 @@
 #include "physics/box2d_distance_sensor.hpp"
 #include "implot.h"
 #include "implot3d.h"
+#include "micrasverse_core/profiler.hpp"
+#include "micrasverse_core/allocation_audit.hpp"
 
 #include <cmath>
 #include <algorithm>
@@ -20,7 +22,8 @@ static ImVec4 RandomColor() {
 
 Plot::PlotVariable::PlotVariable(const std::string& name, const std::string& label, const ImVec4& color) :
     name(name), label(label), color(color), selected(false) {
-    data.reserve(2000);
+    // One extra point, the newest is appended before the oldest is dropped
+    data.reserve(MAX_POINTS + 1);
 }
 
 Plot::ScrollingBuffer::ScrollingBuffer(int maxSize) {
@@ -320,6 +323,9 @@ void Plot::drawDragAndDrop(micrasverse::physics::Box2DMicrasBody& micrasBody, mi
 }
 
 void Plot::draw(micrasverse::physics::Box2DMicrasBody& micrasBody, micras::ProxyBridge& proxyBridge, bool simulationIsPaused) {
+    MICRASVERSE_PROFILE_ZONE("Plot::draw");
+    MICRASVERSE_ALLOCATION_PHASE(TELEMETRY);
+
     if (!showPlots) {
         return;
     }
@@ -525,7 +531,7 @@ void Plot::drawMazeCostHeatmap(micras::ProxyBridge& proxyBridge) {
     const int height = proxyBridge.get_maze_height();
 
     // Get costs from proxy bridge
-    mazeCostData = proxyBridge.get_maze_cell_costs();
+    proxyBridge.get_maze_cell_costs(mazeCostData);
 
     // Find min/max values for the colormap scaling
     int16_t dataMin = std::numeric_limits<int16_t>::max();
@@ -579,7 +585,7 @@ void Plot::drawMazeCost3DSurface(micras::ProxyBridge& proxyBridge) {
     const int height = proxyBridge.get_maze_height();
 
     if (mazeCostData.empty()) {
-        mazeCostData = proxyBridge.get_maze_cell_costs();
+        proxyBridge.get_maze_cell_costs(mazeCostData);
     }
 
     ImGui::Text("Maze Cost 3D Surface");
@@ -816,6 +822,7 @@ void Plot::initPlotVariables(micrasverse::physics::Box2DMicrasBody& micrasBody,
     plotVariables.push_back(PlotVariable("rightFeedForward", "Right Feed Forward Response", ImVec4(0.0f, 0.5f, 0.5f, 1.0f)));
     plotVariables.push_back(PlotVariable("linearIntegrative", "Linear Integrative Response", ImVec4(0.5f, 0.0f, 0.5f, 1.0f)));
     plotVariables.push_back(PlotVariable("angularIntegrative", "Angular Integrative Response", ImVec4(0.9f, 0.9f, 0.0f, 1.0f)));
+    plotVariables.push_back(PlotVariable("raycastCacheHitRate", "Raycast Cache Hit Rate (%)", ImVec4(0.6f, 0.3f, 0.9f, 1.0f)));
 
     // Default selected variables for each chart (to avoid empty charts initially)
     for (int i = 0; i < 5; i++) {
@@ -835,9 +842,21 @@ void Plot::initPlotVariables(micrasverse::physics::Box2DMicrasBody& micrasBody,
     variablesInitialized = true;
 }
 
+void Plot::sample(micrasverse::physics::Box2DMicrasBody& micrasBody, micras::ProxyBridge& proxyBridge) {
+    MICRASVERSE_ALLOCATION_PHASE(TELEMETRY);
+    initPlotVariables(micrasBody, proxyBridge);
+    updatePlotVariables(micrasBody, proxyBridge);
+}
+
 void Plot::updatePlotVariables(micrasverse::physics::Box2DMicrasBody& micrasBody, micras::ProxyBridge& proxyBridge) {
     t = this->simulationEngine->getElapsedRunTime();
 
+    const auto  raycastCacheStats = micrasBody.getRaycastCacheStats();
+    const auto  raycastCacheHits = raycastCacheStats.getHits() - this->lastRaycastCacheStats.getHits();
+    const auto  raycastCacheTotal = raycastCacheStats.getTotal() - this->lastRaycastCacheStats.getTotal();
+    const float raycastCacheHitRate = raycastCacheTotal == 0 ? 0.0f : 100.0f * raycastCacheHits / raycastCacheTotal;
+    this->lastRaycastCacheStats = raycastCacheStats;
+
     for (auto& var : plotVariables) {
         float value = 0.0f;
 
@@ -890,11 +909,13 @@ void Plot::updatePlotVariables(micrasverse::physics::Box2DMicrasBody& micrasBody
             value = proxyBridge.get_linear_integrative_response();
         else if (var.name == "angularIntegrative")
             value = proxyBridge.get_angular_integrative_response();
+        else if (var.name == "raycastCacheHitRate")
+            value = raycastCacheHitRate;
 
         var.data.push_back(ImVec2(t, value));
 
         // Limit data size
-        if (var.data.size() > 2000) {
+        if (var.data.size() > PlotVariable::MAX_POINTS) {
             var.data.erase(var.data.begin());
         }
     }
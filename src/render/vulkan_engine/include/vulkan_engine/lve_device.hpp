@@ -5,6 +5,7 @@
 #include <vulkan/vulkan.h>
 
 // std lib headers
+#include <filesystem>
 #include <string>
 #include <vector>
 
@@ -56,6 +57,12 @@ public:
 
     VkPhysicalDevice getPhysicalDevice() { return physicalDevice; }
 
+    // Seeded from the previous run and written back when the device is destroyed
+    VkPipelineCache getPipelineCache() { return pipelineCache; }
+
+    // Whether the pipeline cache was seeded from a blob compatible with this device
+    bool isPipelineCacheWarm() const { return pipelineCacheWarm; }
+
     uint32_t getGraphicsQueueFamily() { return findPhysicalQueueFamilies().graphicsFamily; }
 
     SwapChainSupportDetails getSwapChainSupport() { return querySwapChainSupport(physicalDevice); }
@@ -84,6 +91,8 @@ public:
     void pickPhysicalDevice();
     void createLogicalDevice();
     void createCommandPool();
+    void createPipelineCache();
+    void savePipelineCache();
 
     // helper functions
     bool                     isDeviceSuitable(VkPhysicalDevice device);
@@ -93,16 +102,22 @@ public:
     void                     populateDebugMessengerCreateInfo(VkDebugUtilsMessengerCreateInfoEXT& createInfo);
     void                     hasGflwRequiredInstanceExtensions();
     bool                     checkDeviceExtensionSupport(VkPhysicalDevice device);
+    std::vector<const char*> getDeviceExtensions();
     SwapChainSupportDetails  querySwapChainSupport(VkPhysicalDevice device);
+    bool                     isPipelineCacheCompatible(const std::vector<char>& data);
+
+    static std::filesystem::path getPipelineCachePath();
 
     VkInstance               instance;
     VkDebugUtilsMessengerEXT debugMessenger;
     VkPhysicalDevice         physicalDevice = VK_NULL_HANDLE;
     LveWindow&               window;
     VkCommandPool            commandPool;
+    VkPipelineCache          pipelineCache = VK_NULL_HANDLE;
+    bool                     pipelineCacheWarm = false;
 
     VkDevice     device_;
-    VkSurfaceKHR surface_;
+    VkSurfaceKHR surface_ = VK_NULL_HANDLE;
     VkQueue      graphicsQueue_;
     VkQueue      presentQueue_;
 
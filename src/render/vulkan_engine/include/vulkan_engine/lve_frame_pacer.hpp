@@ -0,0 +1,75 @@
+#pragma once
+
+// std
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace lve {
+
+// Caps how often frames are rendered and keeps statistics of the recent frame times.
+// When a frame is not due yet the loop can either skip rendering and keep stepping the simulation, or sleep until the
+// frame is due to pace frames evenly.
+class LveFramePacer {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    enum class Pacing : uint8_t {
+        SKIP,   // frames that are not due are skipped, the time goes to the simulation
+        SLEEP,  // waits until the frame is due, for even frame times
+    };
+
+    // Frame times kept for the percentiles by default
+    static constexpr size_t DEFAULT_HISTORY_SIZE = 1024;
+
+    explicit LveFramePacer(float targetFps = 0.0f, Pacing pacing = Pacing::SKIP);
+
+    // 0 renders every frame that is requested
+    void setTargetFps(float targetFps);
+
+    float getTargetFps() const { return targetFps; }
+
+    void setPacing(Pacing pacing) { this->pacing = pacing; }
+
+    Pacing getPacing() const { return pacing; }
+
+    // Whether a frame should be rendered now, may sleep depending on the pacing
+    bool shouldRenderFrame();
+
+    // Marks the start and end of the frame recording and submission, the render cost excluding pacing and vsync waits
+    void beginFrame();
+    void endFrame();
+
+    // Time between consecutive frames and CPU time spent rendering them, in milliseconds over the recent history
+    float getFrameIntervalPercentile(float percentile) const;
+    float getRenderTimePercentile(float percentile) const;
+
+    uint64_t getFrameCount() const { return frameCount; }
+
+    // Benchmarks keep every frame, the percentiles then cover the whole run
+    void setHistorySize(size_t historySize);
+
+    void resetStatistics();
+
+private:
+    void        record(std::vector<float>& history, float value) const;
+    float       percentile(const std::vector<float>& history, float percentile) const;
+
+    float             targetFps;
+    Pacing            pacing;
+    Clock::duration   frameInterval{};
+    Clock::time_point nextFrameTime;
+    Clock::time_point frameStartTime;
+    Clock::time_point lastFrameStartTime;
+    bool              hasLastFrame = false;
+    uint64_t          frameCount = 0;
+    size_t            historySize = DEFAULT_HISTORY_SIZE;
+
+    std::vector<float> frameIntervals;  // ring buffers indexed by frame count
+    std::vector<float> renderTimes;
+
+    mutable std::vector<float> sortedHistory;  // scratch for the percentiles, reserved once
+};
+
+}  // namespace lve
@@ -0,0 +1,67 @@
+#pragma once
+
+#include "vulkan_engine/lve_offscreen_target.hpp"
+
+// std
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <deque>
+#include <filesystem>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace lve {
+
+// Writes captured frames to disk on a background thread, so encoding and I/O never block the render loop
+class LveFrameWriter {
+public:
+    enum class Format : uint8_t {
+        IMAGE_SEQUENCE,  // one binary PPM per frame, frame_000000.ppm, ... inside the output directory
+        RAW_VIDEO,       // BGRA frames appended to a file or pipe, "-" is stdout, e.g. for ffmpeg -f rawvideo -pix_fmt bgra
+    };
+
+    // Frames queued at once, capturing blocks only when the writer falls this far behind
+    static constexpr size_t MAX_QUEUED_FRAMES = 8;
+
+    LveFrameWriter(std::filesystem::path outputPath, Format format);
+    ~LveFrameWriter();
+
+    LveFrameWriter(const LveFrameWriter&) = delete;
+    LveFrameWriter& operator=(const LveFrameWriter&) = delete;
+
+    // Copies the frame into a pooled buffer and queues it
+    void write(const CapturedFrame& frame);
+
+    uint64_t getWrittenFrames() const { return writtenFrames; }
+
+private:
+    struct QueuedFrame {
+        uint64_t             index;
+        uint32_t             width;
+        uint32_t             height;
+        std::vector<uint8_t> pixels;
+    };
+
+    void writerLoop();
+    void writeFrame(const QueuedFrame& frame);
+
+    std::filesystem::path outputPath;
+    Format                format;
+    std::FILE*            rawOutput = nullptr;
+    std::vector<uint8_t>  rowBuffer;
+
+    std::mutex                        queueMutex;
+    std::condition_variable           queueChanged;
+    std::deque<QueuedFrame>           queuedFrames;
+    std::vector<std::vector<uint8_t>> freeBuffers;  // pixel buffers of written frames, reused by the next ones
+    bool                              stopping = false;
+    std::atomic<uint64_t>             writtenFrames{0};
+    std::thread                       writerThread;
+};
+
+}  // namespace lve
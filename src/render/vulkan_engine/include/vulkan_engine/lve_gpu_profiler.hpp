@@ -0,0 +1,77 @@
+#pragma once
+
+#include "vulkan_engine/lve_device.hpp"
+#include "vulkan_engine/lve_swap_chain.hpp"
+
+// vulkan headers
+#include <vulkan/vulkan.h>
+
+// std
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+#include <vector>
+
+namespace lve {
+
+// Measures GPU time of named scopes inside a frame with timestamp queries.
+// Every frame in flight owns a range of the query pool, its results are read when the renderer reuses the frame slot,
+// after the slot's fence was waited on, so reading never stalls the CPU on the GPU.
+class LveGpuProfiler {
+public:
+    static constexpr uint32_t MAX_SCOPES = 16;    // per frame
+    static constexpr size_t   HISTORY_SIZE = 120;  // frames of history per scope
+
+    struct ScopeStats {
+        std::string_view                name;
+        float                           lastMilliseconds = 0.0f;
+        std::array<float, HISTORY_SIZE> history{};  // ring buffer, the oldest entry is at historyOffset
+        size_t                          historyOffset = 0;
+    };
+
+    LveGpuProfiler(LveDevice& device, uint32_t queueFamilyIndex);
+    ~LveGpuProfiler();
+
+    LveGpuProfiler(const LveGpuProfiler&) = delete;
+    LveGpuProfiler& operator=(const LveGpuProfiler&) = delete;
+
+    // The graphics queue of some drivers has no timestamp support, scopes are then ignored
+    bool isSupported() const { return queryPool != VK_NULL_HANDLE; }
+
+    // Reads the results of the slot's previous frame and resets its queries, outside of any render pass
+    void beginFrame(VkCommandBuffer commandBuffer, int frameIndex);
+
+    // Scope names must outlive the profiler, string literals in practice
+    uint32_t beginScope(VkCommandBuffer commandBuffer, std::string_view name);
+    void     endScope(VkCommandBuffer commandBuffer, uint32_t scope);
+
+    const std::vector<ScopeStats>& getScopeStats() const { return scopeStats; }
+
+private:
+    struct RecordedScope {
+        uint32_t statsIndex;
+        bool     ended;
+    };
+
+    struct FrameQueries {
+        std::vector<RecordedScope> scopes;
+    };
+
+    void     collectResults(int frameIndex);
+    uint32_t findOrAddScope(std::string_view name);
+
+    uint32_t firstQuery(int frameIndex, uint32_t scope) const { return (frameIndex * MAX_SCOPES + scope) * 2; }
+
+    LveDevice&  lveDevice;
+    VkQueryPool queryPool = VK_NULL_HANDLE;
+    float       timestampPeriod = 1.0f;  // nanoseconds per tick
+    uint64_t    timestampMask = ~0ull;
+
+    int                                                          currentFrameIndex = 0;
+    std::array<FrameQueries, LveSwapChain::MAX_FRAMES_IN_FLIGHT> frames;
+    std::vector<ScopeStats>                                      scopeStats;
+    std::vector<uint64_t>                                        results;  // timestamp and availability pairs
+};
+
+}  // namespace lve
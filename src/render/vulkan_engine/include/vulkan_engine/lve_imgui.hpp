@@ -1,10 +1,14 @@
 #pragma once
 
 #include "lve_device.hpp"
+#include "lve_frame_pacer.hpp"
+#include "lve_renderer.hpp"
 #include "lve_window.hpp"
 #include "simulation/simulation_engine.hpp"
 #include "plot/plot.hpp"
 #include "physics/box2d_micrasbody.hpp"
+#include "micrasverse_core/profiler.hpp"
+#include "micrasverse_core/allocation_audit.hpp"
 
 // libs
 #include <imgui.h>
@@ -12,8 +16,10 @@
 #include <imgui_impl_vulkan.h>
 
 // std
+#include <array>
 #include <stdexcept>
 #include <chrono>
+#include <string>
 #include <vector>
 #include <memory>
 
@@ -48,6 +54,7 @@ public:
     void setSimulationEngine(const std::shared_ptr<micrasverse::simulation::SimulationEngine>& simulationEngine);
     // void setRenderEngine(RenderEngine* renderEngine);
     void setProxyBridge(const std::shared_ptr<micras::ProxyBridge>& proxyBridge);
+    void setFrameControls(LveRenderer* renderer, LveFramePacer* framePacer);
     void init(GLFWwindow* window);
     void update();
     void draw(micrasverse::physics::Box2DMicrasBody& micrasBody);
@@ -56,9 +63,22 @@ public:
 
     bool isProxyBridgeInitialized() const { return proxyBridge != nullptr; }
 
+    // Timeline of the CPU zones recorded over the last span, one row per thread
+    void drawCpuProfiler();
+
+    // Heap allocations of every loop phase during the last frame
+    void drawAllocationAudit();
+
+    // Box2D memory of the current world by category, with the peaks since the world was created
+    void drawBox2DMemory();
+
     int physicsStepsPerFrame{40};
 
 private:
+    // Queued for the robot of the proxy bridge, applied at the start of the next simulation step. A full queue drops
+    // the command, which is logged and counted.
+    void sendCommand(const micrasverse::simulation::Command::Action& action);
+
     LveDevice&                                                 lveDevice;
     VkDescriptorPool                                           descriptorPool;
     bool                                                       showStyleEditor;
@@ -66,9 +86,20 @@ private:
     std::shared_ptr<micrasverse::simulation::SimulationEngine> simulationEngine;
     // RenderEngine*                                              renderEngine;
     std::shared_ptr<micras::ProxyBridge>  proxyBridge;
+    LveRenderer*                          renderer = nullptr;
+    LveFramePacer*                        framePacer = nullptr;
     micrasverse::render::Plot             plot;
     bool                                  buttonTimerActive = false;
     std::chrono::steady_clock::time_point buttonActivationTime;
     float                                 buttonDurations[3] = {0.5f, 1.5f, 3.0f};  // Duration in seconds for SHORT, LONG, EXTRA_LONG
+    size_t                                droppedCommands = 0;                      // commands the full queue turned away
+
+    bool                                          showCpuProfiler = false;
+    float                                         timelineSpan = 20.0f;  // milliseconds
+    uint64_t                                      timelineEnd = 0;       // paused timelines keep their last window
+    std::string                                   traceExportStatus;
+    std::vector<micrasverse::profiler::ZoneEvent> profilerEvents;  // reused between frames
+
+    std::array<micrasverse::allocation_audit::PhaseCounts, micrasverse::allocation_audit::PHASE_COUNT> lastAllocationCounts{};
 };
 }  // namespace lve
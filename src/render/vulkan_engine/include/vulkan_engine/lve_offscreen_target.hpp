@@ -0,0 +1,94 @@
+#pragma once
+
+#include "vulkan_engine/lve_device.hpp"
+#include "vulkan_engine/lve_swap_chain.hpp"
+
+// vulkan headers
+#include <vulkan/vulkan.h>
+
+// std lib headers
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+namespace lve {
+
+// Frame read back from an offscreen target, the pixels are only valid during the frame callback
+struct CapturedFrame {
+    uint64_t       index;
+    uint32_t       width;
+    uint32_t       height;
+    const uint8_t* pixels;  // tightly packed rows of BGRA8
+};
+
+// Render target without a window or swapchain, usable with software Vulkan drivers.
+// Every frame slot owns its color and depth images and a host visible staging buffer. The copy into the staging
+// buffer is recorded at the end of the frame, and the pixels are handed out when the slot comes around again and its
+// fence has already been waited on, so capturing never waits on the frame that was just submitted.
+class LveOffscreenTarget {
+public:
+    static constexpr int      MAX_FRAMES_IN_FLIGHT = LveSwapChain::MAX_FRAMES_IN_FLIGHT;
+    static constexpr VkFormat IMAGE_FORMAT = VK_FORMAT_B8G8R8A8_UNORM;  // same as the preferred swapchain format
+
+    using FrameCallback = std::function<void(const CapturedFrame&)>;
+
+    LveOffscreenTarget(LveDevice& deviceRef, VkExtent2D extent);
+    ~LveOffscreenTarget();
+
+    LveOffscreenTarget(const LveOffscreenTarget&) = delete;
+    LveOffscreenTarget& operator=(const LveOffscreenTarget&) = delete;
+
+    VkFramebuffer getFrameBuffer(int index) { return frames[index].framebuffer; }
+
+    VkRenderPass getRenderPass() { return renderPass; }
+
+    size_t imageCount() { return frames.size(); }
+
+    VkExtent2D getExtent() { return extent; }
+
+    float extentAspectRatio() { return static_cast<float>(extent.width) / static_cast<float>(extent.height); }
+
+    // Without a callback nothing is copied back to the host
+    void setFrameCallback(FrameCallback callback) { frameCallback = std::move(callback); }
+
+    VkResult acquireNextImage(uint32_t* imageIndex);
+    void     recordReadback(VkCommandBuffer commandBuffer, uint32_t imageIndex);
+    VkResult submitCommandBuffers(const VkCommandBuffer* buffers, uint32_t* imageIndex);
+
+    // Waits for the frames still in flight and hands them to the callback, oldest first
+    void flush();
+
+private:
+    struct Frame {
+        VkImage        colorImage = VK_NULL_HANDLE;
+        VkDeviceMemory colorImageMemory = VK_NULL_HANDLE;
+        VkImageView    colorImageView = VK_NULL_HANDLE;
+        VkImage        depthImage = VK_NULL_HANDLE;
+        VkDeviceMemory depthImageMemory = VK_NULL_HANDLE;
+        VkImageView    depthImageView = VK_NULL_HANDLE;
+        VkFramebuffer  framebuffer = VK_NULL_HANDLE;
+        VkBuffer       stagingBuffer = VK_NULL_HANDLE;
+        VkDeviceMemory stagingBufferMemory = VK_NULL_HANDLE;
+        void*          mappedPixels = nullptr;
+        VkFence        inFlightFence = VK_NULL_HANDLE;
+        bool           hasReadback = false;  // a copy was submitted and not handed out yet
+        uint64_t       index = 0;
+    };
+
+    void createRenderPass();
+    void createFrames();
+    void createImageView(VkImage image, VkFormat format, VkImageAspectFlags aspect, VkImageView& view);
+    void deliverReadback(Frame& frame);
+
+    LveDevice&         device;
+    VkExtent2D         extent;
+    VkFormat           depthFormat;
+    VkRenderPass       renderPass = VK_NULL_HANDLE;
+    std::vector<Frame> frames;
+    FrameCallback      frameCallback;
+    size_t             currentFrame = 0;
+    uint64_t           submittedFrames = 0;
+};
+
+}  // namespace lve
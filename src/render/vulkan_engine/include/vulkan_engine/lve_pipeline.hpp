@@ -3,6 +3,8 @@
 #include "vulkan_engine/lve_device.hpp"
 
 // std
+#include <cstdint>
+#include <span>
 #include <string>
 #include <vector>
 
@@ -30,6 +32,7 @@ struct PipelineConfigInfo {
 class LvePipeline {
 public:
     LvePipeline(LveDevice& device, const std::string& vertFilepath, const std::string& fragFilepath, const PipelineConfigInfo& configInfo);
+    LvePipeline(LveDevice& device, std::span<const uint32_t> vertCode, std::span<const uint32_t> fragCode, const PipelineConfigInfo& configInfo);
     ~LvePipeline();
 
     LvePipeline(const LvePipeline&) = delete;
@@ -42,9 +45,9 @@ public:
     // private:
     static std::vector<char> readFile(const std::string& filepath);
 
-    void createGraphicsPipeline(const std::string& vertFilepath, const std::string& fragFilepath, const PipelineConfigInfo& configInfo);
+    void createGraphicsPipeline(std::span<const uint32_t> vertCode, std::span<const uint32_t> fragCode, const PipelineConfigInfo& configInfo);
 
-    void createShaderModule(const std::vector<char>& code, VkShaderModule* shaderModule);
+    void createShaderModule(std::span<const uint32_t> code, VkShaderModule* shaderModule);
 
     LveDevice&     lveDevice;
     VkPipeline     graphicsPipeline;
@@ -1,6 +1,8 @@
 #pragma once
 
 #include "vulkan_engine/lve_device.hpp"
+#include "vulkan_engine/lve_gpu_profiler.hpp"
+#include "vulkan_engine/lve_offscreen_target.hpp"
 #include "vulkan_engine/lve_swap_chain.hpp"
 #include "vulkan_engine/lve_window.hpp"
 
@@ -18,11 +20,25 @@ public:
     LveRenderer(const LveRenderer&) = delete;
     LveRenderer& operator=(const LveRenderer&) = delete;
 
-    VkRenderPass getSwapChainRenderPass() const { return lveSwapChain->getRenderPass(); }
+    VkRenderPass getSwapChainRenderPass() const {
+        return offscreenTarget ? offscreenTarget->getRenderPass() : lveSwapChain->getRenderPass();
+    }
+
+    uint32_t getImageCount() const {
+        return static_cast<uint32_t>(offscreenTarget ? offscreenTarget->imageCount() : lveSwapChain->imageCount());
+    }
+
+    float getAspectRatio() const { return offscreenTarget ? offscreenTarget->extentAspectRatio() : lveSwapChain->extentAspectRatio(); }
+
+    VkPresentModeKHR getPresentMode() const { return lveSwapChain ? lveSwapChain->getPresentMode() : preferredPresentMode; }
+
+    // Recreates the swapchain right away, or at the end of the frame in progress
+    void setPresentMode(VkPresentModeKHR presentMode);
 
-    uint32_t getImageCount() const { return lveSwapChain->imageCount(); }
+    LveGpuProfiler& getGpuProfiler() const { return *gpuProfiler; }
 
-    float getAspectRatio() const { return lveSwapChain->extentAspectRatio(); }
+    // Only set when the window is headless, frames are then rendered into it instead of the swapchain
+    LveOffscreenTarget* getOffscreenTarget() const { return offscreenTarget.get(); }
 
     bool isFrameInProgress() const { return isFrameStarted; }
 
@@ -42,17 +58,22 @@ public:
     void            endSwapChainRenderPass(VkCommandBuffer commandBuffer);
 
     //  private:
-    void createCommandBuffers();
+    VkCommandBuffer beginCommandBuffer();
+    void            createCommandBuffers();
     void freeCommandBuffers();
     void recreateSwapChain();
 
     LveWindow&                    lveWindow;
     LveDevice&                    lveDevice;
-    std::unique_ptr<LveSwapChain> lveSwapChain;
-    std::vector<VkCommandBuffer>  commandBuffers;
+    std::unique_ptr<LveSwapChain>       lveSwapChain;
+    std::unique_ptr<LveOffscreenTarget> offscreenTarget;
+    std::unique_ptr<LveGpuProfiler>     gpuProfiler;
+    std::vector<VkCommandBuffer>        commandBuffers;
 
-    uint32_t currentImageIndex;
-    int      currentFrameIndex{0};
-    bool     isFrameStarted{false};
+    uint32_t         currentImageIndex;
+    int              currentFrameIndex{0};
+    bool             isFrameStarted{false};
+    VkPresentModeKHR preferredPresentMode{VK_PRESENT_MODE_MAILBOX_KHR};
+    bool             presentModeChanged{false};
 };
 }  // namespace lve
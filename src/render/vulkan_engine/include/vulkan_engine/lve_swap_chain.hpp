@@ -16,8 +16,12 @@ class LveSwapChain {
 public:
     static constexpr int MAX_FRAMES_IN_FLIGHT = 2;
 
-    LveSwapChain(LveDevice& deviceRef, VkExtent2D windowExtent);
-    LveSwapChain(LveDevice& deviceRef, VkExtent2D windowExtent, std::shared_ptr<LveSwapChain> previous);
+    // Falls back to FIFO, the only mode every driver supports, when the preferred present mode is not available
+    LveSwapChain(LveDevice& deviceRef, VkExtent2D windowExtent, VkPresentModeKHR preferredPresentMode = VK_PRESENT_MODE_MAILBOX_KHR);
+    LveSwapChain(
+        LveDevice& deviceRef, VkExtent2D windowExtent, std::shared_ptr<LveSwapChain> previous,
+        VkPresentModeKHR preferredPresentMode = VK_PRESENT_MODE_MAILBOX_KHR
+    );
 
     ~LveSwapChain();
 
@@ -36,6 +40,10 @@ public:
 
     VkExtent2D getSwapChainExtent() { return swapChainExtent; }
 
+    VkPresentModeKHR getPresentMode() const { return presentMode; }
+
+    static const char* getPresentModeName(VkPresentModeKHR presentMode);
+
     uint32_t width() { return swapChainExtent.width; }
 
     uint32_t height() { return swapChainExtent.height; }
@@ -65,9 +73,11 @@ private:
     VkPresentModeKHR   chooseSwapPresentMode(const std::vector<VkPresentModeKHR>& availablePresentModes);
     VkExtent2D         chooseSwapExtent(const VkSurfaceCapabilitiesKHR& capabilities);
 
-    VkFormat   swapChainImageFormat;
-    VkFormat   swapChainDepthFormat;
-    VkExtent2D swapChainExtent;
+    VkFormat         swapChainImageFormat;
+    VkFormat         swapChainDepthFormat;
+    VkExtent2D       swapChainExtent;
+    VkPresentModeKHR preferredPresentMode;
+    VkPresentModeKHR presentMode;
 
     std::vector<VkFramebuffer> swapChainFramebuffers;
     VkRenderPass               renderPass;
@@ -9,13 +9,16 @@ namespace lve {
 
 class LveWindow {
 public:
-    LveWindow(int w, int h, std::string name);
+    // A headless window has no GLFW window or surface, frames are rendered offscreen
+    LveWindow(int w, int h, std::string name, bool headless = false);
     ~LveWindow();
 
     LveWindow(const LveWindow&) = delete;
     LveWindow& operator=(const LveWindow&) = delete;
 
-    bool shouldClose() { return glfwWindowShouldClose(window); }
+    bool shouldClose() { return window != nullptr && glfwWindowShouldClose(window); }
+
+    bool isHeadless() const { return window == nullptr; }
 
     VkExtent2D getExtent() { return {static_cast<uint32_t>(width), static_cast<uint32_t>(height)}; }
 
@@ -23,19 +26,27 @@ public:
 
     void resetWindowResizedFlag() { framebufferResized = false; }
 
+    // Any input or window event since the last reset, or a key or mouse button still held down
+    bool wasInputReceived() { return inputReceived || pressedInputs > 0; }
+
+    void resetInputReceivedFlag() { inputReceived = false; }
+
     GLFWwindow* getGLFWwindow() const { return window; }
 
     void createWindowSurface(VkInstance instance, VkSurfaceKHR* surface);
 
     // private:
     static void framebufferResizeCallback(GLFWwindow* window, int width, int height);
+    static void markInputReceived(GLFWwindow* window, int pressedDelta = 0);
     void        initWindow();
 
     int  width;
     int  height;
     bool framebufferResized = false;
+    bool inputReceived = true;
+    int  pressedInputs = 0;
 
     std::string windowName;
-    GLFWwindow* window;
+    GLFWwindow* window = nullptr;
 };
 }  // namespace lve
@@ -15,6 +15,7 @@
 #include <memory>
 #include <vector>
 #include <chrono>
+#include <cstdint>
 #include <unordered_set>
 
 namespace lve {
@@ -23,7 +24,8 @@ public:
     static constexpr int WIDTH = 800;
     static constexpr int HEIGHT = 600;
 
-    VulkanEngine(std::shared_ptr<micrasverse::simulation::SimulationEngine> engine);
+    // A headless engine renders into an offscreen target instead of a window
+    VulkanEngine(std::shared_ptr<micrasverse::simulation::SimulationEngine> engine, bool headless = false);
     ~VulkanEngine();
 
     VulkanEngine(const VulkanEngine&) = delete;
@@ -36,6 +38,8 @@ public:
     void loadGameObjects();
     void loadMazeFloor();
     void loadMazeWalls();
+
+    // Keeps the walls the new maze still has and only creates or removes the ones that changed
     void reloadMazeWalls();
     void loadFirmwareMazeWalls();
     void loadBestRoute();
@@ -45,6 +49,8 @@ public:
 
     void updateRenderableModels();
 
+    LveGameObject createWallObject(const micrasverse::physics::Maze::Element& wall);
+
     void setProxyBridge(std::shared_ptr<micras::ProxyBridge> proxyBridge) { this->proxyBridge = proxyBridge; }
 
     LveWindow                                                  lveWindow{WIDTH, HEIGHT, "Micrasverse"};
@@ -68,8 +74,11 @@ public:
     std::unordered_set<micras::nav::GridPose>  walls_set;
     std::unordered_set<micras::nav::GridPoint> best_route_set;
 
-    int first_wall_index{0};
-    int number_of_walls{0};
+    int                       first_wall_index{0};
+    int                       number_of_walls{0};  // maze walls only, the floor comes right after them
+    std::vector<uint64_t>     wall_keys;           // maze element key of every wall, in the order of the wall objects
+    std::shared_ptr<LveModel> wallModel;
+    int                       number_of_firmware_walls{0};
 
     int                     first_route_marker_index{0};
     int                     number_of_route_markers{0};
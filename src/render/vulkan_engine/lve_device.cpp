@@ -1,7 +1,9 @@
 #include "vulkan_engine/lve_device.hpp"
 
 // std headers
+#include <cstdlib>
 #include <cstring>
+#include <fstream>
 #include <iostream>
 #include <set>
 #include <unordered_set>
@@ -45,9 +47,12 @@ LveDevice::LveDevice(LveWindow& window) : window{window} {
     pickPhysicalDevice();
     createLogicalDevice();
     createCommandPool();
+    createPipelineCache();
 }
 
 LveDevice::~LveDevice() {
+    savePipelineCache();
+    vkDestroyPipelineCache(device_, pipelineCache, nullptr);
     vkDestroyCommandPool(device_, commandPool, nullptr);
     vkDestroyDevice(device_, nullptr);
 
@@ -55,7 +60,9 @@ LveDevice::~LveDevice() {
         DestroyDebugUtilsMessengerEXT(instance, debugMessenger, nullptr);
     }
 
-    vkDestroySurfaceKHR(instance, surface_, nullptr);
+    if (surface_ != VK_NULL_HANDLE) {
+        vkDestroySurfaceKHR(instance, surface_, nullptr);
+    }
     vkDestroyInstance(instance, nullptr);
 }
 
@@ -149,9 +156,10 @@ void LveDevice::createLogicalDevice() {
     createInfo.queueCreateInfoCount = static_cast<uint32_t>(queueCreateInfos.size());
     createInfo.pQueueCreateInfos = queueCreateInfos.data();
 
+    const std::vector<const char*> extensions = getDeviceExtensions();
     createInfo.pEnabledFeatures = &deviceFeatures;
-    createInfo.enabledExtensionCount = static_cast<uint32_t>(deviceExtensions.size());
-    createInfo.ppEnabledExtensionNames = deviceExtensions.data();
+    createInfo.enabledExtensionCount = static_cast<uint32_t>(extensions.size());
+    createInfo.ppEnabledExtensionNames = extensions.data();
 
     // might not really be necessary anymore because device specific validation layers
     // have been deprecated
@@ -184,6 +192,11 @@ void LveDevice::createCommandPool() {
 }
 
 void LveDevice::createSurface() {
+    // Offscreen rendering has nothing to present to
+    if (window.isHeadless()) {
+        return;
+    }
+
     window.createWindowSurface(instance, &surface_);
 }
 
@@ -192,8 +205,8 @@ bool LveDevice::isDeviceSuitable(VkPhysicalDevice device) {
 
     bool extensionsSupported = checkDeviceExtensionSupport(device);
 
-    bool swapChainAdequate = false;
-    if (extensionsSupported) {
+    bool swapChainAdequate = window.isHeadless();
+    if (extensionsSupported && !window.isHeadless()) {
         SwapChainSupportDetails swapChainSupport = querySwapChainSupport(device);
         swapChainAdequate = !swapChainSupport.formats.empty() && !swapChainSupport.presentModes.empty();
     }
@@ -250,11 +263,14 @@ bool LveDevice::checkValidationLayerSupport() {
 }
 
 std::vector<const char*> LveDevice::getRequiredExtensions() {
-    uint32_t     glfwExtensionCount = 0;
-    const char** glfwExtensions;
-    glfwExtensions = glfwGetRequiredInstanceExtensions(&glfwExtensionCount);
+    std::vector<const char*> extensions;
 
-    std::vector<const char*> extensions(glfwExtensions, glfwExtensions + glfwExtensionCount);
+    // Without a window GLFW isn't initialized and no surface extensions are needed
+    if (!window.isHeadless()) {
+        uint32_t     glfwExtensionCount = 0;
+        const char** glfwExtensions = glfwGetRequiredInstanceExtensions(&glfwExtensionCount);
+        extensions.assign(glfwExtensions, glfwExtensions + glfwExtensionCount);
+    }
 
     if (enableValidationLayers) {
         extensions.push_back(VK_EXT_DEBUG_UTILS_EXTENSION_NAME);
@@ -293,7 +309,8 @@ bool LveDevice::checkDeviceExtensionSupport(VkPhysicalDevice device) {
     std::vector<VkExtensionProperties> availableExtensions(extensionCount);
     vkEnumerateDeviceExtensionProperties(device, nullptr, &extensionCount, availableExtensions.data());
 
-    std::set<std::string> requiredExtensions(deviceExtensions.begin(), deviceExtensions.end());
+    const std::vector<const char*> deviceExtensions = getDeviceExtensions();
+    std::set<std::string>          requiredExtensions(deviceExtensions.begin(), deviceExtensions.end());
 
     for (const auto& extension : availableExtensions) {
         requiredExtensions.erase(extension.extensionName);
@@ -302,6 +319,14 @@ bool LveDevice::checkDeviceExtensionSupport(VkPhysicalDevice device) {
     return requiredExtensions.empty();
 }
 
+std::vector<const char*> LveDevice::getDeviceExtensions() {
+    if (window.isHeadless()) {
+        return {};
+    }
+
+    return deviceExtensions;
+}
+
 QueueFamilyIndices LveDevice::findQueueFamilies(VkPhysicalDevice device) {
     QueueFamilyIndices indices;
 
@@ -317,8 +342,13 @@ QueueFamilyIndices LveDevice::findQueueFamilies(VkPhysicalDevice device) {
             indices.graphicsFamily = i;
             indices.graphicsFamilyHasValue = true;
         }
+        // Offscreen frames never get presented, the graphics queue stands in for the present queue
         VkBool32 presentSupport = false;
-        vkGetPhysicalDeviceSurfaceSupportKHR(device, i, surface_, &presentSupport);
+        if (surface_ == VK_NULL_HANDLE) {
+            presentSupport = indices.graphicsFamilyHasValue && indices.graphicsFamily == static_cast<uint32_t>(i);
+        } else {
+            vkGetPhysicalDeviceSurfaceSupportKHR(device, i, surface_, &presentSupport);
+        }
         if (queueFamily.queueCount > 0 && presentSupport) {
             indices.presentFamily = i;
             indices.presentFamilyHasValue = true;
@@ -497,4 +527,86 @@ void LveDevice::createImageWithInfo(
     }
 }
 
+std::filesystem::path LveDevice::getPipelineCachePath() {
+#ifdef _WIN32
+    const char* cacheHome = std::getenv("LOCALAPPDATA");
+    if (cacheHome != nullptr) {
+        return std::filesystem::path{cacheHome} / "micrasverse" / "pipeline_cache.bin";
+    }
+#else
+    const char* cacheHome = std::getenv("XDG_CACHE_HOME");
+    if (cacheHome != nullptr && cacheHome[0] != '\0') {
+        return std::filesystem::path{cacheHome} / "micrasverse" / "pipeline_cache.bin";
+    }
+
+    const char* home = std::getenv("HOME");
+    if (home != nullptr) {
+        return std::filesystem::path{home} / ".cache" / "micrasverse" / "pipeline_cache.bin";
+    }
+#endif
+
+    return std::filesystem::temp_directory_path() / "micrasverse_pipeline_cache.bin";
+}
+
+bool LveDevice::isPipelineCacheCompatible(const std::vector<char>& data) {
+    // Drivers are allowed to reject or even misbehave on blobs from another device or driver version
+    VkPipelineCacheHeaderVersionOne header{};
+    if (data.size() < sizeof(header)) {
+        return false;
+    }
+
+    std::memcpy(&header, data.data(), sizeof(header));
+    return header.headerSize >= sizeof(header) && header.headerVersion == VK_PIPELINE_CACHE_HEADER_VERSION_ONE &&
+           header.vendorID == properties.vendorID && header.deviceID == properties.deviceID &&
+           std::memcmp(header.pipelineCacheUUID, properties.pipelineCacheUUID, VK_UUID_SIZE) == 0;
+}
+
+void LveDevice::createPipelineCache() {
+    std::vector<char> data;
+
+    std::ifstream file{getPipelineCachePath(), std::ios::ate | std::ios::binary};
+    if (file.is_open()) {
+        data.resize(static_cast<size_t>(file.tellg()));
+        file.seekg(0);
+        file.read(data.data(), static_cast<std::streamsize>(data.size()));
+    }
+
+    pipelineCacheWarm = file.good() && isPipelineCacheCompatible(data);
+
+    VkPipelineCacheCreateInfo cacheInfo{};
+    cacheInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_CACHE_CREATE_INFO;
+    cacheInfo.initialDataSize = pipelineCacheWarm ? data.size() : 0;
+    cacheInfo.pInitialData = pipelineCacheWarm ? data.data() : nullptr;
+
+    if (vkCreatePipelineCache(device_, &cacheInfo, nullptr, &pipelineCache) != VK_SUCCESS) {
+        throw std::runtime_error("failed to create pipeline cache!");
+    }
+}
+
+void LveDevice::savePipelineCache() {
+    size_t dataSize = 0;
+    if (vkGetPipelineCacheData(device_, pipelineCache, &dataSize, nullptr) != VK_SUCCESS || dataSize == 0) {
+        return;
+    }
+
+    std::vector<char> data(dataSize);
+    if (vkGetPipelineCacheData(device_, pipelineCache, &dataSize, data.data()) != VK_SUCCESS) {
+        return;
+    }
+
+    // Written next to the final file and renamed, so an interrupted run never leaves a truncated cache behind
+    const std::filesystem::path path = getPipelineCachePath();
+    const std::filesystem::path temporaryPath = path.string() + ".tmp";
+    std::error_code             error;
+    std::filesystem::create_directories(path.parent_path(), error);
+
+    std::ofstream file{temporaryPath, std::ios::binary | std::ios::trunc};
+    if (!file.write(data.data(), static_cast<std::streamsize>(dataSize))) {
+        return;
+    }
+    file.close();
+
+    std::filesystem::rename(temporaryPath, path, error);
+}
+
 }  // namespace lve
@@ -0,0 +1,118 @@
+#include "vulkan_engine/lve_frame_pacer.hpp"
+
+// std
+#include <algorithm>
+#include <cmath>
+#include <thread>
+
+namespace lve {
+
+namespace {
+
+// The OS timer may oversleep by up to a scheduler tick, the rest of the wait is spent yielding
+constexpr auto SLEEP_MARGIN = std::chrono::milliseconds(2);
+
+}  // namespace
+
+LveFramePacer::LveFramePacer(float targetFps, Pacing pacing) : pacing{pacing} {
+    setTargetFps(targetFps);
+    setHistorySize(DEFAULT_HISTORY_SIZE);
+}
+
+void LveFramePacer::setHistorySize(size_t historySize) {
+    this->historySize = std::max<size_t>(historySize, 1);
+    resetStatistics();
+    frameIntervals.reserve(this->historySize);
+    renderTimes.reserve(this->historySize);
+    sortedHistory.reserve(this->historySize);
+}
+
+void LveFramePacer::setTargetFps(float targetFps) {
+    this->targetFps = std::max(targetFps, 0.0f);
+    frameInterval = (this->targetFps > 0.0f) ? std::chrono::duration_cast<Clock::duration>(std::chrono::duration<float>(1.0f / this->targetFps))
+                                             : Clock::duration::zero();
+    nextFrameTime = Clock::now();
+}
+
+bool LveFramePacer::shouldRenderFrame() {
+    if (frameInterval == Clock::duration::zero()) {
+        return true;
+    }
+
+    auto now = Clock::now();
+    if (now < nextFrameTime) {
+        if (pacing == Pacing::SKIP) {
+            return false;
+        }
+
+        if (nextFrameTime - now > SLEEP_MARGIN) {
+            std::this_thread::sleep_until(nextFrameTime - SLEEP_MARGIN);
+        }
+        while (Clock::now() < nextFrameTime) {
+            std::this_thread::yield();
+        }
+        now = Clock::now();
+    }
+
+    // Stays on the frame grid, unless so far behind that catching up would render a burst of frames
+    nextFrameTime += frameInterval;
+    if (nextFrameTime < now) {
+        nextFrameTime = now + frameInterval;
+    }
+
+    return true;
+}
+
+void LveFramePacer::beginFrame() {
+    frameStartTime = Clock::now();
+
+    if (hasLastFrame) {
+        record(frameIntervals, std::chrono::duration<float, std::milli>(frameStartTime - lastFrameStartTime).count());
+    }
+
+    lastFrameStartTime = frameStartTime;
+    hasLastFrame = true;
+}
+
+void LveFramePacer::endFrame() {
+    record(renderTimes, std::chrono::duration<float, std::milli>(Clock::now() - frameStartTime).count());
+    frameCount++;
+}
+
+float LveFramePacer::getFrameIntervalPercentile(float percentile) const {
+    return this->percentile(frameIntervals, percentile);
+}
+
+float LveFramePacer::getRenderTimePercentile(float percentile) const {
+    return this->percentile(renderTimes, percentile);
+}
+
+void LveFramePacer::resetStatistics() {
+    frameIntervals.clear();
+    renderTimes.clear();
+    hasLastFrame = false;
+    frameCount = 0;
+}
+
+void LveFramePacer::record(std::vector<float>& history, float value) const {
+    if (history.size() < historySize) {
+        history.push_back(value);
+    } else {
+        history[frameCount % historySize] = value;
+    }
+}
+
+float LveFramePacer::percentile(const std::vector<float>& history, float percentile) const {
+    if (history.empty()) {
+        return 0.0f;
+    }
+
+    // Nearest rank
+    sortedHistory.assign(history.begin(), history.end());
+    const size_t rank = static_cast<size_t>(std::ceil(percentile / 100.0f * sortedHistory.size()));
+    const size_t index = std::clamp<size_t>(rank, 1, sortedHistory.size()) - 1;
+    std::nth_element(sortedHistory.begin(), sortedHistory.begin() + index, sortedHistory.end());
+    return sortedHistory[index];
+}
+
+}  // namespace lve
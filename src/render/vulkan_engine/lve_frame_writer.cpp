@@ -0,0 +1,121 @@
+#include "vulkan_engine/lve_frame_writer.hpp"
+
+// std
+#include <array>
+#include <cstring>
+#include <stdexcept>
+#include <utility>
+
+namespace lve {
+
+LveFrameWriter::LveFrameWriter(std::filesystem::path outputPath, Format format) : outputPath{std::move(outputPath)}, format{format} {
+    if (format == Format::IMAGE_SEQUENCE) {
+        std::filesystem::create_directories(this->outputPath);
+    } else if (this->outputPath == "-") {
+        rawOutput = stdout;
+    } else {
+        rawOutput = std::fopen(this->outputPath.string().c_str(), "wb");
+        if (rawOutput == nullptr) {
+            throw std::runtime_error("failed to open capture output " + this->outputPath.string());
+        }
+    }
+
+    writerThread = std::thread(&LveFrameWriter::writerLoop, this);
+}
+
+LveFrameWriter::~LveFrameWriter() {
+    {
+        std::lock_guard<std::mutex> lock(queueMutex);
+        stopping = true;
+    }
+    queueChanged.notify_all();
+    writerThread.join();
+
+    if (rawOutput != nullptr && rawOutput != stdout) {
+        std::fclose(rawOutput);
+    } else if (rawOutput == stdout) {
+        std::fflush(stdout);
+    }
+}
+
+void LveFrameWriter::write(const CapturedFrame& frame) {
+    const size_t frameSize = static_cast<size_t>(frame.width) * frame.height * 4;
+
+    std::vector<uint8_t> pixels;
+    {
+        std::unique_lock<std::mutex> lock(queueMutex);
+        queueChanged.wait(lock, [this] { return queuedFrames.size() < MAX_QUEUED_FRAMES; });
+
+        if (!freeBuffers.empty()) {
+            pixels = std::move(freeBuffers.back());
+            freeBuffers.pop_back();
+        }
+    }
+
+    // The staging memory is reused by the next frame, so the copy happens before returning
+    pixels.resize(frameSize);
+    std::memcpy(pixels.data(), frame.pixels, frameSize);
+
+    {
+        std::lock_guard<std::mutex> lock(queueMutex);
+        queuedFrames.push_back({frame.index, frame.width, frame.height, std::move(pixels)});
+    }
+    queueChanged.notify_all();
+}
+
+void LveFrameWriter::writerLoop() {
+    while (true) {
+        QueuedFrame frame;
+        {
+            std::unique_lock<std::mutex> lock(queueMutex);
+            queueChanged.wait(lock, [this] { return stopping || !queuedFrames.empty(); });
+
+            if (queuedFrames.empty()) {
+                return;
+            }
+
+            frame = std::move(queuedFrames.front());
+            queuedFrames.pop_front();
+        }
+        queueChanged.notify_all();
+
+        writeFrame(frame);
+
+        std::lock_guard<std::mutex> lock(queueMutex);
+        freeBuffers.push_back(std::move(frame.pixels));
+        writtenFrames++;
+    }
+}
+
+void LveFrameWriter::writeFrame(const QueuedFrame& frame) {
+    if (format == Format::RAW_VIDEO) {
+        std::fwrite(frame.pixels.data(), 1, frame.pixels.size(), rawOutput);
+        return;
+    }
+
+    std::array<char, 32> fileName{};
+    std::snprintf(fileName.data(), fileName.size(), "frame_%06llu.ppm", static_cast<unsigned long long>(frame.index));
+
+    std::FILE* file = std::fopen((outputPath / fileName.data()).string().c_str(), "wb");
+    if (file == nullptr) {
+        return;
+    }
+
+    std::fprintf(file, "P6\n%u %u\n255\n", frame.width, frame.height);
+
+    // PPM stores RGB, the captured rows are BGRA
+    rowBuffer.resize(static_cast<size_t>(frame.width) * 3);
+    for (uint32_t y = 0; y < frame.height; y++) {
+        const uint8_t* row = frame.pixels.data() + static_cast<size_t>(y) * frame.width * 4;
+        for (uint32_t x = 0; x < frame.width; x++) {
+            rowBuffer[x * 3 + 0] = row[x * 4 + 2];
+            rowBuffer[x * 3 + 1] = row[x * 4 + 1];
+            rowBuffer[x * 3 + 2] = row[x * 4 + 0];
+        }
+        std::fwrite(rowBuffer.data(), 1, rowBuffer.size(), file);
+    }
+
+    std::fclose(file);
+}
+
+}  // namespace lve
@@ -0,0 +1,121 @@
+#include "vulkan_engine/lve_gpu_profiler.hpp"
+
+// std
+#include <stdexcept>
+
+namespace lve {
+
+LveGpuProfiler::LveGpuProfiler(LveDevice& device, uint32_t queueFamilyIndex) : lveDevice{device} {
+    uint32_t queueFamilyCount = 0;
+    vkGetPhysicalDeviceQueueFamilyProperties(lveDevice.getPhysicalDevice(), &queueFamilyCount, nullptr);
+    std::vector<VkQueueFamilyProperties> queueFamilies(queueFamilyCount);
+    vkGetPhysicalDeviceQueueFamilyProperties(lveDevice.getPhysicalDevice(), &queueFamilyCount, queueFamilies.data());
+
+    const uint32_t validBits = queueFamilyIndex < queueFamilyCount ? queueFamilies[queueFamilyIndex].timestampValidBits : 0;
+    if (validBits == 0 || lveDevice.properties.limits.timestampPeriod == 0.0f) {
+        return;
+    }
+
+    timestampPeriod = lveDevice.properties.limits.timestampPeriod;
+    timestampMask = (validBits >= 64) ? ~0ull : ((1ull << validBits) - 1);
+
+    const uint32_t queryCount = LveSwapChain::MAX_FRAMES_IN_FLIGHT * MAX_SCOPES * 2;
+
+    VkQueryPoolCreateInfo queryPoolInfo{};
+    queryPoolInfo.sType = VK_STRUCTURE_TYPE_QUERY_POOL_CREATE_INFO;
+    queryPoolInfo.queryType = VK_QUERY_TYPE_TIMESTAMP;
+    queryPoolInfo.queryCount = queryCount;
+
+    if (vkCreateQueryPool(lveDevice.device(), &queryPoolInfo, nullptr, &queryPool) != VK_SUCCESS) {
+        throw std::runtime_error("failed to create timestamp query pool!");
+    }
+
+    for (auto& frame : frames) {
+        frame.scopes.reserve(MAX_SCOPES);
+    }
+    scopeStats.reserve(MAX_SCOPES);
+    results.resize(MAX_SCOPES * 2 * 2);
+}
+
+LveGpuProfiler::~LveGpuProfiler() {
+    if (queryPool != VK_NULL_HANDLE) {
+        vkDestroyQueryPool(lveDevice.device(), queryPool, nullptr);
+    }
+}
+
+void LveGpuProfiler::beginFrame(VkCommandBuffer commandBuffer, int frameIndex) {
+    if (!isSupported()) {
+        return;
+    }
+
+    collectResults(frameIndex);
+
+    currentFrameIndex = frameIndex;
+    frames[frameIndex].scopes.clear();
+    vkCmdResetQueryPool(commandBuffer, queryPool, firstQuery(frameIndex, 0), MAX_SCOPES * 2);
+}
+
+uint32_t LveGpuProfiler::beginScope(VkCommandBuffer commandBuffer, std::string_view name) {
+    auto& scopes = frames[currentFrameIndex].scopes;
+    if (!isSupported() || scopes.size() >= MAX_SCOPES) {
+        return MAX_SCOPES;
+    }
+
+    const uint32_t scope = static_cast<uint32_t>(scopes.size());
+    scopes.push_back({findOrAddScope(name), false});
+    vkCmdWriteTimestamp(commandBuffer, VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, queryPool, firstQuery(currentFrameIndex, scope));
+
+    return scope;
+}
+
+void LveGpuProfiler::endScope(VkCommandBuffer commandBuffer, uint32_t scope) {
+    if (scope >= MAX_SCOPES) {
+        return;
+    }
+
+    frames[currentFrameIndex].scopes[scope].ended = true;
+    vkCmdWriteTimestamp(commandBuffer, VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT, queryPool, firstQuery(currentFrameIndex, scope) + 1);
+}
+
+void LveGpuProfiler::collectResults(int frameIndex) {
+    const auto& scopes = frames[frameIndex].scopes;
+    if (scopes.empty()) {
+        return;
+    }
+
+    // Without WAIT the call returns right away, scopes whose queries are not available yet are skipped
+    const uint32_t queryCount = static_cast<uint32_t>(scopes.size()) * 2;
+    vkGetQueryPoolResults(
+        lveDevice.device(), queryPool, firstQuery(frameIndex, 0), queryCount, queryCount * 2 * sizeof(uint64_t), results.data(),
+        2 * sizeof(uint64_t), VK_QUERY_RESULT_64_BIT | VK_QUERY_RESULT_WITH_AVAILABILITY_BIT
+    );
+
+    for (size_t scope = 0; scope < scopes.size(); scope++) {
+        const uint64_t* begin = &results[scope * 4];
+        const uint64_t* end = &results[scope * 4 + 2];
+        if (!scopes[scope].ended || begin[1] == 0 || end[1] == 0) {
+            continue;
+        }
+
+        const uint64_t ticks = ((end[0] & timestampMask) - (begin[0] & timestampMask)) & timestampMask;
+        const float    milliseconds = static_cast<float>(ticks) * timestampPeriod * 1e-6f;
+
+        ScopeStats& stats = scopeStats[scopes[scope].statsIndex];
+        stats.lastMilliseconds = milliseconds;
+        stats.history[stats.historyOffset] = milliseconds;
+        stats.historyOffset = (stats.historyOffset + 1) % HISTORY_SIZE;
+    }
+}
+
+uint32_t LveGpuProfiler::findOrAddScope(std::string_view name) {
+    for (uint32_t i = 0; i < scopeStats.size(); i++) {
+        if (scopeStats[i].name == name) {
+            return i;
+        }
+    }
+
+    scopeStats.push_back({name});
+    return static_cast<uint32_t>(scopeStats.size() - 1);
+}
+
+}  // namespace lve
@@ -6,6 +6,8 @@
 #include "constants.hpp"
 #include "io/keyboard.hpp"
 #include "physics/box2d_motor.hpp"
+#include "micrasverse_core/profiler.hpp"
+#include "micrasverse_core/allocation_audit.hpp"
 
 // libs
 #include <imgui.h>
@@ -13,12 +15,19 @@
 #include <imgui_impl_vulkan.h>
 
 // std
+#include <algorithm>
+#include <cfloat>
+#include <functional>
+#include <iostream>
 #include <stdexcept>
 #include <array>
 #include <string>
+#include <string_view>
 
 namespace lve {
 
+namespace commands = micrasverse::simulation::commands;
+
 // ok this just initializes imgui using the provided integration files. So in our case we need to
 // initialize the vulkan and glfw imgui implementations, since that's what our engine is built
 // using.
@@ -49,6 +58,13 @@ LveImgui::LveImgui(LveWindow& window, LveDevice& device, VkRenderPass renderPass
 
     // Setup Dear ImGui context
     IMGUI_CHECKVERSION();
+    if constexpr (micrasverse::allocation_audit::isCompiledIn()) {
+        // ImGui allocates with malloc, routed through the audit so its allocations count as UI
+        ImGui::SetAllocatorFunctions(
+            [](size_t size, void*) { return micrasverse::allocation_audit::allocate(size); },
+            [](void* pointer, void*) { micrasverse::allocation_audit::deallocate(pointer); }
+        );
+    }
     ImGui::CreateContext();
     ImGuiIO& io = ImGui::GetIO();
     (void)io;
@@ -71,7 +87,7 @@ LveImgui::LveImgui(LveWindow& window, LveDevice& device, VkRenderPass renderPass
     init_info.RenderPass = renderPass;
 
     // pipeline cache is a potential future optimization, ignoring for now
-    init_info.PipelineCache = VK_NULL_HANDLE;
+    init_info.PipelineCache = device.getPipelineCache();
     init_info.DescriptorPool = descriptorPool;
     // todo, I should probably get around to integrating a memory allocator library such as Vulkan
     // memory allocator (VMA) sooner than later. We don't want to have to update adding an allocator
@@ -109,20 +125,37 @@ void LveImgui::setSimulationEngine(const std::shared_ptr<micrasverse::simulation
     this->plot.setSimulationEngine(simulationEngine);
 }
 
+void LveImgui::sendCommand(const micrasverse::simulation::Command::Action& action) {
+    if (this->simulationEngine && !this->simulationEngine->sendCommand({.robot = 0, .action = action})) {
+        this->droppedCommands++;
+        std::cerr << "WARNING: Simulation command queue full, UI command dropped" << std::endl;
+    }
+}
+
 void LveImgui::setProxyBridge(const std::shared_ptr<micras::ProxyBridge>& proxyBridge) {
     this->proxyBridge = proxyBridge;
 }
 
+void LveImgui::setFrameControls(LveRenderer* renderer, LveFramePacer* framePacer) {
+    this->renderer = renderer;
+    this->framePacer = framePacer;
+}
+
 // this tells imgui that we're done setting up the current frame,
 // then gets the draw data from imgui and uses it to record to the provided
 // command buffer the necessary draw commands
 void LveImgui::render(VkCommandBuffer commandBuffer) {
+    MICRASVERSE_PROFILE_ZONE("LveImgui::render");
+    MICRASVERSE_ALLOCATION_PHASE(UI);
     ImGui::Render();
     ImDrawData* drawdata = ImGui::GetDrawData();
     ImGui_ImplVulkan_RenderDrawData(drawdata, commandBuffer);
 }
 
 void LveImgui::runExample(micrasverse::physics::Box2DMicrasBody& micrasBody) {
+    MICRASVERSE_PROFILE_ZONE("LveImgui::runExample");
+    MICRASVERSE_ALLOCATION_PHASE(UI);
+
     if (!proxyBridge) {
         ImGui::Begin("Error");
         ImGui::TextColored(ImVec4(1.0f, 0.0f, 0.0f, 1.0f), "Proxy Bridge not initialized!");
@@ -139,6 +172,68 @@ void LveImgui::runExample(micrasverse::physics::Box2DMicrasBody& micrasBody) {
     ImGui::SetNextItemWidth(-1);
     ImGui::SliderInt("##", &physicsStepsPerFrame, 1, 1000);
 
+    if (this->renderer && this->framePacer && ImGui::CollapsingHeader("Frame Pacing")) {
+        static constexpr std::array<VkPresentModeKHR, 3> presentModes = {
+            VK_PRESENT_MODE_FIFO_KHR, VK_PRESENT_MODE_MAILBOX_KHR, VK_PRESENT_MODE_IMMEDIATE_KHR
+        };
+
+        const VkPresentModeKHR currentPresentMode = this->renderer->getPresentMode();
+        if (ImGui::BeginCombo("Present Mode", LveSwapChain::getPresentModeName(currentPresentMode))) {
+            for (const auto presentMode : presentModes) {
+                if (ImGui::Selectable(LveSwapChain::getPresentModeName(presentMode), presentMode == currentPresentMode)) {
+                    this->renderer->setPresentMode(presentMode);
+                }
+            }
+            ImGui::EndCombo();
+        }
+
+        float targetFps = this->framePacer->getTargetFps();
+        if (ImGui::SliderFloat("FPS Cap", &targetFps, 0.0f, 240.0f, targetFps > 0.0f ? "%.0f" : "Uncapped")) {
+            this->framePacer->setTargetFps(targetFps);
+        }
+
+        bool sleepToPace = this->framePacer->getPacing() == LveFramePacer::Pacing::SLEEP;
+        if (ImGui::Checkbox("Sleep Until Frame Is Due", &sleepToPace)) {
+            this->framePacer->setPacing(sleepToPace ? LveFramePacer::Pacing::SLEEP : LveFramePacer::Pacing::SKIP);
+        }
+
+        ImGui::Text(
+            "Frame interval p50 %.2f  p95 %.2f  p99 %.2f ms", this->framePacer->getFrameIntervalPercentile(50.0f),
+            this->framePacer->getFrameIntervalPercentile(95.0f), this->framePacer->getFrameIntervalPercentile(99.0f)
+        );
+        ImGui::Text(
+            "Render time    p50 %.2f  p95 %.2f  p99 %.2f ms", this->framePacer->getRenderTimePercentile(50.0f),
+            this->framePacer->getRenderTimePercentile(95.0f), this->framePacer->getRenderTimePercentile(99.0f)
+        );
+    }
+
+    if (this->renderer && ImGui::CollapsingHeader("GPU Profiler")) {
+        const LveGpuProfiler& gpuProfiler = this->renderer->getGpuProfiler();
+
+        if (!gpuProfiler.isSupported()) {
+            ImGui::Text("Timestamp queries are not supported by the graphics queue");
+        }
+
+        // Results lag a few frames behind, they are read once the GPU is done with them
+        for (const auto& scope : gpuProfiler.getScopeStats()) {
+            ImGui::Text("%-8.*s %.3f ms", static_cast<int>(scope.name.size()), scope.name.data(), scope.lastMilliseconds);
+            ImGui::PushID(scope.name.data());
+            ImGui::PlotLines(
+                "##history", scope.history.data(), static_cast<int>(scope.history.size()), static_cast<int>(scope.historyOffset), nullptr,
+                0.0f, FLT_MAX, ImVec2(-1, 40)
+            );
+            ImGui::PopID();
+        }
+    }
+
+    if (ImGui::CollapsingHeader("Allocation Audit")) {
+        this->drawAllocationAudit();
+    }
+
+    if (ImGui::CollapsingHeader("Box2D Memory")) {
+        this->drawBox2DMemory();
+    }
+
     /// Toggle simulation running
     if (ImGui::Button(simulationEngine->isPaused ? "Start" : "Pause")) {
         simulationEngine->togglePause();
@@ -157,10 +252,14 @@ void LveImgui::runExample(micrasverse::physics::Box2DMicrasBody& micrasBody) {
 
     ImGui::Text("Fan is %s", simulationEngine->physicsEngine->getMicras().getRightMotor().isFanOn ? "ON" : "OFF");
 
+    if (this->droppedCommands > 0) {
+        ImGui::TextColored(ImVec4(1.0f, 0.5f, 0.5f, 1.0f), "%zu commands dropped, simulation queue full", this->droppedCommands);
+    }
+
     // Robot Status Section
     if (ImGui::CollapsingHeader("Robot Status", ImGuiTreeNodeFlags_DefaultOpen)) {
         auto pose = proxyBridge->get_current_pose().to_grid(micras::cell_size);
-        ImGui::Text("Micras Controller Pose: (%d, %d, %s)", pose.position.x, pose.position.y, proxyBridge->get_side_string(pose.orientation).c_str());
+        ImGui::Text("Micras Controller Pose: (%d, %d, %s)", pose.position.x, pose.position.y, proxyBridge->get_side_string(pose.orientation));
         ImGui::Separator();
         ImGui::Text("Estimated time to complete: %.2f seconds", proxyBridge->get_total_time());
         ImGui::Separator();
@@ -172,8 +271,7 @@ void LveImgui::runExample(micrasverse::physics::Box2DMicrasBody& micrasBody) {
             ImGui::Text("MicrasController Status:");
 
             // Display objective with color coding
-            std::string objectiveText = "Objective: " + proxyBridge->get_objective_string();
-            ImVec4      objectiveColor;
+            ImVec4 objectiveColor;
 
             switch (proxyBridge->get_objective()) {
                 case micras::core::Objective::EXPLORE:
@@ -191,16 +289,15 @@ void LveImgui::runExample(micrasverse::physics::Box2DMicrasBody& micrasBody) {
             }
 
             ImGui::PushStyleColor(ImGuiCol_Text, objectiveColor);
-            ImGui::Text("%s", objectiveText.c_str());
+            ImGui::Text("Objective: %s", proxyBridge->get_objective_string());
             ImGui::PopStyleColor();
 
             // Display current action with color coding
-            std::string actionText = "Current Action: " + proxyBridge->get_action_type_string();
-            ImVec4      actionColor = ImVec4(0.5f, 0.5f, 0.5f, 1.0f);  // Default gray
+            ImVec4 actionColor = ImVec4(0.5f, 0.5f, 0.5f, 1.0f);  // Default gray
 
             // Use simpler approach since we don't have direct access to the Action type
             ImGui::PushStyleColor(ImGuiCol_Text, actionColor);
-            ImGui::Text("%s", actionText.c_str());
+            ImGui::Text("Current Action: %s", proxyBridge->get_action_type_string());
             ImGui::PopStyleColor();
 
             // Set Objective buttons using Interface events
@@ -208,19 +305,19 @@ void LveImgui::runExample(micrasverse::physics::Box2DMicrasBody& micrasBody) {
             ImGui::Text("Set Objective via Interface Events:");
 
             if (ImGui::Button("Set EXPLORE")) {
-                proxyBridge->send_event(micras::Interface::Event::EXPLORE);
+                this->sendCommand(commands::SendEvent{micras::Interface::Event::EXPLORE});
             }
 
             ImGui::SameLine();
 
             if (ImGui::Button("Set SOLVE")) {
-                proxyBridge->send_event(micras::Interface::Event::SOLVE);
+                this->sendCommand(commands::SendEvent{micras::Interface::Event::SOLVE});
             }
 
             ImGui::SameLine();
 
             if (ImGui::Button("CALIBRATE")) {
-                proxyBridge->send_event(micras::Interface::Event::CALIBRATE);
+                this->sendCommand(commands::SendEvent{micras::Interface::Event::CALIBRATE});
             }
         }
     }
@@ -267,15 +364,15 @@ void LveImgui::runExample(micrasverse::physics::Box2DMicrasBody& micrasBody) {
 
         // Apply movement based on key state
         if (spacePressed) {
-            proxyBridge->stop_motors();
-            proxyBridge->disable_motors();
+            this->sendCommand(commands::StopMotors{});
+            this->sendCommand(commands::SetMotorsEnabled{false});
             currentLinear = 0.0f;
             currentAngular = 0.0f;
             ImGui::TextColored(ImVec4(1.0f, 0.0f, 0.0f, 1.0f), "STOPPED");
         } else {
             // Clear previous commands and enable motors if any movement key is pressed
             if (wPressed || sPressed || aPressed || dPressed) {
-                proxyBridge->enable_motors();
+                this->sendCommand(commands::SetMotorsEnabled{true});
 
                 // Forward/Backward movement
                 float linearSpeed = 0.0f;
@@ -296,7 +393,7 @@ void LveImgui::runExample(micrasverse::physics::Box2DMicrasBody& micrasBody) {
                 currentAngular = angularSpeed;
 
                 // Apply the combined command
-                proxyBridge->set_command(linearSpeed, angularSpeed);
+                this->sendCommand(commands::SetCommand{linearSpeed, angularSpeed});
 
                 // Display movement status
                 if (linearSpeed > 0) {
@@ -314,12 +411,12 @@ void LveImgui::runExample(micrasverse::physics::Box2DMicrasBody& micrasBody) {
                 // Handle key releases - set command to 0
                 if (wReleased || sReleased) {
                     currentLinear = 0.0f;
-                    proxyBridge->set_command(0.0f, currentAngular);
+                    this->sendCommand(commands::SetCommand{0.0f, currentAngular});
                 }
 
                 if (aReleased || dReleased) {
                     currentAngular = 0.0f;
-                    proxyBridge->set_command(currentLinear, 0.0f);
+                    this->sendCommand(commands::SetCommand{currentLinear, 0.0f});
                 }
 
                 // No keys pressed
@@ -328,21 +425,30 @@ void LveImgui::runExample(micrasverse::physics::Box2DMicrasBody& micrasBody) {
                 }
             }
         }
+
+        // Raw wheel commands in percent, held until the firmware or the keys send other ones
+        ImGui::Separator();
+        static float leftWheelCommand = 0.0f;
+        static float rightWheelCommand = 0.0f;
+        ImGui::SliderFloat("Left Wheel", &leftWheelCommand, -100.0f, 100.0f, "%.0f %%");
+        ImGui::SliderFloat("Right Wheel", &rightWheelCommand, -100.0f, 100.0f, "%.0f %%");
+
+        if (ImGui::Button("Set Wheel Command")) {
+            this->sendCommand(commands::SetWheelCommand{leftWheelCommand, rightWheelCommand});
+        }
     }
 
     // DIP Switch Controls Section
     if (ImGui::CollapsingHeader("DIP Switches", ImGuiTreeNodeFlags_DefaultOpen)) {
         ImGui::Columns(4, "dipswitches", false);
 
-        std::vector<bool>        switches = proxyBridge->get_dip_switch_states();
-        std::vector<std::string> s_names = {"FAN", "DIAGONAL", "BOOST", "RISKY"};
+        const auto                           switches = proxyBridge->get_dip_switch_states();
+        constexpr std::array<const char*, 4> s_names = {"FAN", "DIAGONAL", "BOOST", "RISKY"};
 
         for (size_t i = 0; i < switches.size(); ++i) {
             bool value = switches.at(i);
-            if (ImGui::Checkbox(s_names.at(i).c_str(), &value)) {
-                proxyBridge->set_dip_switch_state(i, value);
-            } else {
-                proxyBridge->set_dip_switch_state(i, value);
+            if (ImGui::Checkbox(s_names.at(i), &value)) {
+                this->sendCommand(commands::SetDipSwitch{static_cast<uint8_t>(i), value});
             }
             ImGui::NextColumn();
         }
@@ -361,34 +467,34 @@ void LveImgui::runExample(micrasverse::physics::Box2DMicrasBody& micrasBody) {
         // ARGB Control for events
         if (ImGui::Button("Set EXPLORE Color (Green)", ImVec2(buttonWidth, buttonHeight))) {
             micrasverse::types::Color color{0, 255, 0};  // Green
-            proxyBridge->set_argb_color(color);
-            proxyBridge->send_event(micras::Interface::Event::EXPLORE);
+            this->sendCommand(commands::SetArgbColor{color});
+            this->sendCommand(commands::SendEvent{micras::Interface::Event::EXPLORE});
         }
 
         ImGui::SameLine();
 
         if (ImGui::Button("Set SOLVE Color (Blue)", ImVec2(buttonWidth, buttonHeight))) {
             micrasverse::types::Color color{0, 0, 255};  // Blue
-            proxyBridge->set_argb_color(color);
-            proxyBridge->send_event(micras::Interface::Event::SOLVE);
+            this->sendCommand(commands::SetArgbColor{color});
+            this->sendCommand(commands::SendEvent{micras::Interface::Event::SOLVE});
         }
 
         if (ImGui::Button("Set CALIBRATE Color (Yellow)", ImVec2(buttonWidth, buttonHeight))) {
             micrasverse::types::Color color{255, 255, 0};  // Yellow
-            proxyBridge->set_argb_color(color);
-            proxyBridge->send_event(micras::Interface::Event::CALIBRATE);
+            this->sendCommand(commands::SetArgbColor{color});
+            this->sendCommand(commands::SendEvent{micras::Interface::Event::CALIBRATE});
         }
 
         ImGui::SameLine();
 
         if (ImGui::Button("Set ERROR Color (Red)", ImVec2(buttonWidth, buttonHeight))) {
             micrasverse::types::Color color{255, 0, 0};  // Red
-            proxyBridge->set_argb_color(color);
-            proxyBridge->send_event(micras::Interface::Event::ERROR);
+            this->sendCommand(commands::SetArgbColor{color});
+            this->sendCommand(commands::SendEvent{micras::Interface::Event::ERROR});
         }
 
         if (ImGui::Button("Turn Off LEDs", ImVec2(buttonWidth, buttonHeight))) {
-            proxyBridge->turn_off_argb();
+            this->sendCommand(commands::TurnOffArgb{});
         }
 
         // Manual control of individual LEDs
@@ -402,7 +508,9 @@ void LveImgui::runExample(micrasverse::physics::Box2DMicrasBody& micrasBody) {
         ImGui::ColorEdit3("LED Color", color);
 
         if (ImGui::Button("Set Individual LED")) {
-            proxyBridge->set_led_color(led_index, color[0], color[1], color[2]);
+            this->sendCommand(commands::SetLedColor{
+                static_cast<uint8_t>(led_index), static_cast<uint8_t>(color[0]), static_cast<uint8_t>(color[1]), static_cast<uint8_t>(color[2])
+            });
         }
     }
 
@@ -436,7 +544,7 @@ void LveImgui::runExample(micrasverse::physics::Box2DMicrasBody& micrasBody) {
 
             // Reset the button status after the configured duration
             if (status != micras::proxy::Button::Status::NO_PRESS && elapsedTime >= buttonDurations[durationIndex]) {
-                proxyBridge->set_button_status(micras::proxy::Button::Status::NO_PRESS);
+                this->sendCommand(commands::SetButtonStatus{micras::proxy::Button::Status::NO_PRESS});
                 buttonTimerActive = false;
             }
         }
@@ -451,19 +559,19 @@ void LveImgui::runExample(micrasverse::physics::Box2DMicrasBody& micrasBody) {
 
         // Use Interface events instead of direct button status setting
         if (ImGui::Button("Short Press (EXPLORE)", ImVec2(buttonWidth, buttonHeight))) {
-            proxyBridge->set_button_status(micras::proxy::Button::Status::SHORT_PRESS);
+            this->sendCommand(commands::SetButtonStatus{micras::proxy::Button::Status::SHORT_PRESS});
             buttonActivationTime = std::chrono::steady_clock::now();
             buttonTimerActive = true;
         }
         ImGui::SameLine();
         if (ImGui::Button("Long Press (SOLVE)", ImVec2(buttonWidth, buttonHeight))) {
-            proxyBridge->set_button_status(micras::proxy::Button::Status::LONG_PRESS);
+            this->sendCommand(commands::SetButtonStatus{micras::proxy::Button::Status::LONG_PRESS});
             buttonActivationTime = std::chrono::steady_clock::now();
             buttonTimerActive = true;
         }
         ImGui::SameLine();
         if (ImGui::Button("Extra Long Press (CALIBRATE)", ImVec2(buttonWidth, buttonHeight))) {
-            proxyBridge->set_button_status(micras::proxy::Button::Status::EXTRA_LONG_PRESS);
+            this->sendCommand(commands::SetButtonStatus{micras::proxy::Button::Status::EXTRA_LONG_PRESS});
             buttonActivationTime = std::chrono::steady_clock::now();
             buttonTimerActive = true;
         }
@@ -516,10 +624,10 @@ void LveImgui::runExample(micrasverse::physics::Box2DMicrasBody& micrasBody) {
 
         // Allow acknowledging events
         if (ImGui::Button("Acknowledge All Events")) {
-            proxyBridge->acknowledge_event(micras::Interface::Event::EXPLORE);
-            proxyBridge->acknowledge_event(micras::Interface::Event::SOLVE);
-            proxyBridge->acknowledge_event(micras::Interface::Event::CALIBRATE);
-            proxyBridge->acknowledge_event(micras::Interface::Event::ERROR);
+            this->sendCommand(commands::AcknowledgeEvent{micras::Interface::Event::EXPLORE});
+            this->sendCommand(commands::AcknowledgeEvent{micras::Interface::Event::SOLVE});
+            this->sendCommand(commands::AcknowledgeEvent{micras::Interface::Event::CALIBRATE});
+            this->sendCommand(commands::AcknowledgeEvent{micras::Interface::Event::ERROR});
         }
     }
 
@@ -532,14 +640,13 @@ void LveImgui::runExample(micrasverse::physics::Box2DMicrasBody& micrasBody) {
         ImGui::SliderInt("Duration (ms)", &duration, 100, 5000);
 
         if (ImGui::Button("Play Sound")) {
-            proxyBridge->set_buzzer_frequency(frequency);
-            proxyBridge->set_buzzer_duration(duration);
+            this->sendCommand(commands::PlayBuzzer{frequency, static_cast<uint32_t>(duration)});
         }
 
         ImGui::SameLine();
 
         if (ImGui::Button("Stop Sound")) {
-            proxyBridge->stop_buzzer();
+            this->sendCommand(commands::StopBuzzer{});
         }
 
         // Display current buzzer status
@@ -552,18 +659,16 @@ void LveImgui::runExample(micrasverse::physics::Box2DMicrasBody& micrasBody) {
 
         if (ImGui::Button("Error Tone")) {
             // Play error tone and trigger error event
-            proxyBridge->set_buzzer_frequency(880.0f);  // Higher frequency for error
-            proxyBridge->set_buzzer_duration(300);
-            proxyBridge->send_event(micras::Interface::Event::ERROR);
+            this->sendCommand(commands::PlayBuzzer{880.0f, 300});  // Higher frequency for error
+            this->sendCommand(commands::SendEvent{micras::Interface::Event::ERROR});
         }
 
         ImGui::SameLine();
 
         if (ImGui::Button("Success Tone")) {
             // Play success tone and trigger explore event
-            proxyBridge->set_buzzer_frequency(1760.0f);
-            proxyBridge->set_buzzer_duration(200);
-            proxyBridge->send_event(micras::Interface::Event::EXPLORE);
+            this->sendCommand(commands::PlayBuzzer{1760.0f, 200});
+            this->sendCommand(commands::SendEvent{micras::Interface::Event::EXPLORE});
         }
     }
 
@@ -577,6 +682,53 @@ void LveImgui::runExample(micrasverse::physics::Box2DMicrasBody& micrasBody) {
             ImGui::NextColumn();
         }
         ImGui::Columns(1);
+
+        // Uses the walls around the robot as they are right now, so place it first
+        ImGui::Text("Calibrate:");
+        if (ImGui::Button("Front Wall")) {
+            this->sendCommand(commands::Calibrate{commands::Calibrate::Target::FRONT_WALL});
+        }
+        ImGui::SameLine();
+        if (ImGui::Button("Left Wall")) {
+            this->sendCommand(commands::Calibrate{commands::Calibrate::Target::LEFT_WALL});
+        }
+        ImGui::SameLine();
+        if (ImGui::Button("Right Wall")) {
+            this->sendCommand(commands::Calibrate{commands::Calibrate::Target::RIGHT_WALL});
+        }
+        ImGui::SameLine();
+        if (ImGui::Button("IMU")) {
+            this->sendCommand(commands::Calibrate{commands::Calibrate::Target::IMU});
+        }
+    }
+
+    // Sampling and physics periods, shared by every robot
+    if (this->simulationEngine && ImGui::CollapsingHeader("Simulation Rates")) {
+        // Milliseconds in the UI, seconds in the engine
+        const auto periodInput = [](const char* label, float& period) {
+            float milliseconds = period * 1000.0f;
+            if (ImGui::InputFloat(label, &milliseconds, 0.1f, 1.0f, "%.2f ms", ImGuiInputTextFlags_EnterReturnsTrue)) {
+                period = std::max(milliseconds, 0.01f) / 1000.0f;
+                return true;
+            }
+            return false;
+        };
+
+        micrasverse::simulation::SensorPeriods periods = simulationEngine->getSensorPeriods();
+        bool                                   periodsChanged = false;
+        periodsChanged |= periodInput("Wall Sensor Period", periods.wallSensors);
+        periodsChanged |= periodInput("Encoder Period", periods.encoders);
+        periodsChanged |= periodInput("IMU Period", periods.imu);
+        periodsChanged |= periodInput("Torque Period", periods.torque);
+        periodsChanged |= periodInput("Battery Period", periods.battery);
+        if (periodsChanged) {
+            this->sendCommand(commands::SetSensorPeriods{periods});
+        }
+
+        float physicsPeriod = simulationEngine->getPhysicsPeriod();
+        if (periodInput("Physics Period", physicsPeriod)) {
+            this->sendCommand(commands::SetPhysicsPeriod{physicsPeriod});
+        }
     }
 
     // Simulation controls
@@ -609,9 +761,25 @@ void LveImgui::runExample(micrasverse::physics::Box2DMicrasBody& micrasBody) {
                 simulationEngine->resetSimulation(mazePaths[selectedMazeIdx]);
             }
 
+            // A full reload rebuilds the world, an incremental one only touches the walls that changed
+            auto& physicsEngine = *simulationEngine->physicsEngine;
+            bool  incrementalReload = physicsEngine.getMazeReloadMode() == micrasverse::physics::MazeReloadMode::INCREMENTAL;
+            if (ImGui::Checkbox("Incremental Reload", &incrementalReload)) {
+                physicsEngine.setMazeReloadMode(
+                    incrementalReload ? micrasverse::physics::MazeReloadMode::INCREMENTAL : micrasverse::physics::MazeReloadMode::FULL
+                );
+            }
+
+            const auto& lastReload = physicsEngine.getLastMazeReload();
+            ImGui::Text(
+                "Last reload: %s, %zu added %zu removed %zu kept in %.2f ms",
+                lastReload.mode == micrasverse::physics::MazeReloadMode::INCREMENTAL ? "incremental" : "full", lastReload.delta.added,
+                lastReload.delta.removed, lastReload.delta.kept, lastReload.milliseconds
+            );
+
             if (ImGui::Button("Reset Simulation")) {
                 simulationEngine->resetSimulation();
-                proxyBridge->reset_micras();
+                this->sendCommand(commands::ResetFirmware{});
             }
 
         } else {
@@ -622,9 +790,16 @@ void LveImgui::runExample(micrasverse::physics::Box2DMicrasBody& micrasBody) {
     // Option to show style editor (defaults to off)
     ImGui::Checkbox("Show Style Editor", &showStyleEditor);
     ImGui::Checkbox("Show Performance Plots", &this->plot.showPlots);
+    ImGui::Checkbox("Show CPU Profiler", &this->showCpuProfiler);
 
     ImGui::End();
 
+    if (this->showCpuProfiler) {
+        ImGui::Begin("CPU Profiler", &this->showCpuProfiler);
+        this->drawCpuProfiler();
+        ImGui::End();
+    }
+
     // Only draw plots if not in fullscreen mode or if user explicitly enabled them
     if (this->plot.showPlots) {
         ImGui::Begin("Performance Plots");
@@ -633,4 +808,129 @@ void LveImgui::runExample(micrasverse::physics::Box2DMicrasBody& micrasBody) {
     }
 }
 
+void LveImgui::drawCpuProfiler() {
+    namespace profiler = micrasverse::profiler;
+
+#if !MICRASVERSE_PROFILER
+    ImGui::Text("The profiler was compiled out, configure with -DMICRASVERSE_ENABLE_PROFILER=ON");
+#else
+    bool recording = profiler::isEnabled();
+    if (ImGui::Checkbox("Record Zones", &recording)) {
+        profiler::setEnabled(recording);
+    }
+
+    ImGui::SameLine();
+    if (ImGui::Button("Export Chrome Trace")) {
+        this->traceExportStatus = profiler::writeChromeTrace("micrasverse_trace.json") ? "Written to micrasverse_trace.json" : "Export failed";
+    }
+    if (!this->traceExportStatus.empty()) {
+        ImGui::SameLine();
+        ImGui::Text("%s", this->traceExportStatus.c_str());
+    }
+
+    ImGui::SliderFloat("Span (ms)", &this->timelineSpan, 1.0f, 200.0f, "%.0f");
+
+    // Paused recordings keep showing the last span that was recorded
+    if (recording || this->timelineEnd == 0) {
+        this->timelineEnd = profiler::now();
+    }
+    const uint64_t span = static_cast<uint64_t>(this->timelineSpan * 1e6f);
+    const uint64_t begin = this->timelineEnd > span ? this->timelineEnd - span : 0;
+
+    this->profilerEvents.clear();
+    profiler::collect(this->profilerEvents, begin);
+
+    const auto threads = profiler::getThreads();
+
+    uint32_t maxDepth = 0;
+    for (const auto& event : this->profilerEvents) {
+        maxDepth = std::max(maxDepth, event.depth);
+    }
+
+    // One lane per thread, nested zones stacked below their parent like a flame graph
+    constexpr float laneHeight = 18.0f;
+    const float     threadHeight = laneHeight * (maxDepth + 1) + 6.0f;
+    const float     width = ImGui::GetContentRegionAvail().x;
+    const ImVec2    origin = ImGui::GetCursorScreenPos();
+    ImDrawList*     drawList = ImGui::GetWindowDrawList();
+
+    ImGui::InvisibleButton("##timeline", ImVec2(width, std::max(threadHeight * threads.size(), 1.0f)));
+    const bool   hovered = ImGui::IsItemHovered();
+    const ImVec2 mouse = ImGui::GetMousePos();
+
+    for (size_t thread = 0; thread < threads.size(); thread++) {
+        drawList->AddText(ImVec2(origin.x, origin.y + thread * threadHeight), IM_COL32(200, 200, 200, 255), threads[thread].name.c_str());
+    }
+
+    for (const auto& event : this->profilerEvents) {
+        const float x0 = origin.x + width * static_cast<float>(static_cast<double>(std::max(event.startTime, begin) - begin) / span);
+        const float x1 = origin.x + width * static_cast<float>(static_cast<double>(std::min(event.endTime, this->timelineEnd) - begin) / span);
+        const float y0 = origin.y + event.threadIndex * threadHeight + (event.depth + 1) * laneHeight;
+        const float y1 = y0 + laneHeight - 1.0f;
+        if (x1 <= x0) {
+            continue;
+        }
+
+        // Color hashed from the name, so a zone keeps its color between frames
+        const auto   hash = static_cast<uint32_t>(std::hash<std::string_view>{}(event.name));
+        const ImU32  color = IM_COL32(80 + hash % 150, 80 + (hash >> 8) % 150, 80 + (hash >> 16) % 150, 255);
+        const ImVec2 min(x0, y0);
+        const ImVec2 max(std::max(x1, x0 + 1.0f), y1);
+        drawList->AddRectFilled(min, max, color);
+
+        if (x1 - x0 > 40.0f) {
+            drawList->PushClipRect(min, max, true);
+            drawList->AddText(ImVec2(x0 + 2.0f, y0 + 1.0f), IM_COL32(0, 0, 0, 255), event.name);
+            drawList->PopClipRect();
+        }
+
+        if (hovered && mouse.x >= min.x && mouse.x <= max.x && mouse.y >= min.y && mouse.y <= max.y) {
+            ImGui::SetTooltip("%s\n%.3f ms", event.name, (event.endTime - event.startTime) * 1e-6);
+        }
+    }
+#endif
+}
+
+void LveImgui::drawAllocationAudit() {
+    namespace audit = micrasverse::allocation_audit;
+
+    if constexpr (!audit::isCompiledIn()) {
+        ImGui::Text("Heap allocations are not counted, configure with -DMICRASVERSE_ALLOCATION_AUDIT=ON");
+        return;
+    }
+
+    // Counted since the previous frame, the steady state of the simulation phases should be all zeros
+    for (size_t i = 0; i < this->lastAllocationCounts.size(); i++) {
+        const auto phase = static_cast<audit::Phase>(i);
+        const auto counts = audit::getCounts(phase);
+        ImGui::Text(
+            "%-10s %6llu allocations %10llu bytes", audit::getPhaseName(phase),
+            static_cast<unsigned long long>(counts.allocations - this->lastAllocationCounts[i].allocations),
+            static_cast<unsigned long long>(counts.bytes - this->lastAllocationCounts[i].bytes)
+        );
+        this->lastAllocationCounts[i] = counts;
+    }
+}
+
+void LveImgui::drawBox2DMemory() {
+    namespace physics = micrasverse::physics;
+
+    // Loading a maze creates a new world, so the peaks restart with it
+    const physics::Box2DMemoryStats stats = simulationEngine->physicsEngine->getWorld().getMemoryStats();
+    const physics::Box2DMemoryStats unscoped = physics::getUnscopedBox2DMemoryStats();
+
+    for (size_t i = 0; i < stats.bytesByCategory.size(); i++) {
+        ImGui::Text(
+            "%-8s %10.1f KiB", physics::getBox2DMemoryCategoryName(static_cast<physics::Box2DMemoryCategory>(i)),
+            stats.bytesByCategory[i] / 1024.0
+        );
+    }
+
+    ImGui::Separator();
+    ImGui::Text("In use   %10.1f KiB  peak %10.1f KiB", stats.bytesInUse / 1024.0, stats.peakBytesInUse / 1024.0);
+    ImGui::Text("Reserved %10.1f KiB  peak %10.1f KiB", stats.reservedBytes / 1024.0, stats.peakReservedBytes / 1024.0);
+    ImGui::Text("Allocations %llu", static_cast<unsigned long long>(stats.allocations));
+    ImGui::Text("Outside of any world arena %.1f KiB", unscoped.bytesInUse / 1024.0);
+}
+
 }  // namespace lve
@@ -0,0 +1,270 @@
+#include "vulkan_engine/lve_offscreen_target.hpp"
+
+// std
+#include <array>
+#include <limits>
+#include <stdexcept>
+
+namespace lve {
+
+LveOffscreenTarget::LveOffscreenTarget(LveDevice& deviceRef, VkExtent2D extent) : device{deviceRef}, extent{extent} {
+    depthFormat = device.findSupportedFormat(
+        {VK_FORMAT_D32_SFLOAT, VK_FORMAT_D32_SFLOAT_S8_UINT, VK_FORMAT_D24_UNORM_S8_UINT}, VK_IMAGE_TILING_OPTIMAL,
+        VK_FORMAT_FEATURE_DEPTH_STENCIL_ATTACHMENT_BIT
+    );
+
+    createRenderPass();
+    createFrames();
+}
+
+LveOffscreenTarget::~LveOffscreenTarget() {
+    vkDeviceWaitIdle(device.device());
+
+    for (auto& frame : frames) {
+        vkDestroyFence(device.device(), frame.inFlightFence, nullptr);
+        vkUnmapMemory(device.device(), frame.stagingBufferMemory);
+        vkDestroyBuffer(device.device(), frame.stagingBuffer, nullptr);
+        vkFreeMemory(device.device(), frame.stagingBufferMemory, nullptr);
+        vkDestroyFramebuffer(device.device(), frame.framebuffer, nullptr);
+        vkDestroyImageView(device.device(), frame.depthImageView, nullptr);
+        vkDestroyImage(device.device(), frame.depthImage, nullptr);
+        vkFreeMemory(device.device(), frame.depthImageMemory, nullptr);
+        vkDestroyImageView(device.device(), frame.colorImageView, nullptr);
+        vkDestroyImage(device.device(), frame.colorImage, nullptr);
+        vkFreeMemory(device.device(), frame.colorImageMemory, nullptr);
+    }
+
+    vkDestroyRenderPass(device.device(), renderPass, nullptr);
+}
+
+VkResult LveOffscreenTarget::acquireNextImage(uint32_t* imageIndex) {
+    Frame& frame = frames[currentFrame];
+    vkWaitForFences(device.device(), 1, &frame.inFlightFence, VK_TRUE, std::numeric_limits<uint64_t>::max());
+
+    // The slot's previous frame is done by now, MAX_FRAMES_IN_FLIGHT frames after it was submitted
+    deliverReadback(frame);
+
+    *imageIndex = static_cast<uint32_t>(currentFrame);
+    return VK_SUCCESS;
+}
+
+void LveOffscreenTarget::recordReadback(VkCommandBuffer commandBuffer, uint32_t imageIndex) {
+    if (!frameCallback) {
+        return;
+    }
+
+    Frame& frame = frames[imageIndex];
+
+    // The render pass leaves the image in TRANSFER_SRC_OPTIMAL and its outgoing dependency covers the copy
+    VkBufferImageCopy region{};
+    region.bufferOffset = 0;
+    region.bufferRowLength = 0;
+    region.bufferImageHeight = 0;
+    region.imageSubresource.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+    region.imageSubresource.mipLevel = 0;
+    region.imageSubresource.baseArrayLayer = 0;
+    region.imageSubresource.layerCount = 1;
+    region.imageOffset = {0, 0, 0};
+    region.imageExtent = {extent.width, extent.height, 1};
+
+    vkCmdCopyImageToBuffer(commandBuffer, frame.colorImage, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL, frame.stagingBuffer, 1, &region);
+
+    VkBufferMemoryBarrier barrier{};
+    barrier.sType = VK_STRUCTURE_TYPE_BUFFER_MEMORY_BARRIER;
+    barrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+    barrier.dstAccessMask = VK_ACCESS_HOST_READ_BIT;
+    barrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+    barrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+    barrier.buffer = frame.stagingBuffer;
+    barrier.offset = 0;
+    barrier.size = VK_WHOLE_SIZE;
+
+    vkCmdPipelineBarrier(commandBuffer, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_HOST_BIT, 0, 0, nullptr, 1, &barrier, 0, nullptr);
+
+    frame.hasReadback = true;
+}
+
+VkResult LveOffscreenTarget::submitCommandBuffers(const VkCommandBuffer* buffers, uint32_t* imageIndex) {
+    Frame& frame = frames[*imageIndex];
+    frame.index = submittedFrames++;
+
+    VkSubmitInfo submitInfo = {};
+    submitInfo.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
+    submitInfo.commandBufferCount = 1;
+    submitInfo.pCommandBuffers = buffers;
+
+    vkResetFences(device.device(), 1, &frame.inFlightFence);
+    if (vkQueueSubmit(device.graphicsQueue(), 1, &submitInfo, frame.inFlightFence) != VK_SUCCESS) {
+        throw std::runtime_error("failed to submit offscreen command buffer!");
+    }
+
+    currentFrame = (currentFrame + 1) % frames.size();
+
+    return VK_SUCCESS;
+}
+
+void LveOffscreenTarget::flush() {
+    for (size_t i = 0; i < frames.size(); i++) {
+        Frame& frame = frames[(currentFrame + i) % frames.size()];
+        vkWaitForFences(device.device(), 1, &frame.inFlightFence, VK_TRUE, std::numeric_limits<uint64_t>::max());
+        deliverReadback(frame);
+    }
+}
+
+void LveOffscreenTarget::deliverReadback(Frame& frame) {
+    if (!frame.hasReadback) {
+        return;
+    }
+
+    frame.hasReadback = false;
+    if (frameCallback) {
+        frameCallback({frame.index, extent.width, extent.height, static_cast<const uint8_t*>(frame.mappedPixels)});
+    }
+}
+
+void LveOffscreenTarget::createRenderPass() {
+    VkAttachmentDescription depthAttachment{};
+    depthAttachment.format = depthFormat;
+    depthAttachment.samples = VK_SAMPLE_COUNT_1_BIT;
+    depthAttachment.loadOp = VK_ATTACHMENT_LOAD_OP_CLEAR;
+    depthAttachment.storeOp = VK_ATTACHMENT_STORE_OP_DONT_CARE;
+    depthAttachment.stencilLoadOp = VK_ATTACHMENT_LOAD_OP_DONT_CARE;
+    depthAttachment.stencilStoreOp = VK_ATTACHMENT_STORE_OP_DONT_CARE;
+    depthAttachment.initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+    depthAttachment.finalLayout = VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL;
+
+    VkAttachmentReference depthAttachmentRef{};
+    depthAttachmentRef.attachment = 1;
+    depthAttachmentRef.layout = VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL;
+
+    // Same formats as the swapchain render pass, so pipelines are compatible with both
+    VkAttachmentDescription colorAttachment = {};
+    colorAttachment.format = IMAGE_FORMAT;
+    colorAttachment.samples = VK_SAMPLE_COUNT_1_BIT;
+    colorAttachment.loadOp = VK_ATTACHMENT_LOAD_OP_CLEAR;
+    colorAttachment.storeOp = VK_ATTACHMENT_STORE_OP_STORE;
+    colorAttachment.stencilStoreOp = VK_ATTACHMENT_STORE_OP_DONT_CARE;
+    colorAttachment.stencilLoadOp = VK_ATTACHMENT_LOAD_OP_DONT_CARE;
+    colorAttachment.initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+    colorAttachment.finalLayout = VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL;
+
+    VkAttachmentReference colorAttachmentRef = {};
+    colorAttachmentRef.attachment = 0;
+    colorAttachmentRef.layout = VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL;
+
+    VkSubpassDescription subpass = {};
+    subpass.pipelineBindPoint = VK_PIPELINE_BIND_POINT_GRAPHICS;
+    subpass.colorAttachmentCount = 1;
+    subpass.pColorAttachments = &colorAttachmentRef;
+    subpass.pDepthStencilAttachment = &depthAttachmentRef;
+
+    std::array<VkSubpassDependency, 2> dependencies{};
+    dependencies[0].srcSubpass = VK_SUBPASS_EXTERNAL;
+    dependencies[0].dstSubpass = 0;
+    dependencies[0].srcStageMask = VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT | VK_PIPELINE_STAGE_EARLY_FRAGMENT_TESTS_BIT;
+    dependencies[0].srcAccessMask = 0;
+    dependencies[0].dstStageMask = VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT | VK_PIPELINE_STAGE_EARLY_FRAGMENT_TESTS_BIT;
+    dependencies[0].dstAccessMask = VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT | VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT;
+
+    // Color writes finish before the readback copy
+    dependencies[1].srcSubpass = 0;
+    dependencies[1].dstSubpass = VK_SUBPASS_EXTERNAL;
+    dependencies[1].srcStageMask = VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT;
+    dependencies[1].srcAccessMask = VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT;
+    dependencies[1].dstStageMask = VK_PIPELINE_STAGE_TRANSFER_BIT;
+    dependencies[1].dstAccessMask = VK_ACCESS_TRANSFER_READ_BIT;
+
+    std::array<VkAttachmentDescription, 2> attachments = {colorAttachment, depthAttachment};
+    VkRenderPassCreateInfo                 renderPassInfo = {};
+    renderPassInfo.sType = VK_STRUCTURE_TYPE_RENDER_PASS_CREATE_INFO;
+    renderPassInfo.attachmentCount = static_cast<uint32_t>(attachments.size());
+    renderPassInfo.pAttachments = attachments.data();
+    renderPassInfo.subpassCount = 1;
+    renderPassInfo.pSubpasses = &subpass;
+    renderPassInfo.dependencyCount = static_cast<uint32_t>(dependencies.size());
+    renderPassInfo.pDependencies = dependencies.data();
+
+    if (vkCreateRenderPass(device.device(), &renderPassInfo, nullptr, &renderPass) != VK_SUCCESS) {
+        throw std::runtime_error("failed to create offscreen render pass!");
+    }
+}
+
+void LveOffscreenTarget::createFrames() {
+    frames.resize(MAX_FRAMES_IN_FLIGHT);
+
+    const VkDeviceSize frameSize = static_cast<VkDeviceSize>(extent.width) * extent.height * 4;
+
+    for (auto& frame : frames) {
+        VkImageCreateInfo imageInfo{};
+        imageInfo.sType = VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO;
+        imageInfo.imageType = VK_IMAGE_TYPE_2D;
+        imageInfo.extent.width = extent.width;
+        imageInfo.extent.height = extent.height;
+        imageInfo.extent.depth = 1;
+        imageInfo.mipLevels = 1;
+        imageInfo.arrayLayers = 1;
+        imageInfo.tiling = VK_IMAGE_TILING_OPTIMAL;
+        imageInfo.initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+        imageInfo.samples = VK_SAMPLE_COUNT_1_BIT;
+        imageInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+        imageInfo.flags = 0;
+
+        imageInfo.format = IMAGE_FORMAT;
+        imageInfo.usage = VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT | VK_IMAGE_USAGE_TRANSFER_SRC_BIT;
+        device.createImageWithInfo(imageInfo, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, frame.colorImage, frame.colorImageMemory);
+        createImageView(frame.colorImage, IMAGE_FORMAT, VK_IMAGE_ASPECT_COLOR_BIT, frame.colorImageView);
+
+        imageInfo.format = depthFormat;
+        imageInfo.usage = VK_IMAGE_USAGE_DEPTH_STENCIL_ATTACHMENT_BIT;
+        device.createImageWithInfo(imageInfo, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, frame.depthImage, frame.depthImageMemory);
+        createImageView(frame.depthImage, depthFormat, VK_IMAGE_ASPECT_DEPTH_BIT, frame.depthImageView);
+
+        std::array<VkImageView, 2> attachments = {frame.colorImageView, frame.depthImageView};
+        VkFramebufferCreateInfo    framebufferInfo = {};
+        framebufferInfo.sType = VK_STRUCTURE_TYPE_FRAMEBUFFER_CREATE_INFO;
+        framebufferInfo.renderPass = renderPass;
+        framebufferInfo.attachmentCount = static_cast<uint32_t>(attachments.size());
+        framebufferInfo.pAttachments = attachments.data();
+        framebufferInfo.width = extent.width;
+        framebufferInfo.height = extent.height;
+        framebufferInfo.layers = 1;
+
+        if (vkCreateFramebuffer(device.device(), &framebufferInfo, nullptr, &frame.framebuffer) != VK_SUCCESS) {
+            throw std::runtime_error("failed to create offscreen framebuffer!");
+        }
+
+        // Staging buffers stay mapped for the lifetime of the target, coherent so no invalidation is needed
+        device.createBuffer(
+            frameSize, VK_BUFFER_USAGE_TRANSFER_DST_BIT, VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT,
+            frame.stagingBuffer, frame.stagingBufferMemory
+        );
+        vkMapMemory(device.device(), frame.stagingBufferMemory, 0, frameSize, 0, &frame.mappedPixels);
+
+        VkFenceCreateInfo fenceInfo = {};
+        fenceInfo.sType = VK_STRUCTURE_TYPE_FENCE_CREATE_INFO;
+        fenceInfo.flags = VK_FENCE_CREATE_SIGNALED_BIT;
+
+        if (vkCreateFence(device.device(), &fenceInfo, nullptr, &frame.inFlightFence) != VK_SUCCESS) {
+            throw std::runtime_error("failed to create synchronization objects for an offscreen frame!");
+        }
+    }
+}
+
+void LveOffscreenTarget::createImageView(VkImage image, VkFormat format, VkImageAspectFlags aspect, VkImageView& view) {
+    VkImageViewCreateInfo viewInfo{};
+    viewInfo.sType = VK_STRUCTURE_TYPE_IMAGE_VIEW_CREATE_INFO;
+    viewInfo.image = image;
+    viewInfo.viewType = VK_IMAGE_VIEW_TYPE_2D;
+    viewInfo.format = format;
+    viewInfo.subresourceRange.aspectMask = aspect;
+    viewInfo.subresourceRange.baseMipLevel = 0;
+    viewInfo.subresourceRange.levelCount = 1;
+    viewInfo.subresourceRange.baseArrayLayer = 0;
+    viewInfo.subresourceRange.layerCount = 1;
+
+    if (vkCreateImageView(device.device(), &viewInfo, nullptr, &view) != VK_SUCCESS) {
+        throw std::runtime_error("failed to create offscreen image view!");
+    }
+}
+
+}  // namespace lve
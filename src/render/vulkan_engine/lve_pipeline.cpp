@@ -12,7 +12,20 @@ namespace lve {
 
 LvePipeline::LvePipeline(LveDevice& device, const std::string& vertFilepath, const std::string& fragFilepath, const PipelineConfigInfo& configInfo) :
     lveDevice{device} {
-    createGraphicsPipeline(vertFilepath, fragFilepath, configInfo);
+    auto vertCode = readFile(vertFilepath);
+    auto fragCode = readFile(fragFilepath);
+
+    createGraphicsPipeline(
+        {reinterpret_cast<const uint32_t*>(vertCode.data()), vertCode.size() / sizeof(uint32_t)},
+        {reinterpret_cast<const uint32_t*>(fragCode.data()), fragCode.size() / sizeof(uint32_t)}, configInfo
+    );
+}
+
+LvePipeline::LvePipeline(
+    LveDevice& device, std::span<const uint32_t> vertCode, std::span<const uint32_t> fragCode, const PipelineConfigInfo& configInfo
+) :
+    lveDevice{device} {
+    createGraphicsPipeline(vertCode, fragCode, configInfo);
 }
 
 LvePipeline::~LvePipeline() {
@@ -38,13 +51,10 @@ std::vector<char> LvePipeline::readFile(const std::string& filepath) {
     return buffer;
 }
 
-void LvePipeline::createGraphicsPipeline(const std::string& vertFilepath, const std::string& fragFilepath, const PipelineConfigInfo& configInfo) {
+void LvePipeline::createGraphicsPipeline(std::span<const uint32_t> vertCode, std::span<const uint32_t> fragCode, const PipelineConfigInfo& configInfo) {
     assert(configInfo.pipelineLayout != VK_NULL_HANDLE && "Cannot create graphics pipeline: no pipelineLayout provided in configInfo");
     assert(configInfo.renderPass != VK_NULL_HANDLE && "Cannot create graphics pipeline: no renderPass provided in configInfo");
 
-    auto vertCode = readFile(vertFilepath);
-    auto fragCode = readFile(fragFilepath);
-
     createShaderModule(vertCode, &vertShaderModule);
     createShaderModule(fragCode, &fragShaderModule);
 
@@ -93,16 +103,16 @@ void LvePipeline::createGraphicsPipeline(const std::string& vertFilepath, const
     pipelineInfo.basePipelineIndex = -1;
     pipelineInfo.basePipelineHandle = VK_NULL_HANDLE;
 
-    if (vkCreateGraphicsPipelines(lveDevice.device(), VK_NULL_HANDLE, 1, &pipelineInfo, nullptr, &graphicsPipeline) != VK_SUCCESS) {
+    if (vkCreateGraphicsPipelines(lveDevice.device(), lveDevice.getPipelineCache(), 1, &pipelineInfo, nullptr, &graphicsPipeline) != VK_SUCCESS) {
         throw std::runtime_error("failed to create graphics pipeline");
     }
 }
 
-void LvePipeline::createShaderModule(const std::vector<char>& code, VkShaderModule* shaderModule) {
+void LvePipeline::createShaderModule(std::span<const uint32_t> code, VkShaderModule* shaderModule) {
     VkShaderModuleCreateInfo createInfo{};
     createInfo.sType = VK_STRUCTURE_TYPE_SHADER_MODULE_CREATE_INFO;
-    createInfo.codeSize = code.size();
-    createInfo.pCode = reinterpret_cast<const uint32_t*>(code.data());
+    createInfo.codeSize = code.size_bytes();
+    createInfo.pCode = code.data();
 
     if (vkCreateShaderModule(lveDevice.device(), &createInfo, nullptr, shaderModule) != VK_SUCCESS) {
         throw std::runtime_error("failed to create shader module");
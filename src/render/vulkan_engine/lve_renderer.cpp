@@ -8,8 +8,13 @@
 namespace lve {
 
 LveRenderer::LveRenderer(LveWindow& window, LveDevice& device) : lveWindow{window}, lveDevice{device} {
-    recreateSwapChain();
+    if (lveWindow.isHeadless()) {
+        offscreenTarget = std::make_unique<LveOffscreenTarget>(lveDevice, lveWindow.getExtent());
+    } else {
+        recreateSwapChain();
+    }
     createCommandBuffers();
+    gpuProfiler = std::make_unique<LveGpuProfiler>(lveDevice, lveDevice.getGraphicsQueueFamily());
 }
 
 LveRenderer::~LveRenderer() {
@@ -25,10 +30,10 @@ void LveRenderer::recreateSwapChain() {
     vkDeviceWaitIdle(lveDevice.device());
 
     if (lveSwapChain == nullptr) {
-        lveSwapChain = std::make_unique<LveSwapChain>(lveDevice, extent);
+        lveSwapChain = std::make_unique<LveSwapChain>(lveDevice, extent, preferredPresentMode);
     } else {
         std::shared_ptr<LveSwapChain> oldSwapChain = std::move(lveSwapChain);
-        lveSwapChain = std::make_unique<LveSwapChain>(lveDevice, extent, oldSwapChain);
+        lveSwapChain = std::make_unique<LveSwapChain>(lveDevice, extent, oldSwapChain, preferredPresentMode);
 
         if (!oldSwapChain->compareSwapFormats(*lveSwapChain.get())) {
             throw std::runtime_error("Swap chain image(or depth) format has changed!");
@@ -36,6 +41,20 @@ void LveRenderer::recreateSwapChain() {
     }
 }
 
+void LveRenderer::setPresentMode(VkPresentModeKHR presentMode) {
+    preferredPresentMode = presentMode;
+
+    if (offscreenTarget) {
+        return;
+    }
+
+    if (isFrameStarted) {
+        presentModeChanged = true;
+    } else {
+        recreateSwapChain();
+    }
+}
+
 void LveRenderer::createCommandBuffers() {
     commandBuffers.resize(LveSwapChain::MAX_FRAMES_IN_FLIGHT);
 
@@ -58,6 +77,11 @@ void LveRenderer::freeCommandBuffers() {
 VkCommandBuffer LveRenderer::beginFrame() {
     assert(!isFrameStarted && "Can't call beginFrame while already in progress");
 
+    if (offscreenTarget) {
+        offscreenTarget->acquireNextImage(&currentImageIndex);
+        return beginCommandBuffer();
+    }
+
     auto result = lveSwapChain->acquireNextImage(&currentImageIndex);
     if (result == VK_ERROR_OUT_OF_DATE_KHR) {
         recreateSwapChain();
@@ -68,6 +92,10 @@ VkCommandBuffer LveRenderer::beginFrame() {
         throw std::runtime_error("failed to acquire swap chain image!");
     }
 
+    return beginCommandBuffer();
+}
+
+VkCommandBuffer LveRenderer::beginCommandBuffer() {
     isFrameStarted = true;
 
     auto                     commandBuffer = getCurrentCommandBuffer();
@@ -77,19 +105,35 @@ VkCommandBuffer LveRenderer::beginFrame() {
     if (vkBeginCommandBuffer(commandBuffer, &beginInfo) != VK_SUCCESS) {
         throw std::runtime_error("failed to begin recording command buffer!");
     }
+
+    // The slot's fence was waited on while acquiring, so its previous timestamps are ready
+    gpuProfiler->beginFrame(commandBuffer, currentFrameIndex);
     return commandBuffer;
 }
 
 void LveRenderer::endFrame() {
     assert(isFrameStarted && "Can't call endFrame while frame is not in progress");
     auto commandBuffer = getCurrentCommandBuffer();
+
+    if (offscreenTarget) {
+        offscreenTarget->recordReadback(commandBuffer, currentImageIndex);
+    }
+
     if (vkEndCommandBuffer(commandBuffer) != VK_SUCCESS) {
         throw std::runtime_error("failed to record command buffer!");
     }
 
+    if (offscreenTarget) {
+        offscreenTarget->submitCommandBuffers(&commandBuffer, &currentImageIndex);
+        isFrameStarted = false;
+        currentFrameIndex = (currentFrameIndex + 1) % LveSwapChain::MAX_FRAMES_IN_FLIGHT;
+        return;
+    }
+
     auto result = lveSwapChain->submitCommandBuffers(&commandBuffer, &currentImageIndex);
-    if (result == VK_ERROR_OUT_OF_DATE_KHR || result == VK_SUBOPTIMAL_KHR || lveWindow.wasWindowResized()) {
+    if (result == VK_ERROR_OUT_OF_DATE_KHR || result == VK_SUBOPTIMAL_KHR || lveWindow.wasWindowResized() || presentModeChanged) {
         lveWindow.resetWindowResizedFlag();
+        presentModeChanged = false;
         recreateSwapChain();
     } else if (result != VK_SUCCESS) {
         throw std::runtime_error("failed to present swap chain image!");
@@ -103,13 +147,16 @@ void LveRenderer::beginSwapChainRenderPass(VkCommandBuffer commandBuffer) {
     assert(isFrameStarted && "Can't call beginSwapChainRenderPass if frame is not in progress");
     assert(commandBuffer == getCurrentCommandBuffer() && "Can't begin render pass on command buffer from a different frame");
 
+    const VkExtent2D extent = offscreenTarget ? offscreenTarget->getExtent() : lveSwapChain->getSwapChainExtent();
+
     VkRenderPassBeginInfo renderPassInfo{};
     renderPassInfo.sType = VK_STRUCTURE_TYPE_RENDER_PASS_BEGIN_INFO;
-    renderPassInfo.renderPass = lveSwapChain->getRenderPass();
-    renderPassInfo.framebuffer = lveSwapChain->getFrameBuffer(currentImageIndex);
+    renderPassInfo.renderPass = getSwapChainRenderPass();
+    renderPassInfo.framebuffer =
+        offscreenTarget ? offscreenTarget->getFrameBuffer(currentImageIndex) : lveSwapChain->getFrameBuffer(currentImageIndex);
 
     renderPassInfo.renderArea.offset = {0, 0};
-    renderPassInfo.renderArea.extent = lveSwapChain->getSwapChainExtent();
+    renderPassInfo.renderArea.extent = extent;
 
     std::array<VkClearValue, 2> clearValues{};
     clearValues[0].color = {0.2f, 0.3f, 0.3f, 1.0f};
@@ -122,11 +169,11 @@ void LveRenderer::beginSwapChainRenderPass(VkCommandBuffer commandBuffer) {
     VkViewport viewport{};
     viewport.x = 0.0f;
     viewport.y = 0.0f;
-    viewport.width = static_cast<float>(lveSwapChain->getSwapChainExtent().width);
-    viewport.height = static_cast<float>(lveSwapChain->getSwapChainExtent().height);
+    viewport.width = static_cast<float>(extent.width);
+    viewport.height = static_cast<float>(extent.height);
     viewport.minDepth = 0.0f;
     viewport.maxDepth = 1.0f;
-    VkRect2D scissor{{0, 0}, lveSwapChain->getSwapChainExtent()};
+    VkRect2D scissor{{0, 0}, extent};
     vkCmdSetViewport(commandBuffer, 0, 1, &viewport);
     vkCmdSetScissor(commandBuffer, 0, 1, &scissor);
 }
@@ -11,12 +11,15 @@
 
 namespace lve {
 
-LveSwapChain::LveSwapChain(LveDevice& deviceRef, VkExtent2D extent) : device{deviceRef}, windowExtent{extent} {
+LveSwapChain::LveSwapChain(LveDevice& deviceRef, VkExtent2D extent, VkPresentModeKHR preferredPresentMode) :
+    preferredPresentMode{preferredPresentMode}, device{deviceRef}, windowExtent{extent} {
     init();
 }
 
-LveSwapChain::LveSwapChain(LveDevice& deviceRef, VkExtent2D extent, std::shared_ptr<LveSwapChain> previous) :
-    device{deviceRef}, windowExtent{extent}, oldSwapChain{previous} {
+LveSwapChain::LveSwapChain(
+    LveDevice& deviceRef, VkExtent2D extent, std::shared_ptr<LveSwapChain> previous, VkPresentModeKHR preferredPresentMode
+) :
+    preferredPresentMode{preferredPresentMode}, device{deviceRef}, windowExtent{extent}, oldSwapChain{previous} {
     init();
     oldSwapChain = nullptr;
 }
@@ -123,7 +126,7 @@ void LveSwapChain::createSwapChain() {
     SwapChainSupportDetails swapChainSupport = device.getSwapChainSupport();
 
     VkSurfaceFormatKHR surfaceFormat = chooseSwapSurfaceFormat(swapChainSupport.formats);
-    VkPresentModeKHR   presentMode = chooseSwapPresentMode(swapChainSupport.presentModes);
+    presentMode = chooseSwapPresentMode(swapChainSupport.presentModes);
     VkExtent2D         extent = chooseSwapExtent(swapChainSupport.capabilities);
 
     uint32_t imageCount = swapChainSupport.capabilities.minImageCount + 1;
@@ -357,23 +360,31 @@ VkSurfaceFormatKHR LveSwapChain::chooseSwapSurfaceFormat(const std::vector<VkSur
 
 VkPresentModeKHR LveSwapChain::chooseSwapPresentMode(const std::vector<VkPresentModeKHR>& availablePresentModes) {
     for (const auto& availablePresentMode : availablePresentModes) {
-        if (availablePresentMode == VK_PRESENT_MODE_MAILBOX_KHR) {
-            std::cout << "Present mode: Mailbox" << std::endl;
+        if (availablePresentMode == preferredPresentMode) {
+            std::cout << "Present mode: " << getPresentModeName(availablePresentMode) << std::endl;
             return availablePresentMode;
         }
     }
 
-    // for (const auto &availablePresentMode : availablePresentModes) {
-    //   if (availablePresentMode == VK_PRESENT_MODE_IMMEDIATE_KHR) {
-    //     std::cout << "Present mode: Immediate" << std::endl;
-    //     return availablePresentMode;
-    //   }
-    // }
-
-    std::cout << "Present mode: V-Sync" << std::endl;
+    std::cout << "Present mode: " << getPresentModeName(VK_PRESENT_MODE_FIFO_KHR) << std::endl;
     return VK_PRESENT_MODE_FIFO_KHR;
 }
 
+const char* LveSwapChain::getPresentModeName(VkPresentModeKHR presentMode) {
+    switch (presentMode) {
+        case VK_PRESENT_MODE_IMMEDIATE_KHR:
+            return "Immediate";
+        case VK_PRESENT_MODE_MAILBOX_KHR:
+            return "Mailbox";
+        case VK_PRESENT_MODE_FIFO_KHR:
+            return "V-Sync";
+        case VK_PRESENT_MODE_FIFO_RELAXED_KHR:
+            return "Relaxed V-Sync";
+        default:
+            return "Unknown";
+    }
+}
+
 VkExtent2D LveSwapChain::chooseSwapExtent(const VkSurfaceCapabilitiesKHR& capabilities) {
     if (capabilities.currentExtent.width != std::numeric_limits<uint32_t>::max()) {
         return capabilities.currentExtent;
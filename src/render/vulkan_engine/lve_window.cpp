@@ -1,17 +1,22 @@
 #include "vulkan_engine/lve_window.hpp"
 
 // std
+#include <algorithm>
 #include <stdexcept>
 
 namespace lve {
 
-LveWindow::LveWindow(int w, int h, std::string name) : width{w}, height{h}, windowName{name} {
-    initWindow();
+LveWindow::LveWindow(int w, int h, std::string name, bool headless) : width{w}, height{h}, windowName{name} {
+    if (!headless) {
+        initWindow();
+    }
 }
 
 LveWindow::~LveWindow() {
-    glfwDestroyWindow(window);
-    glfwTerminate();
+    if (window != nullptr) {
+        glfwDestroyWindow(window);
+        glfwTerminate();
+    }
 }
 
 void LveWindow::initWindow() {
@@ -22,6 +27,27 @@ void LveWindow::initWindow() {
     window = glfwCreateWindow(width, height, windowName.c_str(), nullptr, nullptr);
     glfwSetWindowUserPointer(window, this);
     glfwSetFramebufferSizeCallback(window, framebufferResizeCallback);
+
+    // Installed before ImGui, which chains to them from its own callbacks
+    glfwSetKeyCallback(window, [](GLFWwindow* window, int, int, int action, int) {
+        markInputReceived(window, action == GLFW_PRESS ? 1 : action == GLFW_RELEASE ? -1 : 0);
+    });
+    glfwSetMouseButtonCallback(window, [](GLFWwindow* window, int, int action, int) {
+        markInputReceived(window, action == GLFW_PRESS ? 1 : action == GLFW_RELEASE ? -1 : 0);
+    });
+    glfwSetCharCallback(window, [](GLFWwindow* window, unsigned int) { markInputReceived(window); });
+    glfwSetCursorPosCallback(window, [](GLFWwindow* window, double, double) { markInputReceived(window); });
+    glfwSetCursorEnterCallback(window, [](GLFWwindow* window, int) { markInputReceived(window); });
+    glfwSetScrollCallback(window, [](GLFWwindow* window, double, double) { markInputReceived(window); });
+    glfwSetWindowRefreshCallback(window, [](GLFWwindow* window) { markInputReceived(window); });
+    glfwSetWindowFocusCallback(window, [](GLFWwindow* window, int focused) {
+        markInputReceived(window);
+
+        // Releases are not reported to unfocused windows
+        if (!focused) {
+            reinterpret_cast<LveWindow*>(glfwGetWindowUserPointer(window))->pressedInputs = 0;
+        }
+    });
 }
 
 void LveWindow::createWindowSurface(VkInstance instance, VkSurfaceKHR* surface) {
@@ -33,8 +59,15 @@ void LveWindow::createWindowSurface(VkInstance instance, VkSurfaceKHR* surface)
 void LveWindow::framebufferResizeCallback(GLFWwindow* window, int width, int height) {
     auto lveWindow = reinterpret_cast<LveWindow*>(glfwGetWindowUserPointer(window));
     lveWindow->framebufferResized = true;
+    lveWindow->inputReceived = true;
     lveWindow->width = width;
     lveWindow->height = height;
 }
 
+void LveWindow::markInputReceived(GLFWwindow* window, int pressedDelta) {
+    auto lveWindow = reinterpret_cast<LveWindow*>(glfwGetWindowUserPointer(window));
+    lveWindow->inputReceived = true;
+    lveWindow->pressedInputs = std::max(0, lveWindow->pressedInputs + pressedDelta);
+}
+
 }  // namespace lve
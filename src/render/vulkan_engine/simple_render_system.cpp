@@ -1,4 +1,5 @@
 #include "vulkan_engine/simple_render_system.hpp"
+#include "vulkan_engine/embedded_shaders.hpp"
 
 // libs
 #define GLM_FORCE_RADIANS
@@ -53,7 +54,7 @@ void SimpleRenderSystem::createPipeline(VkRenderPass renderPass) {
     LvePipeline::defaultPipelineConfigInfo(pipelineConfig);
     pipelineConfig.renderPass = renderPass;
     pipelineConfig.pipelineLayout = pipelineLayout;
-    lvePipeline = std::make_unique<LvePipeline>(lveDevice, "src/render/shaders/vert.spv", "src/render/shaders/frag.spv", pipelineConfig);
+    lvePipeline = std::make_unique<LvePipeline>(lveDevice, shaders::VERT_SPV, shaders::FRAG_SPV, pipelineConfig);
 }
 
 void SimpleRenderSystem::renderGameObjects(FrameInfo& frameInfo, std::vector<LveGameObject>& gameObjects) {
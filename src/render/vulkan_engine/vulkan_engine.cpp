@@ -8,6 +8,7 @@
 #include "physics/box2d_distance_sensor.hpp"
 
 #include "constants.hpp"
+#include "micrasverse_core/profiler.hpp"
 
 // libs
 #define GLM_FORCE_RADIANS
@@ -19,6 +20,9 @@
 #include <array>
 #include <cassert>
 #include <chrono>
+#include <iostream>
+#include <iterator>
+#include <unordered_map>
 #include <stdexcept>
 #include <cmath>
 
@@ -28,7 +32,8 @@ struct GlobalUbo {
     glm::mat4 projectionView{1.f};
 };
 
-VulkanEngine::VulkanEngine(std::shared_ptr<micrasverse::simulation::SimulationEngine> engine) : simulationEngine(engine) {
+VulkanEngine::VulkanEngine(std::shared_ptr<micrasverse::simulation::SimulationEngine> engine, bool headless) :
+    lveWindow{WIDTH, HEIGHT, "Micrasverse", headless}, simulationEngine(engine) {
     globalPool = LveDescriptorPool::Builder(lveDevice)
                      .setMaxSets(LveSwapChain::MAX_FRAMES_IN_FLIGHT)
                      .addPoolSize(VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER, LveSwapChain::MAX_FRAMES_IN_FLIGHT)
@@ -222,29 +227,85 @@ void VulkanEngine::loadMazeFloor() {
     gameObjects.push_back(std::move(floor));
 }
 
+LveGameObject VulkanEngine::createWallObject(const micrasverse::physics::Maze::Element& wall) {
+    // Every wall is the same unit rectangle scaled to its size, so they all share one model
+    if (!this->wallModel) {
+        this->wallModel = createRectModel(lveDevice, {.0f, .0f, .0f}, {0.5f, 0.0f, 0.0f});
+    }
+
+    auto wallObject = LveGameObject::createGameObject();
+    wallObject.model = this->wallModel;
+    wallObject.transform.translation = glm::vec3(wall.position.x, -wall.position.y, 0.0f);
+    wallObject.transform.scale = glm::vec3(wall.size.x, wall.size.y, 0.f);
+    return wallObject;
+}
+
 void VulkanEngine::loadMazeWalls() {
     this->first_wall_index = gameObjects.size();
 
     for (auto& wall : simulationEngine->physicsEngine->getMaze().getElements()) {
-        std::shared_ptr<LveModel> lveModel = createRectModel(lveDevice, {.0f, .0f, .0f}, {0.5f, 0.0f, 0.0f});
-        auto                      wallObject = LveGameObject::createGameObject();
-        wallObject.model = lveModel;
-        wallObject.transform.translation = glm::vec3(wall.position.x, -wall.position.y, 0.0f);
-        wallObject.transform.scale = glm::vec3(wall.size.x, wall.size.y, 0.f);
+        this->wall_keys.push_back(micrasverse::physics::Maze::getElementKey(wall));
         this->number_of_walls++;
-        gameObjects.push_back(std::move(wallObject));
+        gameObjects.push_back(this->createWallObject(wall));
     }
 }
 
 void VulkanEngine::reloadMazeWalls() {
-    // remove walls from game objects
-    gameObjects.erase(gameObjects.begin() + first_wall_index, gameObjects.begin() + number_of_walls + first_wall_index);
-    // run loadMazeWalls
-    this->number_of_walls = 0;
-    this->walls_set.clear();
+    const auto startTime = std::chrono::steady_clock::now();
+
+    std::unordered_map<uint64_t, int> currentIndices;
+    currentIndices.reserve(this->wall_keys.size());
+    for (size_t i = 0; i < this->wall_keys.size(); i++) {
+        currentIndices.emplace(this->wall_keys[i], this->first_wall_index + static_cast<int>(i));
+    }
+
+    // Walls the new maze still has are moved over, only the new ones are created
+    const auto&                elements = simulationEngine->physicsEngine->getMaze().getElements();
+    std::vector<LveGameObject> walls;
+    std::vector<uint64_t>      keys;
+    walls.reserve(elements.size());
+    keys.reserve(elements.size());
+
+    micrasverse::physics::MazeDelta delta;
+    for (const auto& wall : elements) {
+        const uint64_t key = micrasverse::physics::Maze::getElementKey(wall);
+        const auto     current = currentIndices.find(key);
+
+        if (current != currentIndices.end()) {
+            walls.push_back(std::move(gameObjects[current->second]));
+            currentIndices.erase(current);
+            delta.kept++;
+        } else {
+            walls.push_back(this->createWallObject(wall));
+            delta.added++;
+        }
+        keys.push_back(key);
+    }
+    delta.removed = this->wall_keys.size() - delta.kept;
+
+    // Only the maze wall range is replaced, the floor right after it stays
+    const auto firstWall = gameObjects.begin() + this->first_wall_index;
+    gameObjects.erase(firstWall, firstWall + this->number_of_walls);
+    gameObjects.insert(gameObjects.begin() + this->first_wall_index, std::make_move_iterator(walls.begin()), std::make_move_iterator(walls.end()));
 
-    this->loadMazeWalls();
-    this->loadMazeFloor();
+    this->number_of_walls = static_cast<int>(walls.size());
+    this->wall_keys = std::move(keys);
+
+    // The firmware walls and the route markers come after the floor, they are dropped and drawn again from the
+    // current firmware state
+    gameObjects.erase(gameObjects.begin() + this->first_wall_index + this->number_of_walls + 1, gameObjects.end());
+    this->number_of_firmware_walls = 0;
+    this->walls_set.clear();
+    this->number_of_route_markers = 0;
+    this->first_route_marker_index = gameObjects.size();
+    this->loadBestRoute();
+
+    const auto&  physicsReload = simulationEngine->physicsEngine->getLastMazeReload();
+    const double renderMilliseconds = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - startTime).count();
+    std::cout << "Maze reloaded (" << (physicsReload.mode == micrasverse::physics::MazeReloadMode::INCREMENTAL ? "incremental" : "full")
+              << "): physics " << physicsReload.delta.added << " added, " << physicsReload.delta.removed << " removed, "
+              << physicsReload.delta.kept << " kept in " << physicsReload.milliseconds << " ms; walls " << delta.added << " added, "
+              << delta.removed << " removed, " << delta.kept << " kept in " << renderMilliseconds << " ms" << std::endl;
 }
 
 void VulkanEngine::loadFirmwareMazeWalls() {
@@ -318,7 +379,7 @@ void VulkanEngine::loadFirmwareMazeWalls() {
                     wallObject.model = lveModel;
                     wallObject.transform.translation = glm::vec3(posX, -posY, -0.00001f);
                     wallObject.transform.scale = glm::vec3(sizeX, sizeY, 0.0f);
-                    number_of_walls++;
+                    this->number_of_firmware_walls++;
                     gameObjects.push_back(std::move(wallObject));
                 }
             }
@@ -358,15 +419,26 @@ void VulkanEngine::loadBestRoute() {
 }
 
 void VulkanEngine::loadMicras() {
-    std::shared_ptr<LveModel> lveModel = createRectModel(lveDevice, {.0f, .0f, .0f}, {0.0f, 0.5f, 0.0f});
-    auto                      micras = LveGameObject::createGameObject();
-    micras.model = lveModel;
-    micras.transform.translation =
-        glm::vec3(simulationEngine->physicsEngine->getMicras().getPosition().x, -simulationEngine->physicsEngine->getMicras().getPosition().y, 0.0f);
-    micras.transform.scale =
-        glm::vec3(simulationEngine->physicsEngine->getMicras().getSize().x, simulationEngine->physicsEngine->getMicras().getSize().y, 0.f);
+    // The first robot keeps the original color, the others cycle through a small palette
+    static const std::array<glm::vec3, 4> robotColors{{
+        {0.0f, 0.5f, 0.0f},
+        {0.0f, 0.3f, 0.7f},
+        {0.7f, 0.4f, 0.0f},
+        {0.5f, 0.0f, 0.6f},
+    }};
+
     this->micrasIndex = gameObjects.size();
-    gameObjects.push_back(std::move(micras));
+
+    for (size_t robot = 0; robot < simulationEngine->physicsEngine->getMicrasCount(); robot++) {
+        auto& micrasBody = simulationEngine->physicsEngine->getMicras(robot);
+
+        std::shared_ptr<LveModel> lveModel = createRectModel(lveDevice, {.0f, .0f, .0f}, robotColors[robot % robotColors.size()]);
+        auto                      micras = LveGameObject::createGameObject();
+        micras.model = lveModel;
+        micras.transform.translation = glm::vec3(micrasBody.getPosition().x, -micrasBody.getPosition().y, 0.0f);
+        micras.transform.scale = glm::vec3(micrasBody.getSize().x, micrasBody.getSize().y, 0.f);
+        gameObjects.push_back(std::move(micras));
+    }
 }
 
 void VulkanEngine::loadARGB() {
@@ -382,47 +454,53 @@ void VulkanEngine::loadARGB() {
 }
 
 void VulkanEngine::loadLidar() {
-    for (size_t i = 0; i < simulationEngine->physicsEngine->getMicras().getDistanceSensorCount(); i++) {
-        std::shared_ptr<LveModel> lveModel = createRectModel(lveDevice, {.0f, .0f, .0f}, {1.0f, 0.1f, 0.1f});
-        auto                      lidarObject = LveGameObject::createGameObject();
-        lidarObject.model = lveModel;
-        lidarObject.transform.translation = glm::vec3(
-            simulationEngine->physicsEngine->getMicras().getDistanceSensor(i).getVisualMidPoint().x,
-            -simulationEngine->physicsEngine->getMicras().getDistanceSensor(i).getVisualMidPoint().y, 0.0f
-        );
-        lidarObject.transform.scale = glm::vec3(0.005f, simulationEngine->physicsEngine->getMicras().getDistanceSensor(i).getReadingVisual(), 0.0f);
-        gameObjects.push_back(std::move(lidarObject));
+    for (size_t robot = 0; robot < simulationEngine->physicsEngine->getMicrasCount(); robot++) {
+        auto& micrasBody = simulationEngine->physicsEngine->getMicras(robot);
+
+        for (size_t i = 0; i < micrasBody.getDistanceSensorCount(); i++) {
+            std::shared_ptr<LveModel> lveModel = createRectModel(lveDevice, {.0f, .0f, .0f}, {1.0f, 0.1f, 0.1f});
+            auto                      lidarObject = LveGameObject::createGameObject();
+            lidarObject.model = lveModel;
+            lidarObject.transform.translation =
+                glm::vec3(micrasBody.getDistanceSensor(i).getVisualMidPoint().x, -micrasBody.getDistanceSensor(i).getVisualMidPoint().y, 0.0f);
+            lidarObject.transform.scale = glm::vec3(0.005f, micrasBody.getDistanceSensor(i).getReadingVisual(), 0.0f);
+            gameObjects.push_back(std::move(lidarObject));
+        }
     }
     this->lidarIndex = gameObjects.size();
 }
 
 void VulkanEngine::updateRenderableModels() {
-    auto& micras = gameObjects[micrasIndex];
-    micras.transform.translation =
-        glm::vec3(simulationEngine->physicsEngine->getMicras().getPosition().x, -simulationEngine->physicsEngine->getMicras().getPosition().y, 0.0f);
-    micras.transform.rotation = glm::vec3(0.f, 0.f, -simulationEngine->physicsEngine->getMicras().getAngle());
-
-    // for (size_t i = 0; i < simulationEngine->physicsEngine->getMicras().getArgbs().size(); i++) {
-    //     auto& argb = gameObjects[argbIndex - simulationEngine->physicsEngine->getMicras().getArgbs().size() + i];
-    //     argb.transform.translation = glm::vec3(
-    //         simulationEngine->physicsEngine->getMicras().getArgbs()[i]->worldPosition.x,
-    //         -simulationEngine->physicsEngine->getMicras().getArgbs()[i]->worldPosition.y, 0.0f
-    //     );
-    //     argb.transform.rotation = glm::vec3(0.f, 0.f, -simulationEngine->physicsEngine->getMicras().getAngle());
-    // }
+    MICRASVERSE_PROFILE_ZONE("updateRenderableModels");
+
+    const size_t robotCount = simulationEngine->physicsEngine->getMicrasCount();
+    size_t       lidarObjectIndex = lidarIndex;
 
-    for (size_t i = 0; i < simulationEngine->physicsEngine->getMicras().getDistanceSensorCount(); i++) {
-        auto& sensor = gameObjects[lidarIndex - simulationEngine->physicsEngine->getMicras().getDistanceSensorCount() + i];
-        sensor.transform.translation = glm::vec3(
-            simulationEngine->physicsEngine->getMicras().getDistanceSensor(i).getVisualMidPoint().x,
-            -simulationEngine->physicsEngine->getMicras().getDistanceSensor(i).getVisualMidPoint().y, 0.0f
-        );
-        float angle = std::atan2(
-            simulationEngine->physicsEngine->getMicras().getDistanceSensor(i).getRayDirection().y,
-            simulationEngine->physicsEngine->getMicras().getDistanceSensor(i).getRayDirection().x
-        );
-        sensor.transform.rotation = glm::vec3(0.f, 0.f, -angle);
-        sensor.transform.scale = glm::vec3(0.005f, simulationEngine->physicsEngine->getMicras().getDistanceSensor(i).getReadingVisual(), 0.0f);
+    for (size_t robot = 0; robot < robotCount; robot++) {
+        lidarObjectIndex -= simulationEngine->physicsEngine->getMicras(robot).getDistanceSensorCount();
+    }
+
+    for (size_t robot = 0; robot < robotCount; robot++) {
+        auto& micrasBody = simulationEngine->physicsEngine->getMicras(robot);
+
+        auto& micras = gameObjects[micrasIndex + robot];
+        micras.transform.translation = glm::vec3(micrasBody.getPosition().x, -micrasBody.getPosition().y, 0.0f);
+        micras.transform.rotation = glm::vec3(0.f, 0.f, -micrasBody.getAngle());
+
+        // for (size_t i = 0; i < micrasBody.getArgbs().size(); i++) {
+        //     auto& argb = gameObjects[argbIndex - micrasBody.getArgbs().size() + i];
+        //     argb.transform.translation = glm::vec3(micrasBody.getArgbs()[i]->worldPosition.x, -micrasBody.getArgbs()[i]->worldPosition.y, 0.0f);
+        //     argb.transform.rotation = glm::vec3(0.f, 0.f, -micrasBody.getAngle());
+        // }
+
+        for (size_t i = 0; i < micrasBody.getDistanceSensorCount(); i++) {
+            auto& sensor = gameObjects[lidarObjectIndex++];
+            sensor.transform.translation =
+                glm::vec3(micrasBody.getDistanceSensor(i).getVisualMidPoint().x, -micrasBody.getDistanceSensor(i).getVisualMidPoint().y, 0.0f);
+            float angle = std::atan2(micrasBody.getDistanceSensor(i).getRayDirection().y, micrasBody.getDistanceSensor(i).getRayDirection().x);
+            sensor.transform.rotation = glm::vec3(0.f, 0.f, -angle);
+            sensor.transform.scale = glm::vec3(0.005f, micrasBody.getDistanceSensor(i).getReadingVisual(), 0.0f);
+        }
     }
 
     loadFirmwareMazeWalls();
@@ -0,0 +1,56 @@
+#include "simulation/controller_configs.hpp"
+
+#include <array>
+
+namespace micrasverse::simulation {
+
+namespace {
+
+#define TUNABLE_PARAMETER(name, member) \
+    TunableParameter { name, [](ControllerConfigs& configs) -> float& { return configs.member; } }
+
+const std::array TUNABLE_PARAMETERS{
+    TUNABLE_PARAMETER("speed_controller.linear_pid.kp", speedController.linear_pid.kp),
+    TUNABLE_PARAMETER("speed_controller.linear_pid.ki", speedController.linear_pid.ki),
+    TUNABLE_PARAMETER("speed_controller.linear_pid.kd", speedController.linear_pid.kd),
+    TUNABLE_PARAMETER("speed_controller.angular_pid.kp", speedController.angular_pid.kp),
+    TUNABLE_PARAMETER("speed_controller.angular_pid.ki", speedController.angular_pid.ki),
+    TUNABLE_PARAMETER("speed_controller.angular_pid.kd", speedController.angular_pid.kd),
+    TUNABLE_PARAMETER("follow_wall.pid.kp", followWall.pid.kp),
+    TUNABLE_PARAMETER("follow_wall.pid.ki", followWall.pid.ki),
+    TUNABLE_PARAMETER("follow_wall.pid.kd", followWall.pid.kd),
+    TUNABLE_PARAMETER("follow_wall.post_threshold", followWall.post_threshold),
+    TUNABLE_PARAMETER("follow_wall.post_reference", followWall.post_reference),
+    TUNABLE_PARAMETER("follow_wall.post_clearance", followWall.post_clearance),
+    TUNABLE_PARAMETER("action_queuer.curve_safety_margin", actionQueuer.curve_safety_margin),
+    TUNABLE_PARAMETER("action_queuer.exploring.max_linear_speed", actionQueuer.exploring.max_linear_speed),
+    TUNABLE_PARAMETER("action_queuer.exploring.max_linear_acceleration", actionQueuer.exploring.max_linear_acceleration),
+    TUNABLE_PARAMETER("action_queuer.exploring.max_linear_deceleration", actionQueuer.exploring.max_linear_deceleration),
+    TUNABLE_PARAMETER("action_queuer.exploring.max_centrifugal_acceleration", actionQueuer.exploring.max_centrifugal_acceleration),
+    TUNABLE_PARAMETER("action_queuer.exploring.max_angular_acceleration", actionQueuer.exploring.max_angular_acceleration),
+    TUNABLE_PARAMETER("action_queuer.solving.max_linear_speed", actionQueuer.solving.max_linear_speed),
+    TUNABLE_PARAMETER("action_queuer.solving.max_linear_acceleration", actionQueuer.solving.max_linear_acceleration),
+    TUNABLE_PARAMETER("action_queuer.solving.max_linear_deceleration", actionQueuer.solving.max_linear_deceleration),
+    TUNABLE_PARAMETER("action_queuer.solving.max_centrifugal_acceleration", actionQueuer.solving.max_centrifugal_acceleration),
+    TUNABLE_PARAMETER("action_queuer.solving.max_angular_acceleration", actionQueuer.solving.max_angular_acceleration),
+};
+
+#undef TUNABLE_PARAMETER
+
+}  // namespace
+
+std::span<const TunableParameter> getTunableParameters() {
+    return TUNABLE_PARAMETERS;
+}
+
+const TunableParameter* findTunableParameter(std::string_view name) {
+    for (const auto& parameter : TUNABLE_PARAMETERS) {
+        if (parameter.name == name) {
+            return &parameter;
+        }
+    }
+
+    return nullptr;
+}
+
+}  // namespace micrasverse::simulation
@@ -0,0 +1,112 @@
+#ifndef COMMAND_HPP
+#define COMMAND_HPP
+
+#include "simulation/robot.hpp"
+#include "micras/interface.hpp"
+#include "micras/proxy/button.hpp"
+#include "micrasverse_core/types.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <variant>
+
+namespace micrasverse::simulation {
+
+// Requests from the UI or scripts, queued from any thread and applied by the simulation at the start of its next step
+namespace commands {
+
+struct SendEvent {
+    micras::Interface::Event event;
+};
+
+struct AcknowledgeEvent {
+    micras::Interface::Event event;
+};
+
+// Held until another status is sent, the UI releases the button itself
+struct SetButtonStatus {
+    micras::proxy::Button::Status status;
+};
+
+// Linear and angular speed commands of the firmware locomotion
+struct SetCommand {
+    float linear;
+    float angular;
+};
+
+struct SetWheelCommand {
+    float left;
+    float right;
+};
+
+struct StopMotors { };
+
+struct SetMotorsEnabled {
+    bool enabled;
+};
+
+struct SetDipSwitch {
+    uint8_t index;
+    bool    state;
+};
+
+// Every ARGB LED
+struct SetArgbColor {
+    types::Color color;
+};
+
+struct TurnOffArgb { };
+
+struct SetLedColor {
+    uint8_t index;
+    uint8_t red;
+    uint8_t green;
+    uint8_t blue;
+};
+
+struct PlayBuzzer {
+    float    frequency;  // Hz
+    uint32_t duration;   // ms
+};
+
+struct StopBuzzer { };
+
+// Restarts the firmware, the body is left where it is
+struct ResetFirmware { };
+
+struct Calibrate {
+    enum class Target : uint8_t {
+        FRONT_WALL,
+        LEFT_WALL,
+        RIGHT_WALL,
+        IMU
+    };
+
+    Target target;
+};
+
+// Apply to every robot, the robot index of the command is ignored
+struct SetSensorPeriods {
+    SensorPeriods periods;
+};
+
+struct SetPhysicsPeriod {
+    float period;
+};
+
+}  // namespace commands
+
+struct Command {
+    using Action = std::variant<
+        commands::SendEvent, commands::AcknowledgeEvent, commands::SetButtonStatus, commands::SetCommand, commands::SetWheelCommand,
+        commands::StopMotors, commands::SetMotorsEnabled, commands::SetDipSwitch, commands::SetArgbColor, commands::TurnOffArgb,
+        commands::SetLedColor, commands::PlayBuzzer, commands::StopBuzzer, commands::ResetFirmware, commands::Calibrate,
+        commands::SetSensorPeriods, commands::SetPhysicsPeriod>;
+
+    size_t robot = 0;
+    Action action;
+};
+
+}  // namespace micrasverse::simulation
+
+#endif  // COMMAND_HPP
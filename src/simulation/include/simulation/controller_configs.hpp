@@ -0,0 +1,34 @@
+#ifndef CONTROLLER_CONFIGS_HPP
+#define CONTROLLER_CONFIGS_HPP
+
+#include "constants.hpp"
+
+#include <filesystem>
+#include <span>
+#include <string_view>
+
+namespace micrasverse::simulation {
+
+// Firmware settings a robot can be built with instead of the ones in constants.hpp.
+// By default the robot doesn't touch the saved maze, so tuned controllers start exploring from scratch.
+struct ControllerConfigs {
+    micras::nav::ActionQueuer::Config    actionQueuer{micras::action_queuer_config};
+    micras::nav::FollowWall::Config      followWall{micras::follow_wall_config};
+    micras::nav::SpeedController::Config speedController{micras::speed_controller_config};
+    std::filesystem::path                storagePath;  // empty keeps the maze storage in memory only
+};
+
+// A single float of ControllerConfigs that can be tuned by name, e.g. "speed_controller.linear_pid.kp"
+struct TunableParameter {
+    std::string_view name;
+    float& (*access)(ControllerConfigs& configs);
+};
+
+std::span<const TunableParameter> getTunableParameters();
+
+// Returns nullptr when there is no parameter with that name
+const TunableParameter* findTunableParameter(std::string_view name);
+
+}  // namespace micrasverse::simulation
+
+#endif  // CONTROLLER_CONFIGS_HPP
@@ -0,0 +1,35 @@
+#ifndef MAZE_REGIONS_HPP
+#define MAZE_REGIONS_HPP
+
+#include "constants.hpp"
+#include "micrasverse_core/types.hpp"
+
+#include <cmath>
+
+namespace micrasverse::simulation {
+
+// Column and row of the cell containing a point, the start cell is (0, 0)
+inline int getCellColumn(const types::Vec2& position) {
+    return static_cast<int>(std::floor((position.x - WALL_THICKNESS / 2.0f) / CELL_SIZE));
+}
+
+inline int getCellRow(const types::Vec2& position) {
+    return static_cast<int>(std::floor((position.y - WALL_THICKNESS / 2.0f) / CELL_SIZE));
+}
+
+// Whether the robot center is in one of the four center cells
+inline bool isInGoal(const types::Vec2& position) {
+    const int column = getCellColumn(position);
+    const int row = getCellRow(position);
+
+    return (column == MAZE_CELLS_WIDTH / 2 - 1 || column == MAZE_CELLS_WIDTH / 2) &&
+           (row == MAZE_CELLS_HEIGHT / 2 - 1 || row == MAZE_CELLS_HEIGHT / 2);
+}
+
+inline bool isInStartCell(const types::Vec2& position) {
+    return getCellColumn(position) == 0 && getCellRow(position) == 0;
+}
+
+}  // namespace micrasverse::simulation
+
+#endif  // MAZE_REGIONS_HPP
@@ -0,0 +1,56 @@
+#ifndef MULTI_RATE_SCHEDULER_HPP
+#define MULTI_RATE_SCHEDULER_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace micrasverse::simulation {
+
+// Runs every task at its own rate on the simulated clock. A task slower than the step skips the steps in between, one
+// faster than the step runs several times in the same step. Tasks due at the same time run in the order they were added.
+class MultiRateScheduler {
+public:
+    // Receives the time since its previous run, the period once it runs regularly
+    using Callback = std::function<void(float elapsed)>;
+
+    struct Task {
+        std::string name;
+        uint64_t    period;   // microseconds
+        uint64_t    phase;    // microseconds, offset of the first run from the start of the clock
+        uint64_t    nextRun;  // microseconds
+        uint64_t    lastRun;  // microseconds
+        uint64_t    runs = 0;
+        Callback    callback;
+    };
+
+    // Period and phase are in seconds and rounded to microseconds, a zero period is taken as one microsecond
+    size_t addTask(std::string name, float period, float phase, Callback callback);
+
+    // Keeps the phase of the task, the next run moves to the first one on the new period
+    void setPeriod(size_t task, float period);
+
+    // Advances the clock by the step, running every task due before its end
+    void step(float step);
+
+    // Restarts the clock, the tasks run again from their phase
+    void reset();
+
+    void clear();
+
+    float getTime() const { return this->now * 1e-6f; }
+
+    const std::vector<Task>& getTasks() const { return tasks; }
+
+private:
+    static uint64_t toMicroseconds(float seconds);
+
+    uint64_t          now = 0;
+    std::vector<Task> tasks;
+};
+
+}  // namespace micrasverse::simulation
+
+#endif  // MULTI_RATE_SCHEDULER_HPP
@@ -0,0 +1,103 @@
+#ifndef PARAMETER_SWEEP_HPP
+#define PARAMETER_SWEEP_HPP
+
+#include "simulation/controller_configs.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace micrasverse::physics {
+class Box2DPhysicsEngine;
+}  // namespace micrasverse::physics
+
+namespace micrasverse::simulation {
+
+// How the samples of a sweep are spread over the parameter ranges
+enum class SweepDesign : uint8_t {
+    GRID,             // every combination of gridSteps evenly spaced values per parameter
+    RANDOM,           // sampleCount uniformly random points
+    LATIN_HYPERCUBE,  // sampleCount points, every range split in sampleCount strata that are each used once
+};
+
+struct ParameterRange {
+    const TunableParameter* parameter;
+    float                   min;
+    float                   max;
+};
+
+// When a headless run gives up before reaching the goal
+struct RunLimits {
+    float timeout = 120.0f;    // simulated seconds
+    float stallTime = 10.0f;   // simulated seconds in the same cell of the firmware's pose, 0 never stalls
+    bool  stopOnCrash = true;  // end the run on the first impact with a wall
+};
+
+// Why a headless run ended
+enum class RunOutcome : uint8_t {
+    REACHED_GOAL,
+    CRASHED,
+    STALLED,
+    TIMED_OUT,
+};
+
+const char* getRunOutcomeName(RunOutcome outcome);
+
+struct SweepSettings {
+    std::vector<ParameterRange> ranges;
+    SweepDesign                 design = SweepDesign::GRID;
+    size_t                      gridSteps = 3;
+    size_t                      sampleCount = 16;
+    uint32_t                    seed = 0;
+    std::vector<std::string>    mazePaths;
+    RunLimits                   limits;
+    int                         workerCount = 0;      // runs simulated at the same time, 0 = hardware concurrency
+    bool                        reuseWorlds = false;  // runs on a maze that was already run only reset the robot, faster
+                                                      // but results then depend on which runs happened to share a world
+};
+
+// Outcome of one headless exploration run, from the start cell until the robot reaches the goal or hits a run limit
+struct RunResult {
+    size_t     sampleIndex = 0;
+    size_t     mazeIndex = 0;
+    RunOutcome outcome = RunOutcome::TIMED_OUT;
+    bool       reachedGoal = false;
+    float      runTime = 0.0f;          // seconds until the run ended
+    uint32_t   crashes = 0;             // impacts with a wall faster than WALL_HIT_SPEED
+    float      pathLength = 0.0f;       // meters
+    float      maxLateralError = 0.0f;  // meters from the center line of the cells, while aligned with the maze
+};
+
+// Runs the firmware with many controller configurations over a set of mazes, without rendering
+class ParameterSweep {
+public:
+    explicit ParameterSweep(SweepSettings settings);
+
+    // Parameter values of every sample, in the order of the settings ranges
+    const std::vector<std::vector<float>>& getSamples() const { return samples; }
+
+    // Simulates every sample on every maze in parallel, results are ordered by sample and then maze
+    std::vector<RunResult> run() const;
+
+    // Writes one CSV row per run, with the parameter values of its sample
+    void writeResults(std::ostream& output, const std::vector<RunResult>& results) const;
+
+    static RunResult runHeadless(const ControllerConfigs& configs, std::string_view mazePath, const RunLimits& limits);
+
+    // Runs on an engine whose robot is at rest in the start cell, like one taken from a world pool
+    static RunResult runHeadless(const ControllerConfigs& configs, physics::Box2DPhysicsEngine& engine, const RunLimits& limits);
+
+private:
+    void generateSamples();
+
+    SweepSettings                   settings;
+    std::vector<std::vector<float>> samples;
+    std::vector<ControllerConfigs>  sampleConfigs;
+};
+
+}  // namespace micrasverse::simulation
+
+#endif  // PARAMETER_SWEEP_HPP
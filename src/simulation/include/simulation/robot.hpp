@@ -0,0 +1,65 @@
+#ifndef ROBOT_HPP
+#define ROBOT_HPP
+
+#include "physics/robot_body.hpp"
+#include "simulation/controller_configs.hpp"
+#include "simulation/multi_rate_scheduler.hpp"
+#include "micras/micras.hpp"
+#include "micras/proxy/proxy_bridge.hpp"
+#include "constants.hpp"
+
+#include <cstddef>
+#include <memory>
+
+namespace micrasverse::simulation {
+
+// Sampling periods of the proxy sensors in seconds, the firmware reads the last sample between two of them
+struct SensorPeriods {
+    float wallSensors = STEP;
+    float encoders = STEP;
+    float imu = STEP;
+    float torque = 0.002f;
+    float battery = 0.02f;
+};
+
+struct Command;
+
+// Firmware instance driving one of the bodies of a physics engine
+class Robot {
+public:
+    // Without configs the firmware is built with the compiled-in settings
+    Robot(physics::RobotBody& micrasBody, size_t index, const ControllerConfigs* configs = nullptr);
+
+    Robot(const Robot&) = delete;
+    Robot& operator=(const Robot&) = delete;
+
+    // Computes the proxy readings of a sensor group from the body state
+    void sampleSensors(micras::ProxyBridge::SensorGroup group, float elapsed);
+
+    // One task per sensor group, they must be added before the task running the firmware
+    void addSamplingTasks(MultiRateScheduler& scheduler, const SensorPeriods& periods);
+
+    // Runs one firmware loop
+    void update();
+
+    // Forwards a queued command to the proxies, the ones for the whole simulation are left to the engine
+    void applyCommand(const Command& command);
+
+    size_t getIndex() const { return index; }
+
+    physics::RobotBody& getBody() { return micrasBody; }
+
+    micras::Micras& getController() { return *controller; }
+
+    std::shared_ptr<micras::ProxyBridge> getProxyBridge() const { return proxyBridge; }
+
+private:
+    physics::RobotBody&                  micrasBody;
+    size_t                               index;
+    std::unique_ptr<micras::Micras>      controller;
+    std::shared_ptr<micras::ProxyBridge> proxyBridge;
+};
+
+}  // namespace micrasverse::simulation
+
+#endif  // ROBOT_HPP
@@ -2,6 +2,11 @@
 #define SIMULATION_ENGINE_HPP
 
 #include "physics/box2d_physics_engine.hpp"
+#include "physics/physics_backend.hpp"
+#include "simulation/robot.hpp"
+#include "simulation/command.hpp"
+#include "simulation/multi_rate_scheduler.hpp"
+#include "micrasverse_core/mpsc_queue.hpp"
 #include "constants.hpp"
 #include <string>
 #include <memory>
@@ -9,9 +14,13 @@
 
 namespace micrasverse::simulation {
 
-class SimulationEngine {
+// The physics engine is a template parameter so the per-step calls into it are resolved at compile time
+template <physics::PhysicsBackend Engine>
+class TSimulationEngine {
 public:
-    SimulationEngine();
+    // Extra arguments are forwarded to the engine after the maze path and robot count
+    template <typename... EngineArgs>
+    explicit TSimulationEngine(size_t robotCount = 1, EngineArgs&&... engineArgs);
 
     void updateMazePaths(const std::string& folderPath);
 
@@ -23,6 +32,9 @@ public:
 
     void togglePause();
 
+    // Applies the queued commands, then advances the schedule by one step: every sensor group due is sampled, the
+    // firmware of every robot runs and the physics advances once for all of them, or several times when its period is
+    // shorter than the step
     void updateSimulation(float step = micrasverse::STEP);
 
     void stepThroughSimulation(float step = micrasverse::STEP);
@@ -31,25 +43,64 @@ public:
 
     void resetSimulation(const std::string& mazeFilePath);
 
-    void setPhysicsEngine(std::shared_ptr<physics::Box2DPhysicsEngine> engine);
+    void setPhysicsEngine(std::shared_ptr<Engine> engine);
 
     void  updateRunTimer();
     float getElapsedRunTime() const;
 
-    bool                                         isPaused{false};
-    bool                                         wasReset{false};
-    std::shared_ptr<physics::Box2DPhysicsEngine> physicsEngine;
-    int                                          stepCounter = 0;
+    Robot& addRobot();
+
+    Robot& getRobot(size_t index = 0) { return *robots.at(index); }
+
+    size_t getRobotCount() const { return robots.size(); }
+
+    // Periods apply to every robot, the firmware keeps running every STEP as its loop time is compiled in
+    void setSensorPeriods(const SensorPeriods& periods);
+
+    const SensorPeriods& getSensorPeriods() const { return sensorPeriods; }
+
+    // A period shorter than the step sub-steps the physics
+    void setPhysicsPeriod(float period);
+
+    float getPhysicsPeriod() const { return physicsPeriod; }
+
+    const MultiRateScheduler& getScheduler() const { return scheduler; }
+
+    // Safe from any thread, the command waits for the start of the next step. Fails when the queue is full
+    bool sendCommand(const Command& command) { return commandQueue.push(command); }
+
+    // Called by updateSimulation, and by the owner of the engine while paused so commands still go through
+    void applyCommands();
+
+    bool                    isPaused{false};
+    bool                    wasReset{false};
+    std::shared_ptr<Engine> physicsEngine;
+    int                     stepCounter = 0;
 
 private:
-    std::vector<std::string> mazePaths{};
-    std::string              currentMazePath;
+    std::vector<std::string>            mazePaths{};
+    std::string                         currentMazePath;
+    std::vector<std::unique_ptr<Robot>> robots;
+
+    // Filled by sendCommand, drained by applyCommands on the simulation thread
+    MpscQueue<Command, 256> commandQueue;
+
+    // Rebuilt whenever the robots change, tasks hold pointers to them
+    MultiRateScheduler scheduler;
+    SensorPeriods      sensorPeriods;
+    float              physicsPeriod = STEP;
+
+    void rebuildSchedule();
 
     // Elapsed time tracking
     int   runStartStep = -1;
     float elapsedRunTime = 0.0f;
 };
 
+using SimulationEngine = TSimulationEngine<physics::Box2DPhysicsEngine>;
+
 }  // namespace micrasverse::simulation
 
+#include "../simulation_engine.cpp"
+
 #endif  // SIMULATION_ENGINE_HPP
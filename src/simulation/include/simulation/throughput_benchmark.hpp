@@ -0,0 +1,68 @@
+#ifndef THROUGHPUT_BENCHMARK_HPP
+#define THROUGHPUT_BENCHMARK_HPP
+
+#include "simulation/simulation_engine.hpp"
+
+#include <cstdint>
+#include <istream>
+#include <ostream>
+#include <string>
+#include <vector>
+
+namespace micrasverse::simulation {
+
+// Outcome of running the firmware through exploration, the return to the start and the solve on one maze
+struct MazeThroughput {
+    std::string maze;                        // file name, without the directory
+    uint64_t    steps = 0;                   // simulated steps
+    double      wallTime = 0.0;              // seconds
+    bool        explored = false;            // the firmware finished exploring and went back to the start
+    bool        solved = false;              // the solve run reached the goal
+    uint64_t    box2dPeakBytes = 0;          // most memory the world had in use at once
+    uint64_t    box2dPeakReservedBytes = 0;  // most memory its arena took from the heap
+
+    double getStepsPerSecond() const { return wallTime > 0.0 ? steps / wallTime : 0.0; }
+};
+
+struct ThroughputReport {
+    std::vector<MazeThroughput> mazes;
+
+    uint64_t getTotalSteps() const;
+    double   getTotalWallTime() const;
+
+    // Aggregate over every maze, so long mazes weigh more than short ones
+    double getStepsPerSecond() const;
+};
+
+// Mazes and the aggregate whose throughput dropped by more than the tolerance
+struct ThroughputComparison {
+    bool                     passed = true;
+    double                   aggregateRatio = 1.0;  // current over baseline steps per second
+    std::vector<std::string> regressions;           // one readable line per regression
+    std::vector<std::string> missingMazes;          // in the baseline but not in the current report
+};
+
+// End to end throughput of the simulation, measured with the same firmware and physics loop as the GUI
+class ThroughputBenchmark {
+public:
+    explicit ThroughputBenchmark(float timeout = 600.0f);
+
+    // Rebuilds the physics engine and the firmware on the maze, so no run starts with a map of the previous one.
+    // The world is stepped on the calling thread, so the numbers don't depend on the core count.
+    MazeThroughput runMaze(SimulationEngine& simulationEngine, const std::string& mazePath) const;
+
+    static void writeJson(std::ostream& output, const ThroughputReport& report);
+
+    // Reads a report written by writeJson, returns false when it has no mazes
+    static bool readJson(std::istream& input, ThroughputReport& report);
+
+    // A tolerance of 0.1 accepts up to 10% fewer steps per second than the baseline
+    static ThroughputComparison compare(const ThroughputReport& report, const ThroughputReport& baseline, float tolerance);
+
+private:
+    float timeout;  // simulated seconds per maze
+};
+
+}  // namespace micrasverse::simulation
+
+#endif  // THROUGHPUT_BENCHMARK_HPP
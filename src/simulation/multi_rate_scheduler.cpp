@@ -0,0 +1,82 @@
+#include "simulation/multi_rate_scheduler.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <utility>
+
+namespace micrasverse::simulation {
+
+size_t MultiRateScheduler::addTask(std::string name, float period, float phase, Callback callback) {
+    Task task;
+    task.name = std::move(name);
+    task.period = std::max<uint64_t>(1, toMicroseconds(period));
+    task.phase = toMicroseconds(phase);
+    task.nextRun = std::max(task.phase, this->now);
+    task.lastRun = task.nextRun;
+    task.callback = std::move(callback);
+
+    this->tasks.push_back(std::move(task));
+    return this->tasks.size() - 1;
+}
+
+void MultiRateScheduler::setPeriod(size_t task, float period) {
+    Task& current = this->tasks.at(task);
+    current.period = std::max<uint64_t>(1, toMicroseconds(period));
+
+    if (this->now <= current.phase) {
+        current.nextRun = current.phase;
+    } else {
+        const uint64_t periods = (this->now - current.phase + current.period - 1) / current.period;
+        current.nextRun = current.phase + periods * current.period;
+    }
+}
+
+void MultiRateScheduler::step(float step) {
+    const uint64_t end = this->now + toMicroseconds(step);
+
+    while (true) {
+        uint64_t next = end;
+        for (const auto& task : this->tasks) {
+            next = std::min(next, task.nextRun);
+        }
+
+        if (next >= end) {
+            break;
+        }
+
+        this->now = next;
+        for (auto& task : this->tasks) {
+            if (task.nextRun != next) {
+                continue;
+            }
+
+            // The first run reports a full period, as if the task had run one period before its phase
+            const uint64_t elapsed = task.runs == 0 ? task.period : next - task.lastRun;
+            task.lastRun = next;
+            task.nextRun += task.period;
+            task.runs++;
+            task.callback(elapsed * 1e-6f);
+        }
+    }
+
+    this->now = end;
+}
+
+void MultiRateScheduler::reset() {
+    this->now = 0;
+    for (auto& task : this->tasks) {
+        task.nextRun = task.phase;
+        task.lastRun = task.phase;
+        task.runs = 0;
+    }
+}
+
+void MultiRateScheduler::clear() {
+    this->tasks.clear();
+}
+
+uint64_t MultiRateScheduler::toMicroseconds(float seconds) {
+    return static_cast<uint64_t>(std::llround(std::max(seconds, 0.0f) * 1e6f));
+}
+
+}  // namespace micrasverse::simulation
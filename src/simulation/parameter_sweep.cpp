@@ -0,0 +1,239 @@
+#include "simulation/parameter_sweep.hpp"
+#include "simulation/robot.hpp"
+#include "simulation/multi_rate_scheduler.hpp"
+#include "simulation/maze_regions.hpp"
+#include "physics/box2d_physics_engine.hpp"
+#include "physics/task_scheduler.hpp"
+#include "physics/world_pool.hpp"
+#include "constants.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <numeric>
+#include <random>
+#include <utility>
+
+namespace micrasverse::simulation {
+
+namespace {
+
+// Largest heading deviation from the maze axes at which the lateral error is measured, so turns are left out
+constexpr float ALIGNED_HEADING_TOLERANCE = 5.0f * B2_PI / 180.0f;
+
+// Distance from the center of the cell row or column the robot is driving along
+float getLateralError(const physics::RobotBody& body) {
+    if (std::abs(std::remainder(body.angle, B2_PI / 2.0f)) > ALIGNED_HEADING_TOLERANCE) {
+        return 0.0f;
+    }
+
+    // Facing +-y the lateral axis is x, facing +-x it is y
+    const bool  alongY = std::abs(std::remainder(body.angle, B2_PI)) < B2_PI / 4.0f;
+    const float offset = (alongY ? body.position.x : body.position.y) - WALL_THICKNESS / 2.0f;
+    return std::abs(offset - (std::floor(offset / CELL_SIZE) + 0.5f) * CELL_SIZE);
+}
+
+}  // namespace
+
+const char* getRunOutcomeName(RunOutcome outcome) {
+    switch (outcome) {
+        case RunOutcome::REACHED_GOAL:
+            return "reached_goal";
+        case RunOutcome::CRASHED:
+            return "crashed";
+        case RunOutcome::STALLED:
+            return "stalled";
+        case RunOutcome::TIMED_OUT:
+            return "timed_out";
+        default:
+            return "unknown";
+    }
+}
+
+ParameterSweep::ParameterSweep(SweepSettings settings) : settings(std::move(settings)) {
+    this->generateSamples();
+
+    // Built up front, the robots only read them while the runs are in flight
+    for (const auto& sample : this->samples) {
+        ControllerConfigs& configs = this->sampleConfigs.emplace_back();
+        for (size_t i = 0; i < sample.size(); i++) {
+            this->settings.ranges[i].parameter->access(configs) = sample[i];
+        }
+    }
+}
+
+void ParameterSweep::generateSamples() {
+    const size_t                          parameterCount = this->settings.ranges.size();
+    std::mt19937                          generator(this->settings.seed);
+    std::uniform_real_distribution<float> unit(0.0f, 1.0f);
+
+    const auto interpolate = [this](size_t parameter, float t) {
+        const ParameterRange& range = this->settings.ranges[parameter];
+        return range.min + (range.max - range.min) * t;
+    };
+
+    // Without ranges a single run with the compiled-in configs is a baseline
+    if (parameterCount == 0) {
+        this->samples.emplace_back();
+        return;
+    }
+
+    switch (this->settings.design) {
+        case SweepDesign::GRID: {
+            const size_t steps = std::max<size_t>(this->settings.gridSteps, 1);
+            size_t       sampleCount = 1;
+            for (size_t i = 0; i < parameterCount; i++) {
+                sampleCount *= steps;
+            }
+
+            for (size_t sample = 0; sample < sampleCount; sample++) {
+                std::vector<float> values(parameterCount);
+                size_t             remaining = sample;
+                for (size_t i = 0; i < parameterCount; i++) {
+                    const size_t step = remaining % steps;
+                    remaining /= steps;
+                    values[i] = interpolate(i, (steps > 1) ? static_cast<float>(step) / (steps - 1) : 0.0f);
+                }
+                this->samples.push_back(std::move(values));
+            }
+            break;
+        }
+
+        case SweepDesign::RANDOM:
+            for (size_t sample = 0; sample < this->settings.sampleCount; sample++) {
+                std::vector<float> values(parameterCount);
+                for (size_t i = 0; i < parameterCount; i++) {
+                    values[i] = interpolate(i, unit(generator));
+                }
+                this->samples.push_back(std::move(values));
+            }
+            break;
+
+        case SweepDesign::LATIN_HYPERCUBE: {
+            const size_t sampleCount = this->settings.sampleCount;
+            this->samples.assign(sampleCount, std::vector<float>(parameterCount));
+
+            std::vector<size_t> strata(sampleCount);
+            for (size_t i = 0; i < parameterCount; i++) {
+                std::iota(strata.begin(), strata.end(), 0);
+                std::shuffle(strata.begin(), strata.end(), generator);
+                for (size_t sample = 0; sample < sampleCount; sample++) {
+                    this->samples[sample][i] = interpolate(i, (strata[sample] + unit(generator)) / sampleCount);
+                }
+            }
+            break;
+        }
+    }
+}
+
+std::vector<RunResult> ParameterSweep::run() const {
+    const size_t           mazeCount = this->settings.mazePaths.size();
+    const size_t           runCount = this->samples.size() * mazeCount;
+    std::vector<RunResult> results(runCount);
+
+    // Each worker pulls the next run when it finishes one, runs take very different times to finish
+    physics::TaskScheduler scheduler(this->settings.workerCount);
+    std::atomic<size_t>    nextRun{0};
+
+    // Every sample runs on every maze, reusing worlds builds the walls of each maze once per worker instead of once per
+    // run. Without it the pool keeps no idle engine and every run starts on a new world, so results are reproducible.
+    physics::WorldPool worldPool(1, physics::RobotCollisionMode::GHOST, this->settings.reuseWorlds ? MAX_WORLDS / 2 : 0);
+
+    scheduler.parallelFor(scheduler.getWorkerCount(), [&](int /*worker*/) {
+        for (size_t run = nextRun++; run < runCount; run = nextRun++) {
+            const size_t sample = run / mazeCount;
+            const size_t maze = run % mazeCount;
+
+            auto engine = worldPool.acquire(this->settings.mazePaths[maze]);
+            results[run] = runHeadless(this->sampleConfigs[sample], *engine, this->settings.limits);
+            results[run].sampleIndex = sample;
+            results[run].mazeIndex = maze;
+        }
+    });
+
+    return results;
+}
+
+RunResult ParameterSweep::runHeadless(const ControllerConfigs& configs, std::string_view mazePath, const RunLimits& limits) {
+    // Runs already fill every thread, so each world is stepped serially on the thread running it
+    physics::Box2DPhysicsEngine engine(mazePath, 1, physics::RobotCollisionMode::GHOST, nullptr);
+    return runHeadless(configs, engine, limits);
+}
+
+RunResult ParameterSweep::runHeadless(const ControllerConfigs& configs, physics::Box2DPhysicsEngine& engine, const RunLimits& limits) {
+    // A new firmware for every run, so nothing the previous run explored carries over
+    physics::RobotBody& body = engine.getRobotBody();
+    Robot               robot(body, 0, &configs);
+    const auto          proxyBridge = robot.getProxyBridge();
+
+    proxyBridge->send_event(micras::Interface::Event::EXPLORE);
+
+    RunResult      result;
+    types::Vec2    lastPosition = body.position;
+    const uint32_t startCollisions = body.wallCollisions;
+    const int      maxSteps = static_cast<int>(limits.timeout / STEP);
+    const int      stallSteps = static_cast<int>(limits.stallTime / STEP);
+    auto           lastCell = proxyBridge->get_current_pose().to_grid(micras::cell_size).position;
+    int            lastCellStep = 0;
+    int            step = 0;
+
+    // Same sampling rates as the GUI, so a configuration behaves the same in both
+    MultiRateScheduler scheduler;
+    robot.addSamplingTasks(scheduler, SensorPeriods{});
+    scheduler.addTask("firmware", STEP, 0.0f, [&robot](float) { robot.update(); });
+    scheduler.addTask("physics", STEP, 0.0f, [&engine](float elapsed) { engine.update(elapsed); });
+
+    while (step < maxSteps) {
+        scheduler.step(STEP);
+        step++;
+
+        result.pathLength += (body.position - lastPosition).length();
+        lastPosition = body.position;
+        result.crashes = body.wallCollisions - startCollisions;
+        result.maxLateralError = std::max(result.maxLateralError, getLateralError(body));
+
+        if (isInGoal(body.position)) {
+            result.outcome = RunOutcome::REACHED_GOAL;
+            break;
+        }
+
+        // Failing configurations usually show in the first seconds, there's no point in simulating the rest
+        if (limits.stopOnCrash && result.crashes > 0) {
+            result.outcome = RunOutcome::CRASHED;
+            break;
+        }
+
+        // Progress is measured on the firmware's own pose, a robot spinning or pushing against a wall stays in its cell
+        const auto cell = proxyBridge->get_current_pose().to_grid(micras::cell_size).position;
+        if (cell != lastCell) {
+            lastCell = cell;
+            lastCellStep = step;
+        } else if (stallSteps > 0 && step - lastCellStep >= stallSteps) {
+            result.outcome = RunOutcome::STALLED;
+            break;
+        }
+    }
+
+    result.reachedGoal = result.outcome == RunOutcome::REACHED_GOAL;
+    result.runTime = step * STEP;
+    return result;
+}
+
+void ParameterSweep::writeResults(std::ostream& output, const std::vector<RunResult>& results) const {
+    output << "sample,maze";
+    for (const auto& range : this->settings.ranges) {
+        output << ',' << range.parameter->name;
+    }
+    output << ",outcome,reached_goal,run_time,crashes,path_length,max_lateral_error\n";
+
+    for (const auto& result : results) {
+        output << result.sampleIndex << ',' << this->settings.mazePaths[result.mazeIndex];
+        for (const float value : this->samples[result.sampleIndex]) {
+            output << ',' << value;
+        }
+        output << ',' << getRunOutcomeName(result.outcome) << ',' << result.reachedGoal << ',' << result.runTime << ',' << result.crashes << ','
+               << result.pathLength << ',' << result.maxLateralError << '\n';
+    }
+}
+
+}  // namespace micrasverse::simulation
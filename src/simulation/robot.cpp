@@ -0,0 +1,144 @@
+#include "simulation/robot.hpp"
+#include "simulation/command.hpp"
+#include "target.hpp"
+#include "micrasverse_core/profiler.hpp"
+
+#include <array>
+#include <mutex>
+#include <string>
+#include <type_traits>
+
+namespace micrasverse::simulation {
+
+namespace {
+
+// The firmware builds its proxies and controllers from the global configs in target.cpp and constants.hpp, so they
+// are pointed at the right body and overridden right before each controller is constructed, then restored
+std::mutex controllerCreationMutex;
+
+}  // namespace
+
+Robot::Robot(physics::RobotBody& micrasBody, size_t index, const ControllerConfigs* configs) : micrasBody(micrasBody), index(index) {
+    std::lock_guard<std::mutex> lock(controllerCreationMutex);
+
+    micras::initializeProxyConfigs(&micrasBody);
+
+    const ControllerConfigs     defaultConfigs;
+    const std::filesystem::path storagePath = micras::maze_storage_config.storage_path;
+
+    if (configs != nullptr) {
+        micras::action_queuer_config = configs->actionQueuer;
+        micras::maze_config.action_queuer_config = configs->actionQueuer;
+        micras::follow_wall_config = configs->followWall;
+        micras::speed_controller_config = configs->speedController;
+        micras::maze_storage_config.storage_path = configs->storagePath;
+    } else if (index > 0) {
+        // Extra robots keep their own storage so they don't overwrite the main robot's saved maze
+        micras::maze_storage_config.storage_path = storagePath / ("robot_" + std::to_string(index));
+    }
+
+    this->controller = std::make_unique<micras::Micras>();
+    this->proxyBridge = std::make_shared<micras::ProxyBridge>(*this->controller, micrasBody);
+
+    micras::action_queuer_config = defaultConfigs.actionQueuer;
+    micras::maze_config.action_queuer_config = defaultConfigs.actionQueuer;
+    micras::follow_wall_config = defaultConfigs.followWall;
+    micras::speed_controller_config = defaultConfigs.speedController;
+    micras::maze_storage_config.storage_path = storagePath;
+}
+
+void Robot::sampleSensors(micras::ProxyBridge::SensorGroup group, float elapsed) {
+    MICRASVERSE_PROFILE_ZONE("Robot::sampleSensors");
+    this->proxyBridge->sample_sensors(group, elapsed);
+}
+
+void Robot::addSamplingTasks(MultiRateScheduler& scheduler, const SensorPeriods& periods) {
+    using SensorGroup = micras::ProxyBridge::SensorGroup;
+
+    struct GroupTask {
+        SensorGroup group;
+        float       period;
+        const char* name;
+    };
+
+    const std::array<GroupTask, 5> tasks{{
+        {SensorGroup::WALL_SENSORS, periods.wallSensors, "wallSensors"},
+        {SensorGroup::ENCODERS, periods.encoders, "encoders"},
+        {SensorGroup::IMU, periods.imu, "imu"},
+        {SensorGroup::TORQUE, periods.torque, "torque"},
+        {SensorGroup::BATTERY, periods.battery, "battery"},
+    }};
+
+    for (const auto& task : tasks) {
+        const SensorGroup group = task.group;
+        scheduler.addTask("robot" + std::to_string(this->index) + "/" + task.name, task.period, 0.0f, [this, group](float elapsed) {
+            this->sampleSensors(group, elapsed);
+        });
+    }
+}
+
+void Robot::update() {
+    MICRASVERSE_PROFILE_ZONE("Micras::update");
+    this->controller->update();
+}
+
+void Robot::applyCommand(const Command& command) {
+    std::visit(
+        [this](const auto& action) {
+            using Action = std::decay_t<decltype(action)>;
+
+            if constexpr (std::is_same_v<Action, commands::SendEvent>) {
+                this->proxyBridge->send_event(action.event);
+            } else if constexpr (std::is_same_v<Action, commands::AcknowledgeEvent>) {
+                this->proxyBridge->acknowledge_event(action.event);
+            } else if constexpr (std::is_same_v<Action, commands::SetButtonStatus>) {
+                this->proxyBridge->set_button_status(action.status);
+            } else if constexpr (std::is_same_v<Action, commands::SetCommand>) {
+                this->proxyBridge->set_command(action.linear, action.angular);
+            } else if constexpr (std::is_same_v<Action, commands::SetWheelCommand>) {
+                this->proxyBridge->set_wheel_command(action.left, action.right);
+            } else if constexpr (std::is_same_v<Action, commands::StopMotors>) {
+                this->proxyBridge->stop_motors();
+            } else if constexpr (std::is_same_v<Action, commands::SetMotorsEnabled>) {
+                if (action.enabled) {
+                    this->proxyBridge->enable_motors();
+                } else {
+                    this->proxyBridge->disable_motors();
+                }
+            } else if constexpr (std::is_same_v<Action, commands::SetDipSwitch>) {
+                this->proxyBridge->set_dip_switch_state(action.index, action.state);
+            } else if constexpr (std::is_same_v<Action, commands::SetArgbColor>) {
+                this->proxyBridge->set_argb_color(action.color);
+            } else if constexpr (std::is_same_v<Action, commands::TurnOffArgb>) {
+                this->proxyBridge->turn_off_argb();
+            } else if constexpr (std::is_same_v<Action, commands::SetLedColor>) {
+                this->proxyBridge->set_led_color(action.index, action.red, action.green, action.blue);
+            } else if constexpr (std::is_same_v<Action, commands::PlayBuzzer>) {
+                this->proxyBridge->set_buzzer_frequency(action.frequency);
+                this->proxyBridge->set_buzzer_duration(action.duration);
+            } else if constexpr (std::is_same_v<Action, commands::StopBuzzer>) {
+                this->proxyBridge->stop_buzzer();
+            } else if constexpr (std::is_same_v<Action, commands::ResetFirmware>) {
+                this->proxyBridge->reset_micras();
+            } else if constexpr (std::is_same_v<Action, commands::Calibrate>) {
+                switch (action.target) {
+                    case commands::Calibrate::Target::FRONT_WALL:
+                        this->proxyBridge->calibrate_front_wall();
+                        break;
+                    case commands::Calibrate::Target::LEFT_WALL:
+                        this->proxyBridge->calibrate_left_wall();
+                        break;
+                    case commands::Calibrate::Target::RIGHT_WALL:
+                        this->proxyBridge->calibrate_right_wall();
+                        break;
+                    case commands::Calibrate::Target::IMU:
+                        this->proxyBridge->calibrate_imu();
+                        break;
+                }
+            }
+        },
+        command.action
+    );
+}
+
+}  // namespace micrasverse::simulation
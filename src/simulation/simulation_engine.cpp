@@ -2,20 +2,26 @@
 #define SIMULATION_ENGINE_CPP
 
 #include "simulation/simulation_engine.hpp"
-#include "physics/box2d_physics_engine.hpp"
 #include "io/keyboard.hpp"
 #include "constants.hpp"
+#include "micrasverse_core/profiler.hpp"
+#include "micrasverse_core/allocation_audit.hpp"
+#include <algorithm>
 #include <filesystem>
+#include <utility>
 
 namespace micrasverse::simulation {
 
-SimulationEngine::SimulationEngine() {
-    this->setPhysicsEngine(std::make_shared<micrasverse::physics::Box2DPhysicsEngine>(DEFAULT_MAZE_PATH));
+template <physics::PhysicsBackend Engine>
+template <typename... EngineArgs>
+TSimulationEngine<Engine>::TSimulationEngine(size_t robotCount, EngineArgs&&... engineArgs) {
+    this->setPhysicsEngine(std::make_shared<Engine>(DEFAULT_MAZE_PATH, robotCount, std::forward<EngineArgs>(engineArgs)...));
     this->updateMazePaths("external/mazefiles/classic");
     this->currentMazePath = DEFAULT_MAZE_PATH;
 }
 
-void SimulationEngine::updateMazePaths(const std::string& folderPath) {
+template <physics::PhysicsBackend Engine>
+void TSimulationEngine<Engine>::updateMazePaths(const std::string& folderPath) {
     mazePaths.clear();
 
     for (const auto& entry : std::filesystem::directory_iterator(folderPath)) {
@@ -27,39 +33,49 @@ void SimulationEngine::updateMazePaths(const std::string& folderPath) {
     std::sort(mazePaths.begin(), mazePaths.end());
 }
 
-const std::vector<std::string>& SimulationEngine::getMazePaths() const {
+template <physics::PhysicsBackend Engine>
+const std::vector<std::string>& TSimulationEngine<Engine>::getMazePaths() const {
     return this->mazePaths;
 }
 
-const std::string& SimulationEngine::getCurrentMazePath() const {
+template <physics::PhysicsBackend Engine>
+const std::string& TSimulationEngine<Engine>::getCurrentMazePath() const {
     return this->currentMazePath;
 }
 
-void SimulationEngine::loadMaze(const std::string& mazeFilePath) {
+template <physics::PhysicsBackend Engine>
+void TSimulationEngine<Engine>::loadMaze(const std::string& mazeFilePath) {
     this->currentMazePath = mazeFilePath;
     this->physicsEngine->loadMaze(mazeFilePath);
     this->wasReset = true;
 }
 
-void SimulationEngine::togglePause() {
+template <physics::PhysicsBackend Engine>
+void TSimulationEngine<Engine>::togglePause() {
     this->isPaused = !isPaused;
 }
 
-void SimulationEngine::updateSimulation(float step) {
-    this->physicsEngine->update(step);
+template <physics::PhysicsBackend Engine>
+void TSimulationEngine<Engine>::updateSimulation(float step) {
+    MICRASVERSE_PROFILE_ZONE("updateSimulation");
+    this->applyCommands();
+    this->scheduler.step(step);
 }
 
-void SimulationEngine::stepThroughSimulation(float step) {
+template <physics::PhysicsBackend Engine>
+void TSimulationEngine<Engine>::stepThroughSimulation(float step) {
     this->isPaused = true;
-    this->physicsEngine->update(step);
+    this->updateSimulation(step);
 }
 
-void SimulationEngine::resetSimulation() {
+template <physics::PhysicsBackend Engine>
+void TSimulationEngine<Engine>::resetSimulation() {
     this->isPaused = true;
     this->physicsEngine->resetMicrasPosition();
 }
 
-void SimulationEngine::resetSimulation(const std::string& mazeFilePath) {
+template <physics::PhysicsBackend Engine>
+void TSimulationEngine<Engine>::resetSimulation(const std::string& mazeFilePath) {
     this->physicsEngine->resetMicrasPosition();
     this->physicsEngine->loadMaze(mazeFilePath);
     this->currentMazePath = mazeFilePath;
@@ -67,11 +83,21 @@ void SimulationEngine::resetSimulation(const std::string& mazeFilePath) {
     this->wasReset = true;
 }
 
-void SimulationEngine::setPhysicsEngine(std::shared_ptr<physics::Box2DPhysicsEngine> engine) {
+template <physics::PhysicsBackend Engine>
+void TSimulationEngine<Engine>::setPhysicsEngine(std::shared_ptr<Engine> engine) {
+    // Controllers hold references to the bodies, so they are rebuilt with the new engine
+    this->robots.clear();
     this->physicsEngine = std::move(engine);
+
+    for (size_t i = 0; i < this->physicsEngine->getRobotCount(); i++) {
+        this->robots.push_back(std::make_unique<Robot>(this->physicsEngine->getRobotBody(i), i));
+    }
+
+    this->rebuildSchedule();
 }
 
-void SimulationEngine::updateRunTimer() {
+template <physics::PhysicsBackend Engine>
+void TSimulationEngine<Engine>::updateRunTimer() {
     if (this->runStartStep == -1) {
         this->runStartStep = this->stepCounter;
     }
@@ -79,9 +105,68 @@ void SimulationEngine::updateRunTimer() {
     elapsedRunTime = (stepCounter - runStartStep) * micrasverse::STEP;
 }
 
-float SimulationEngine::getElapsedRunTime() const {
+template <physics::PhysicsBackend Engine>
+float TSimulationEngine<Engine>::getElapsedRunTime() const {
     return elapsedRunTime;
 }
+
+template <physics::PhysicsBackend Engine>
+Robot& TSimulationEngine<Engine>::addRobot() {
+    const size_t index = this->physicsEngine->addMicras();
+    this->robots.push_back(std::make_unique<Robot>(this->physicsEngine->getRobotBody(index), index));
+    this->rebuildSchedule();
+    return *this->robots.back();
+}
+
+template <physics::PhysicsBackend Engine>
+void TSimulationEngine<Engine>::setSensorPeriods(const SensorPeriods& periods) {
+    this->sensorPeriods = periods;
+    this->rebuildSchedule();
+}
+
+template <physics::PhysicsBackend Engine>
+void TSimulationEngine<Engine>::setPhysicsPeriod(float period) {
+    this->physicsPeriod = period;
+    this->rebuildSchedule();
+}
+
+template <physics::PhysicsBackend Engine>
+void TSimulationEngine<Engine>::applyCommands() {
+    Command command;
+    while (this->commandQueue.pop(command)) {
+        if (const auto* periods = std::get_if<commands::SetSensorPeriods>(&command.action)) {
+            this->setSensorPeriods(periods->periods);
+        } else if (const auto* period = std::get_if<commands::SetPhysicsPeriod>(&command.action)) {
+            this->setPhysicsPeriod(period->period);
+        } else if (command.robot < this->robots.size()) {
+            this->robots[command.robot]->applyCommand(command);
+        }
+    }
+}
+
+template <physics::PhysicsBackend Engine>
+void TSimulationEngine<Engine>::rebuildSchedule() {
+    this->scheduler.clear();
+    this->scheduler.reset();
+
+    // Tasks due together run in the order they are added: every sensor sample of the step is taken before any
+    // firmware runs, so they all see the state the physics published last
+    for (auto& robot : this->robots) {
+        robot->addSamplingTasks(this->scheduler, this->sensorPeriods);
+    }
+
+    this->scheduler.addTask("firmware", STEP, 0.0f, [this](float) {
+        MICRASVERSE_ALLOCATION_PHASE(FIRMWARE);
+        for (auto& robot : this->robots) {
+            robot->update();
+        }
+    });
+
+    this->scheduler.addTask("physics", this->physicsPeriod, 0.0f, [this](float elapsed) {
+        MICRASVERSE_ALLOCATION_PHASE(PHYSICS);
+        this->physicsEngine->update(elapsed);
+    });
+}
 }  // namespace micrasverse::simulation
 
 #endif  // SIMULATION_ENGINE_CPP
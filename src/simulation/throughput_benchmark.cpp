@@ -0,0 +1,230 @@
+#include "simulation/throughput_benchmark.hpp"
+#include "simulation/maze_regions.hpp"
+#include "physics/box2d_physics_engine.hpp"
+#include "constants.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <exception>
+#include <filesystem>
+#include <iomanip>
+#include <iterator>
+#include <memory>
+#include <sstream>
+
+namespace micrasverse::simulation {
+
+namespace {
+
+// Some firmware versions keep the return objective after arriving, standing still in the start cell this long also
+// counts as the end of the return
+constexpr float RETURN_SETTLE_TIME = 0.5f;  // seconds
+constexpr float STOPPED_SPEED = 0.005f;     // meters/second
+
+enum class Phase : uint8_t {
+    EXPLORE,
+    RETURN,
+    SOLVE,
+    DONE,
+};
+
+// Value of a key in a flat JSON object, without the quotes of strings
+std::string findJsonValue(const std::string& object, const std::string& key) {
+    const size_t keyPosition = object.find('"' + key + '"');
+    if (keyPosition == std::string::npos) {
+        return {};
+    }
+
+    size_t begin = object.find(':', keyPosition);
+    if (begin == std::string::npos) {
+        return {};
+    }
+    begin = object.find_first_not_of(" \t\r\n", begin + 1);
+    if (begin == std::string::npos) {
+        return {};
+    }
+
+    if (object[begin] == '"') {
+        const size_t end = object.find('"', begin + 1);
+        return end == std::string::npos ? std::string{} : object.substr(begin + 1, end - begin - 1);
+    }
+
+    const size_t end = object.find_first_of(",}\r\n", begin);
+    return object.substr(begin, end == std::string::npos ? std::string::npos : end - begin);
+}
+
+}  // namespace
+
+uint64_t ThroughputReport::getTotalSteps() const {
+    uint64_t steps = 0;
+    for (const auto& maze : this->mazes) {
+        steps += maze.steps;
+    }
+    return steps;
+}
+
+double ThroughputReport::getTotalWallTime() const {
+    double wallTime = 0.0;
+    for (const auto& maze : this->mazes) {
+        wallTime += maze.wallTime;
+    }
+    return wallTime;
+}
+
+double ThroughputReport::getStepsPerSecond() const {
+    const double wallTime = this->getTotalWallTime();
+    return wallTime > 0.0 ? this->getTotalSteps() / wallTime : 0.0;
+}
+
+ThroughputBenchmark::ThroughputBenchmark(float timeout) : timeout(timeout) { }
+
+MazeThroughput ThroughputBenchmark::runMaze(SimulationEngine& simulationEngine, const std::string& mazePath) const {
+    simulationEngine.setPhysicsEngine(std::make_shared<physics::Box2DPhysicsEngine>(mazePath, 1, physics::RobotCollisionMode::GHOST, nullptr));
+
+    const physics::RobotBody& body = simulationEngine.physicsEngine->getRobotBody();
+    const auto                proxyBridge = simulationEngine.getRobot().getProxyBridge();
+
+    MazeThroughput result;
+    result.maze = std::filesystem::path(mazePath).filename().string();
+
+    const uint64_t maxSteps = static_cast<uint64_t>(this->timeout / STEP);
+    Phase          phase = Phase::EXPLORE;
+    float          stoppedTime = 0.0f;
+
+    proxyBridge->send_event(micras::Interface::Event::EXPLORE);
+
+    const auto startTime = std::chrono::steady_clock::now();
+
+    while (result.steps < maxSteps && phase != Phase::DONE) {
+        simulationEngine.updateSimulation(STEP);
+        result.steps++;
+
+        const auto objective = proxyBridge->get_objective();
+
+        switch (phase) {
+            case Phase::EXPLORE:
+                if (objective != micras::core::Objective::EXPLORE) {
+                    phase = Phase::RETURN;
+                }
+                break;
+            case Phase::RETURN: {
+                const bool stopped = body.linearVelocity.length() < STOPPED_SPEED;
+                stoppedTime = stopped && isInStartCell(body.position) ? stoppedTime + STEP : 0.0f;
+
+                if (objective != micras::core::Objective::RETURN || stoppedTime >= RETURN_SETTLE_TIME) {
+                    result.explored = true;
+                    phase = Phase::SOLVE;
+                    proxyBridge->send_event(micras::Interface::Event::SOLVE);
+                }
+                break;
+            }
+            case Phase::SOLVE:
+                if (isInGoal(body.position)) {
+                    result.solved = true;
+                    phase = Phase::DONE;
+                }
+                break;
+            case Phase::DONE:
+                break;
+        }
+    }
+
+    result.wallTime = std::chrono::duration<double>(std::chrono::steady_clock::now() - startTime).count();
+
+    const physics::Box2DMemoryStats memory = simulationEngine.physicsEngine->getWorld().getMemoryStats();
+    result.box2dPeakBytes = memory.peakBytesInUse;
+    result.box2dPeakReservedBytes = memory.peakReservedBytes;
+    return result;
+}
+
+void ThroughputBenchmark::writeJson(std::ostream& output, const ThroughputReport& report) {
+    output << std::fixed << std::setprecision(3);
+    output << "{\n"
+           << "  \"steps\": " << report.getTotalSteps() << ",\n"
+           << "  \"wall_time\": " << report.getTotalWallTime() << ",\n"
+           << "  \"steps_per_second\": " << report.getStepsPerSecond() << ",\n"
+           << "  \"mazes\": [";
+
+    for (size_t i = 0; i < report.mazes.size(); i++) {
+        const auto& maze = report.mazes[i];
+        output << (i == 0 ? "\n" : ",\n") << "    {\"maze\": \"" << maze.maze << "\", \"steps\": " << maze.steps
+               << ", \"wall_time\": " << maze.wallTime << ", \"steps_per_second\": " << maze.getStepsPerSecond()
+               << ", \"explored\": " << (maze.explored ? "true" : "false") << ", \"solved\": " << (maze.solved ? "true" : "false")
+               << ", \"box2d_peak_bytes\": " << maze.box2dPeakBytes << ", \"box2d_peak_reserved_bytes\": " << maze.box2dPeakReservedBytes << "}";
+    }
+
+    output << "\n  ]\n}" << std::endl;
+}
+
+bool ThroughputBenchmark::readJson(std::istream& input, ThroughputReport& report) {
+    const std::string text{std::istreambuf_iterator<char>(input), std::istreambuf_iterator<char>()};
+
+    report.mazes.clear();
+
+    // Every maze is a flat object inside the mazes array
+    size_t position = text.find("\"mazes\"");
+    while (position != std::string::npos) {
+        const size_t begin = text.find('{', position);
+        const size_t end = text.find('}', begin);
+        if (begin == std::string::npos || end == std::string::npos) {
+            break;
+        }
+
+        const std::string object = text.substr(begin, end - begin + 1);
+        MazeThroughput    maze;
+        maze.maze = findJsonValue(object, "maze");
+        maze.explored = findJsonValue(object, "explored") == "true";
+        maze.solved = findJsonValue(object, "solved") == "true";
+
+        try {
+            maze.steps = std::stoull(findJsonValue(object, "steps"));
+            maze.wallTime = std::stod(findJsonValue(object, "wall_time"));
+        } catch (const std::exception&) {
+            return false;
+        }
+
+        report.mazes.push_back(maze);
+        position = end + 1;
+    }
+
+    return !report.mazes.empty();
+}
+
+ThroughputComparison ThroughputBenchmark::compare(const ThroughputReport& report, const ThroughputReport& baseline, float tolerance) {
+    ThroughputComparison comparison;
+
+    const auto describe = [](const std::string& name, double current, double reference) {
+        std::ostringstream description;
+        description << std::fixed << std::setprecision(0) << name << ": " << current << " steps/s, baseline " << reference << " steps/s ("
+                    << std::setprecision(1) << (current / reference - 1.0) * 100.0 << "%)";
+        return description.str();
+    };
+
+    for (const auto& reference : baseline.mazes) {
+        const auto current = std::find_if(report.mazes.begin(), report.mazes.end(), [&](const MazeThroughput& maze) {
+            return maze.maze == reference.maze;
+        });
+
+        if (current == report.mazes.end()) {
+            comparison.missingMazes.push_back(reference.maze);
+            continue;
+        }
+
+        if (reference.getStepsPerSecond() > 0.0 && current->getStepsPerSecond() < reference.getStepsPerSecond() * (1.0 - tolerance)) {
+            comparison.regressions.push_back(describe(reference.maze, current->getStepsPerSecond(), reference.getStepsPerSecond()));
+        }
+    }
+
+    if (baseline.getStepsPerSecond() > 0.0) {
+        comparison.aggregateRatio = report.getStepsPerSecond() / baseline.getStepsPerSecond();
+
+        if (comparison.aggregateRatio < 1.0 - tolerance) {
+            comparison.regressions.push_back(describe("aggregate", report.getStepsPerSecond(), baseline.getStepsPerSecond()));
+        }
+    }
+
+    comparison.passed = comparison.regressions.empty();
+    return comparison;
+}
+
+}  // namespace micrasverse::simulation
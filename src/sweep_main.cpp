@@ -0,0 +1,207 @@
+#include "constants.hpp"
+#include "simulation/controller_configs.hpp"
+#include "simulation/parameter_sweep.hpp"
+
+#include <algorithm>
+#include <charconv>
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace {
+
+void printUsage() {
+    std::cerr << "Usage: micrasverse_sweep [--param NAME=MIN:MAX]... [--design grid|random|lhs] [--steps N] [--samples N] [--seed N]\n"
+              << "                         [--maze FILE_OR_DIRECTORY]... [--timeout SECONDS] [--workers N] [--output FILE] [--list-params]\n"
+              << "                         [--stall-time SECONDS] [--keep-running-on-crash] [--reuse-worlds] [--check-default-run]" << std::endl;
+}
+
+constexpr float DEFAULT_RUN_CHECK_TIMEOUT = 5.0f;  // simulated seconds
+
+// Fails when the compiled-in controller configuration is taken for a crash in the first seconds of a run, which is
+// what counting the contact with the wall behind the start cell looks like
+int checkDefaultRun(const std::string& mazePath) {
+    using micrasverse::simulation::RunOutcome;
+
+    micrasverse::simulation::RunLimits limits;
+    limits.timeout = DEFAULT_RUN_CHECK_TIMEOUT;
+
+    const auto result = micrasverse::simulation::ParameterSweep::runHeadless(micrasverse::simulation::ControllerConfigs{}, mazePath, limits);
+    std::cerr << "Default run on " << mazePath << ": " << micrasverse::simulation::getRunOutcomeName(result.outcome) << " after "
+              << result.runTime << " s with " << result.crashes << " crashes" << std::endl;
+
+    return result.outcome == RunOutcome::CRASHED ? 1 : 0;
+}
+
+// The whole argument has to be a number, std::stoi and std::stof throw on junk and ignore trailing characters
+template <typename T>
+bool parseNumber(std::string_view text, T& value) {
+    const auto [end, error] = std::from_chars(text.data(), text.data() + text.size(), value);
+    return error == std::errc{} && end == text.data() + text.size();
+}
+
+template <typename T>
+bool parseNumber(std::string_view text, T min, T& value) {
+    return parseNumber(text, value) && value >= min;
+}
+
+int rejectValue(std::string_view arg, std::string_view value) {
+    std::cerr << "Invalid value for " << arg << ": " << value << std::endl;
+    printUsage();
+    return 1;
+}
+
+// Parses NAME=MIN:MAX
+bool parseRange(std::string_view text, micrasverse::simulation::ParameterRange& range) {
+    const size_t equals = text.find('=');
+    const size_t colon = text.find(':', equals);
+    if (equals == std::string_view::npos || colon == std::string_view::npos) {
+        return false;
+    }
+
+    range.parameter = micrasverse::simulation::findTunableParameter(text.substr(0, equals));
+    return range.parameter != nullptr && parseNumber(text.substr(equals + 1, colon - equals - 1), range.min) &&
+           parseNumber(text.substr(colon + 1), range.max);
+}
+
+// A directory adds every maze file in it
+void addMazes(const std::filesystem::path& path, std::vector<std::string>& mazePaths) {
+    if (!std::filesystem::is_directory(path)) {
+        mazePaths.push_back(path.string());
+        return;
+    }
+
+    std::vector<std::string> directoryMazes;
+    for (const auto& entry : std::filesystem::directory_iterator(path)) {
+        if (entry.is_regular_file() && entry.path().extension() == ".txt") {
+            directoryMazes.push_back(entry.path().string());
+        }
+    }
+
+    std::sort(directoryMazes.begin(), directoryMazes.end());
+    mazePaths.insert(mazePaths.end(), directoryMazes.begin(), directoryMazes.end());
+}
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+    micrasverse::simulation::SweepSettings settings;
+    std::string                            outputPath;
+    bool                                   defaultRunCheck = false;
+
+    for (int i = 1; i < argc; i++) {
+        const std::string_view arg = argv[i];
+
+        if (arg == "--param" && i + 1 < argc) {
+            micrasverse::simulation::ParameterRange range{};
+            if (!parseRange(argv[++i], range)) {
+                std::cerr << "Invalid parameter range: " << argv[i] << " (see --list-params)" << std::endl;
+                return 1;
+            }
+            settings.ranges.push_back(range);
+        } else if (arg == "--design" && i + 1 < argc) {
+            const std::string_view design = argv[++i];
+            if (design == "grid") {
+                settings.design = micrasverse::simulation::SweepDesign::GRID;
+            } else if (design == "random") {
+                settings.design = micrasverse::simulation::SweepDesign::RANDOM;
+            } else if (design == "lhs") {
+                settings.design = micrasverse::simulation::SweepDesign::LATIN_HYPERCUBE;
+            } else {
+                std::cerr << "Unknown design: " << design << std::endl;
+                return 1;
+            }
+        } else if (arg == "--steps" && i + 1 < argc) {
+            if (!parseNumber(argv[++i], size_t{1}, settings.gridSteps)) {
+                return rejectValue(arg, argv[i]);
+            }
+        } else if (arg == "--samples" && i + 1 < argc) {
+            if (!parseNumber(argv[++i], size_t{1}, settings.sampleCount)) {
+                return rejectValue(arg, argv[i]);
+            }
+        } else if (arg == "--seed" && i + 1 < argc) {
+            if (!parseNumber(argv[++i], settings.seed)) {
+                return rejectValue(arg, argv[i]);
+            }
+        } else if (arg == "--maze" && i + 1 < argc) {
+            addMazes(argv[++i], settings.mazePaths);
+        } else if (arg == "--timeout" && i + 1 < argc) {
+            if (!parseNumber(argv[++i], 0.0f, settings.limits.timeout)) {
+                return rejectValue(arg, argv[i]);
+            }
+        } else if (arg == "--stall-time" && i + 1 < argc) {
+            if (!parseNumber(argv[++i], 0.0f, settings.limits.stallTime)) {
+                return rejectValue(arg, argv[i]);
+            }
+        } else if (arg == "--keep-running-on-crash") {
+            settings.limits.stopOnCrash = false;
+        } else if (arg == "--workers" && i + 1 < argc) {
+            if (!parseNumber(argv[++i], 0, settings.workerCount)) {  // 0 uses every hardware thread
+                return rejectValue(arg, argv[i]);
+            }
+        } else if (arg == "--output" && i + 1 < argc) {
+            outputPath = argv[++i];
+        } else if (arg == "--reuse-worlds") {
+            settings.reuseWorlds = true;
+        } else if (arg == "--check-default-run") {
+            defaultRunCheck = true;
+        } else if (arg == "--list-params") {
+            for (const auto& parameter : micrasverse::simulation::getTunableParameters()) {
+                std::cout << parameter.name << std::endl;
+            }
+            return 0;
+        } else {
+            std::cerr << "Unknown argument: " << arg << std::endl;
+            printUsage();
+            return 1;
+        }
+    }
+
+    if (settings.mazePaths.empty()) {
+        settings.mazePaths.emplace_back(micrasverse::DEFAULT_MAZE_PATH);
+    }
+
+    for (const auto& mazePath : settings.mazePaths) {
+        if (!std::filesystem::exists(mazePath)) {
+            std::cerr << "Maze file not found: " << mazePath << std::endl;
+            return 1;
+        }
+    }
+
+    if (defaultRunCheck) {
+        return checkDefaultRun(settings.mazePaths.front());
+    }
+
+    const micrasverse::simulation::ParameterSweep sweep(settings);
+    std::cerr << "Running " << sweep.getSamples().size() << " samples on " << settings.mazePaths.size() << " mazes" << std::endl;
+
+    const auto startTime = std::chrono::steady_clock::now();
+    const auto results = sweep.run();
+    const auto elapsed = std::chrono::duration<float>(std::chrono::steady_clock::now() - startTime).count();
+    std::cerr << "Finished " << results.size() << " runs in " << elapsed << " s:";
+
+    using micrasverse::simulation::RunOutcome;
+    for (const RunOutcome outcome : {RunOutcome::REACHED_GOAL, RunOutcome::CRASHED, RunOutcome::STALLED, RunOutcome::TIMED_OUT}) {
+        const auto count = std::count_if(results.begin(), results.end(), [outcome](const auto& result) { return result.outcome == outcome; });
+        std::cerr << ' ' << count << ' ' << micrasverse::simulation::getRunOutcomeName(outcome);
+    }
+    std::cerr << std::endl;
+
+    if (outputPath.empty()) {
+        sweep.writeResults(std::cout, results);
+        return 0;
+    }
+
+    std::ofstream output(outputPath);
+    if (!output) {
+        std::cerr << "Could not open " << outputPath << std::endl;
+        return 1;
+    }
+    sweep.writeResults(output, results);
+
+    return 0;
+}
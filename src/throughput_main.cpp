@@ -0,0 +1,154 @@
+#include "constants.hpp"
+#include "target.hpp"
+#include "simulation/simulation_engine.hpp"
+#include "simulation/throughput_benchmark.hpp"
+
+#include <charconv>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <string_view>
+
+namespace {
+
+constexpr std::string_view DEFAULT_MAZE_DIRECTORY = "external/mazefiles/classic";
+constexpr std::string_view DEFAULT_BASELINE_PATH = "benchmarks/throughput_baseline.json";
+
+void printUsage() {
+    std::cerr << "Usage: micrasverse_throughput [--maze-dir DIRECTORY] [--timeout SECONDS] [--baseline FILE] [--tolerance FRACTION]\n"
+              << "                              [--output FILE] [--update-baseline]" << std::endl;
+}
+
+// The whole argument has to be a number no smaller than min, std::stof throws on junk and ignores trailing characters
+bool parseFloat(std::string_view text, float min, float& value) {
+    const auto [end, error] = std::from_chars(text.data(), text.data() + text.size(), value);
+    return error == std::errc{} && end == text.data() + text.size() && value >= min;
+}
+
+int rejectValue(std::string_view arg, std::string_view value) {
+    std::cerr << "Invalid value for " << arg << ": " << value << std::endl;
+    printUsage();
+    return 1;
+}
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+    std::string mazeDirectory{DEFAULT_MAZE_DIRECTORY};
+    std::string baselinePath{DEFAULT_BASELINE_PATH};
+    std::string outputPath;
+    float       timeout = 600.0f;
+    float       tolerance = 0.1f;
+    bool        updateBaseline = false;
+
+    for (int i = 1; i < argc; i++) {
+        const std::string_view arg = argv[i];
+
+        if (arg == "--maze-dir" && i + 1 < argc) {
+            mazeDirectory = argv[++i];
+        } else if (arg == "--timeout" && i + 1 < argc) {
+            if (!parseFloat(argv[++i], 0.0f, timeout)) {
+                return rejectValue(arg, argv[i]);
+            }
+        } else if (arg == "--baseline" && i + 1 < argc) {
+            baselinePath = argv[++i];
+        } else if (arg == "--tolerance" && i + 1 < argc) {
+            if (!parseFloat(argv[++i], 0.0f, tolerance)) {
+                return rejectValue(arg, argv[i]);
+            }
+        } else if (arg == "--output" && i + 1 < argc) {
+            outputPath = argv[++i];
+        } else if (arg == "--update-baseline") {
+            updateBaseline = true;
+        } else {
+            std::cerr << "Unknown argument: " << arg << std::endl;
+            printUsage();
+            return 1;
+        }
+    }
+
+    if (!std::filesystem::is_directory(mazeDirectory)) {
+        std::cerr << "Maze directory not found: " << mazeDirectory << std::endl;
+        return 1;
+    }
+
+    // Throughput depends on the machine, so no baseline ships with the repository and each machine records its own
+    if (!updateBaseline && !std::filesystem::exists(baselinePath)) {
+        std::cerr << "No baseline at " << baselinePath << ", throughput check skipped. Record one on this machine with "
+                  << "micrasverse_throughput --update-baseline" << std::endl;
+        return 0;
+    }
+
+    micrasverse::simulation::ThroughputReport baseline;
+    if (!updateBaseline) {
+        std::ifstream baselineFile(baselinePath);
+        if (!baselineFile || !micrasverse::simulation::ThroughputBenchmark::readJson(baselineFile, baseline)) {
+            std::cerr << "Could not read the baseline " << baselinePath << ", record one with --update-baseline" << std::endl;
+            return 1;
+        }
+    }
+
+    // Keeps the firmware's maze storage in memory, every maze has to be explored from scratch
+    micras::maze_storage_config.storage_path.clear();
+
+    micrasverse::simulation::SimulationEngine simulationEngine(
+        1, micrasverse::physics::RobotCollisionMode::GHOST, std::shared_ptr<micrasverse::physics::TaskScheduler>{}
+    );
+    simulationEngine.updateMazePaths(mazeDirectory);
+
+    const micrasverse::simulation::ThroughputBenchmark benchmark(timeout);
+    micrasverse::simulation::ThroughputReport          report;
+
+    for (const auto& mazePath : simulationEngine.getMazePaths()) {
+        const auto& maze = report.mazes.emplace_back(benchmark.runMaze(simulationEngine, mazePath));
+        std::cerr << std::left << std::setw(48) << maze.maze << std::right << std::fixed << std::setprecision(0) << std::setw(10)
+                  << maze.getStepsPerSecond() << " steps/s " << std::setprecision(2) << std::setw(8) << maze.wallTime << " s"
+                  << std::setw(8) << maze.box2dPeakBytes / 1024 << " KiB Box2D peak"
+                  << (maze.solved ? "" : (maze.explored ? "  (solve timed out)" : "  (explore timed out)")) << std::endl;
+    }
+
+    std::cerr << "Total: " << report.getTotalSteps() << " steps in " << std::setprecision(2) << report.getTotalWallTime() << " s, "
+              << std::setprecision(0) << report.getStepsPerSecond() << " steps/s" << std::endl;
+
+    if (!outputPath.empty()) {
+        std::ofstream output(outputPath);
+        if (!output) {
+            std::cerr << "Could not open " << outputPath << std::endl;
+            return 1;
+        }
+        micrasverse::simulation::ThroughputBenchmark::writeJson(output, report);
+    }
+
+    if (updateBaseline) {
+        std::filesystem::create_directories(std::filesystem::path(baselinePath).parent_path());
+        std::ofstream baselineFile(baselinePath);
+        if (!baselineFile) {
+            std::cerr << "Could not open " << baselinePath << std::endl;
+            return 1;
+        }
+        micrasverse::simulation::ThroughputBenchmark::writeJson(baselineFile, report);
+        std::cerr << "Baseline written to " << baselinePath << std::endl;
+        return 0;
+    }
+
+    const auto comparison = micrasverse::simulation::ThroughputBenchmark::compare(report, baseline, tolerance);
+
+    for (const auto& maze : comparison.missingMazes) {
+        std::cerr << "Warning: " << maze << " is in the baseline but was not run" << std::endl;
+    }
+
+    if (!comparison.passed) {
+        std::cerr << "\nTHROUGHPUT REGRESSION, more than " << std::setprecision(0) << tolerance * 100.0f << "% below " << baselinePath << ":\n";
+        for (const auto& regression : comparison.regressions) {
+            std::cerr << "  " << regression << '\n';
+        }
+        std::cerr << std::flush;
+        return 2;
+    }
+
+    std::cerr << "Throughput " << std::setprecision(1) << (comparison.aggregateRatio - 1.0) * 100.0 << "% relative to the baseline" << std::endl;
+    return 0;
+}